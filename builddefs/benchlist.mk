@@ -0,0 +1,2 @@
+BENCH_LIST = $(sort $(patsubst %/bench.mk,%, $(shell find $(ROOT_DIR)tests/bench -type f -name bench.mk)))
+FULL_BENCHES := $(notdir $(BENCH_LIST))
@@ -53,8 +53,13 @@ endif
 
 ifneq ($(filter $(FULL_TESTS),$(TEST)),)
 include tests/test_common/build.mk
+ifeq ($(strip $(BENCH)), yes)
+include tests/test_common/bench.mk
+include $(TEST_PATH)/bench.mk
+else
 include $(TEST_PATH)/test.mk
 endif
+endif
 
 include $(BUILDDEFS_PATH)/common_features.mk
 include $(BUILDDEFS_PATH)/generic_features.mk
@@ -63,7 +68,10 @@ include $(TMK_PATH)/protocol.mk
 include $(QUANTUM_PATH)/debounce/tests/rules.mk
 include $(QUANTUM_PATH)/encoder/tests/rules.mk
 include $(QUANTUM_PATH)/os_detection/tests/rules.mk
+include $(QUANTUM_PATH)/painter/tests/rules.mk
+include $(QUANTUM_PATH)/rgb_matrix/tests/rules.mk
 include $(QUANTUM_PATH)/sequencer/tests/rules.mk
+include $(QUANTUM_PATH)/split_common/tests/rules.mk
 include $(QUANTUM_PATH)/wear_leveling/tests/rules.mk
 include $(QUANTUM_PATH)/logging/print.mk
 include $(PLATFORM_PATH)/test/rules.mk
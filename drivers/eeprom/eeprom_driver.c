@@ -19,6 +19,10 @@
 
 #include "eeprom_driver.h"
 
+#ifndef EEPROM_DRIVER_UPDATE_CHUNK_SIZE
+#    define EEPROM_DRIVER_UPDATE_CHUNK_SIZE 32
+#endif
+
 uint8_t eeprom_read_byte(const uint8_t *addr) {
     uint8_t ret = 0;
     eeprom_read_block(&ret, addr, 1);
@@ -49,11 +53,33 @@ void eeprom_write_dword(uint32_t *addr, uint32_t value) {
     eeprom_write_block(&value, addr, 4);
 }
 
-void eeprom_update_block(const void *buf, void *addr, size_t len) {
-    uint8_t read_buf[len];
-    eeprom_read_block(read_buf, addr, len);
-    if (memcmp(buf, read_buf, len) != 0) {
-        eeprom_write_block(buf, addr, len);
+/**
+ * Compares in chunks, writing only the changed span of each chunk. Drivers with a better notion of what is expensive to
+ * write, such as page-based external EEPROMs, override this with their own implementation.
+ */
+__attribute__((weak)) void eeprom_update_block(const void *buf, void *addr, size_t len) {
+    const uint8_t *source = buf;
+    uint8_t       *target = addr;
+    uint8_t        read_buf[EEPROM_DRIVER_UPDATE_CHUNK_SIZE];
+    while (len > 0) {
+        size_t chunk = len < EEPROM_DRIVER_UPDATE_CHUNK_SIZE ? len : EEPROM_DRIVER_UPDATE_CHUNK_SIZE;
+        eeprom_read_block(read_buf, target, chunk);
+
+        size_t first = 0;
+        while (first < chunk && source[first] == read_buf[first]) {
+            first++;
+        }
+        if (first < chunk) {
+            size_t last = chunk;
+            while (source[last - 1] == read_buf[last - 1]) {
+                last--;
+            }
+            eeprom_write_block(&source[first], &target[first], last - first);
+        }
+
+        source += chunk;
+        target += chunk;
+        len -= chunk;
     }
 }
 
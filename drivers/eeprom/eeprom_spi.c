@@ -215,3 +215,26 @@ void eeprom_write_block(const void *buf, void *addr, size_t len) {
     spi_write(CMD_WRDI);
     spi_stop();
 }
+
+void eeprom_update_block(const void *buf, void *addr, size_t len) {
+    const uint8_t *source      = buf;
+    uintptr_t      target_addr = (uintptr_t)addr;
+    uint8_t        read_buf[EXTERNAL_EEPROM_PAGE_SIZE];
+
+    // Compare a page at a time, as each written page costs a full write cycle regardless of how much of it changed
+    while (len > 0) {
+        size_t write_length = EXTERNAL_EEPROM_PAGE_SIZE - (target_addr % EXTERNAL_EEPROM_PAGE_SIZE);
+        if (write_length > len) {
+            write_length = len;
+        }
+
+        eeprom_read_block(read_buf, (const void *)target_addr, write_length);
+        if (memcmp(source, read_buf, write_length) != 0) {
+            eeprom_write_block(source, (void *)target_addr, write_length);
+        }
+
+        source += write_length;
+        target_addr += write_length;
+        len -= write_length;
+    }
+}
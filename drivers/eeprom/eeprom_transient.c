@@ -54,3 +54,8 @@ void eeprom_write_block(const void *buf, void *addr, size_t len) {
         memcpy(&transientBuffer[offset], buf, len);
     }
 }
+
+void eeprom_update_block(const void *buf, void *addr, size_t len) {
+    // Writes are free, no point comparing first
+    eeprom_write_block(buf, addr, len);
+}
@@ -21,3 +21,32 @@ void eeprom_read_block(void *buf, const void *addr, size_t len) {
 void eeprom_write_block(const void *buf, void *addr, size_t len) {
     wear_leveling_write((uint32_t)addr, buf, len);
 }
+
+void eeprom_update_block(const void *buf, void *addr, size_t len) {
+    const uint8_t *source = buf;
+    uint32_t       offset = (uint32_t)addr;
+    uint8_t        cached[32];
+
+    // Only log the runs which actually changed, rather than the whole block
+    while (len > 0) {
+        size_t chunk = len < sizeof(cached) ? len : sizeof(cached);
+        wear_leveling_read(offset, cached, chunk);
+
+        size_t i = 0;
+        while (i < chunk) {
+            if (source[i] == cached[i]) {
+                i++;
+                continue;
+            }
+            size_t start = i;
+            while (i < chunk && source[i] != cached[i]) {
+                i++;
+            }
+            wear_leveling_write(offset + start, &source[start], i - start);
+        }
+
+        source += chunk;
+        offset += chunk;
+        len -= chunk;
+    }
+}
@@ -47,12 +47,14 @@
 
 typedef struct aw20216s_driver_t {
     uint8_t pwm_buffer[AW20216S_PWM_REGISTER_COUNT];
-    bool    pwm_buffer_dirty;
+    uint8_t pwm_dirty_start; // first changed register
+    uint8_t pwm_dirty_end;   // one past the last changed register, nothing changed if not past the start
 } PACKED aw20216s_driver_t;
 
 aw20216s_driver_t driver_buffers[AW20216S_DRIVER_COUNT] = {{
-    .pwm_buffer       = {0},
-    .pwm_buffer_dirty = false,
+    .pwm_buffer      = {0},
+    .pwm_dirty_start = 0,
+    .pwm_dirty_end   = 0,
 }};
 
 bool aw20216s_write(pin_t cs_pin, uint8_t page, uint8_t reg, uint8_t* data, uint8_t len) {
@@ -136,6 +138,18 @@ void aw20216s_init(pin_t cs_pin) {
     aw20216s_auto_lowpower(cs_pin);
 }
 
+static void aw20216s_mark_dirty(uint8_t index, uint8_t first, uint8_t last) {
+    aw20216s_driver_t *driver = &driver_buffers[index];
+
+    if (driver->pwm_dirty_end <= driver->pwm_dirty_start) {
+        driver->pwm_dirty_start = first;
+        driver->pwm_dirty_end   = last + 1;
+    } else {
+        driver->pwm_dirty_start = MIN(driver->pwm_dirty_start, first);
+        driver->pwm_dirty_end   = MAX(driver->pwm_dirty_end, last + 1);
+    }
+}
+
 void aw20216s_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     aw20216s_led_t led;
     memcpy_P(&led, (&g_aw20216s_leds[index]), sizeof(led));
@@ -147,7 +161,8 @@ void aw20216s_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     driver_buffers[led.driver].pwm_buffer[led.r] = red;
     driver_buffers[led.driver].pwm_buffer[led.g] = green;
     driver_buffers[led.driver].pwm_buffer[led.b] = blue;
-    driver_buffers[led.driver].pwm_buffer_dirty  = true;
+
+    aw20216s_mark_dirty(led.driver, MIN(led.r, MIN(led.g, led.b)), MAX(led.r, MAX(led.g, led.b)));
 }
 
 void aw20216s_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
@@ -157,9 +172,13 @@ void aw20216s_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
 }
 
 void aw20216s_update_pwm_buffers(pin_t cs_pin, uint8_t index) {
-    if (driver_buffers[index].pwm_buffer_dirty) {
-        aw20216s_write(cs_pin, AW20216S_PAGE_PWM, 0, driver_buffers[index].pwm_buffer, AW20216S_PWM_REGISTER_COUNT);
-        driver_buffers[index].pwm_buffer_dirty = false;
+    aw20216s_driver_t *driver = &driver_buffers[index];
+
+    // Only the range of registers which changed since the last update is sent
+    if (driver->pwm_dirty_end > driver->pwm_dirty_start) {
+        aw20216s_write(cs_pin, AW20216S_PAGE_PWM, driver->pwm_dirty_start, driver->pwm_buffer + driver->pwm_dirty_start, driver->pwm_dirty_end - driver->pwm_dirty_start);
+        driver->pwm_dirty_start = 0;
+        driver->pwm_dirty_end   = 0;
     }
 }
 
@@ -0,0 +1,151 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifdef QUANTUM_PAINTER_MOCK_COMMS_ENABLE
+
+#    include <string.h>
+#    include "qp_comms.h"
+#    include "qp_comms_mock.h"
+
+static qp_comms_mock_stats_t stats;
+static uint8_t               capture[QP_COMMS_MOCK_CAPTURE_SIZE];
+
+// Transfer in flight, along with a copy of its contents to detect buffers being reused too early
+static painter_device_t in_flight_device = NULL;
+static const uint8_t   *in_flight_data   = NULL;
+static uint32_t         in_flight_count  = 0;
+static uint8_t          in_flight_copy[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+
+static void mock_capture(const void *data, uint32_t byte_count) {
+    uint32_t space = QP_COMMS_MOCK_CAPTURE_SIZE - stats.bytes_captured;
+    uint32_t count = QP_MIN(byte_count, space);
+    memcpy(&capture[stats.bytes_captured], data, count);
+    stats.bytes_captured += count;
+}
+
+void qp_comms_mock_reset(void) {
+    memset(&stats, 0, sizeof(stats));
+    memset(capture, 0, sizeof(capture));
+    in_flight_device = NULL;
+}
+
+bool qp_comms_mock_busy(void) {
+    return in_flight_device != NULL;
+}
+
+bool qp_comms_mock_complete(void) {
+    if (!in_flight_device) {
+        return false;
+    }
+
+    // The bus reads the buffer while the transfer is in flight, so it is only captured now
+    if (memcmp(in_flight_data, in_flight_copy, in_flight_count) != 0) {
+        stats.buffer_modified++;
+    }
+    mock_capture(in_flight_data, in_flight_count);
+
+    painter_device_t device = in_flight_device;
+    in_flight_device        = NULL;
+    qp_comms_async_complete(device);
+    return true;
+}
+
+static bool mock_comms_init(painter_device_t device) {
+    return true;
+}
+
+static bool mock_comms_start(painter_device_t device) {
+    if (qp_comms_mock_complete()) {
+        stats.waits_blocked++;
+    }
+    return true;
+}
+
+static void mock_comms_stop(painter_device_t device) {
+    if (in_flight_device) {
+        stats.stops_deferred++;
+    }
+}
+
+static uint32_t mock_comms_send(painter_device_t device, const void *data, uint32_t byte_count) {
+    if (in_flight_device) {
+        stats.overlap_errors++;
+    }
+    stats.sync_transfers++;
+    mock_capture(data, byte_count);
+    return byte_count;
+}
+
+static bool mock_comms_send_async(painter_device_t device, const void *data, uint32_t byte_count) {
+    if (in_flight_device || byte_count > sizeof(in_flight_copy)) {
+        stats.overlap_errors++;
+        return false;
+    }
+    stats.async_transfers++;
+    in_flight_device = device;
+    in_flight_data   = (const uint8_t *)data;
+    in_flight_count  = byte_count;
+    memcpy(in_flight_copy, data, byte_count);
+    return true;
+}
+
+static void mock_comms_wait(painter_device_t device) {
+    if (qp_comms_mock_complete()) {
+        stats.waits_blocked++;
+    }
+}
+
+static void mock_comms_send_command(painter_device_t device, uint8_t cmd) {
+    if (in_flight_device) {
+        stats.overlap_errors++;
+    }
+    stats.commands++;
+}
+
+static void mock_comms_bulk_command_sequence(painter_device_t device, const uint8_t *sequence, size_t sequence_len) {
+    for (size_t i = 0; i < sequence_len;) {
+        uint8_t num_bytes = sequence[i + 2];
+        mock_comms_send_command(device, sequence[i]);
+        if (num_bytes > 0) {
+            mock_comms_send(device, &sequence[i + 3], num_bytes);
+        }
+        i += (3 + num_bytes);
+    }
+}
+
+const painter_comms_with_command_vtable_t mock_comms_vtable = {
+    .base =
+        {
+            .comms_init       = mock_comms_init,
+            .comms_start      = mock_comms_start,
+            .comms_send       = mock_comms_send,
+            .comms_stop       = mock_comms_stop,
+            .comms_send_async = mock_comms_send_async,
+            .comms_wait       = mock_comms_wait,
+        },
+    .send_command          = mock_comms_send_command,
+    .bulk_command_sequence = mock_comms_bulk_command_sequence,
+};
+
+// Same bus without asynchronous support, to verify the blocking fallback
+const painter_comms_with_command_vtable_t mock_comms_sync_vtable = {
+    .base =
+        {
+            .comms_init  = mock_comms_init,
+            .comms_start = mock_comms_start,
+            .comms_send  = mock_comms_send,
+            .comms_stop  = mock_comms_stop,
+        },
+    .send_command          = mock_comms_send_command,
+    .bulk_command_sequence = mock_comms_bulk_command_sequence,
+};
+
+const qp_comms_mock_stats_t *qp_comms_mock_stats(void) {
+    return &stats;
+}
+
+const uint8_t *qp_comms_mock_capture(void) {
+    return capture;
+}
+
+#endif // QUANTUM_PAINTER_MOCK_COMMS_ENABLE
@@ -0,0 +1,46 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#ifdef QUANTUM_PAINTER_MOCK_COMMS_ENABLE
+
+#    include "qp_internal.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Host-side mock bus, for unit testing comms handling without hardware
+//
+// Asynchronous transfers stay in flight until qp_comms_mock_complete() is invoked, emulating a DMA completion
+// interrupt, or until qp_comms waits on them. As with SPI, stopping leaves them in flight, and the next start waits. Everything sent is appended to a capture buffer so that tests can verify
+// the byte stream reaching the display.
+
+#    ifndef QP_COMMS_MOCK_CAPTURE_SIZE
+#        define QP_COMMS_MOCK_CAPTURE_SIZE 8192
+#    endif
+
+typedef struct qp_comms_mock_stats_t {
+    uint32_t sync_transfers;
+    uint32_t async_transfers;
+    uint32_t commands;
+    uint32_t waits_blocked;   // waits which had to complete a transfer still in flight
+    uint32_t stops_deferred;  // stops issued while a transfer was still in flight
+    uint32_t overlap_errors;  // transfers or commands started while another transfer was in flight
+    uint32_t buffer_modified; // in-flight buffers modified before their transfer completed
+    uint32_t bytes_captured;
+} qp_comms_mock_stats_t;
+
+extern const painter_comms_with_command_vtable_t mock_comms_vtable;
+extern const painter_comms_with_command_vtable_t mock_comms_sync_vtable;
+
+// Resets the capture buffer and statistics
+void qp_comms_mock_reset(void);
+
+// Completes the transfer in flight, if any, returning whether there was one
+bool qp_comms_mock_complete(void);
+
+// Whether a transfer is in flight
+bool qp_comms_mock_busy(void);
+
+const qp_comms_mock_stats_t *qp_comms_mock_stats(void);
+const uint8_t               *qp_comms_mock_capture(void);
+
+#endif // QUANTUM_PAINTER_MOCK_COMMS_ENABLE
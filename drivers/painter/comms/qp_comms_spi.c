@@ -4,6 +4,7 @@
 #ifdef QUANTUM_PAINTER_SPI_ENABLE
 
 #    include "spi_master.h"
+#    include "qp_comms.h"
 #    include "qp_comms_spi.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -45,11 +46,27 @@ uint32_t qp_comms_spi_send_data(painter_device_t device, const void *data, uint3
     return byte_count - bytes_remaining;
 }
 
+#    if QUANTUM_PAINTER_ASYNC_COMMS && defined(PROTOCOL_CHIBIOS)
+
+static void qp_comms_spi_async_complete(void *cb_arg) {
+    qp_comms_async_complete((painter_device_t)cb_arg);
+}
+
+bool qp_comms_spi_send_data_async(painter_device_t device, const void *data, uint32_t byte_count) {
+    // Buffers handed over by qp_comms are at most QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE bytes, and stay untouched until
+    // qp_comms_async_complete() has been invoked
+    return spi_transmit_async(data, byte_count, qp_comms_spi_async_complete, device) == SPI_STATUS_SUCCESS;
+}
+
+void qp_comms_spi_wait(painter_device_t device) {
+    spi_wait();
+}
+
+#    endif // QUANTUM_PAINTER_ASYNC_COMMS && defined(PROTOCOL_CHIBIOS)
+
 void qp_comms_spi_stop(painter_device_t device) {
-    painter_driver_t *     driver       = (painter_driver_t *)device;
-    qp_comms_spi_config_t *comms_config = (qp_comms_spi_config_t *)driver->comms_config;
+    // Deasserts chip select, once any asynchronous transmit has finished
     spi_stop();
-    gpio_write_pin_high(comms_config->chip_select_pin);
 }
 
 const painter_comms_vtable_t spi_comms_vtable = {
@@ -57,6 +74,10 @@ const painter_comms_vtable_t spi_comms_vtable = {
     .comms_start = qp_comms_spi_start,
     .comms_send  = qp_comms_spi_send_data,
     .comms_stop  = qp_comms_spi_stop,
+#    if QUANTUM_PAINTER_ASYNC_COMMS && defined(PROTOCOL_CHIBIOS)
+    .comms_send_async = qp_comms_spi_send_data_async,
+    .comms_wait       = qp_comms_spi_wait,
+#    endif // QUANTUM_PAINTER_ASYNC_COMMS && defined(PROTOCOL_CHIBIOS)
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -97,6 +118,15 @@ uint32_t qp_comms_spi_dc_reset_send_data(painter_device_t device, const void *da
     return qp_comms_spi_send_data(device, data, byte_count);
 }
 
+#        if QUANTUM_PAINTER_ASYNC_COMMS && defined(PROTOCOL_CHIBIOS)
+bool qp_comms_spi_dc_reset_send_data_async(painter_device_t device, const void *data, uint32_t byte_count) {
+    painter_driver_t *              driver       = (painter_driver_t *)device;
+    qp_comms_spi_dc_reset_config_t *comms_config = (qp_comms_spi_dc_reset_config_t *)driver->comms_config;
+    gpio_write_pin_high(comms_config->dc_pin);
+    return qp_comms_spi_send_data_async(device, data, byte_count);
+}
+#        endif // QUANTUM_PAINTER_ASYNC_COMMS && defined(PROTOCOL_CHIBIOS)
+
 void qp_comms_spi_dc_reset_send_command(painter_device_t device, uint8_t cmd) {
     painter_driver_t *              driver       = (painter_driver_t *)device;
     qp_comms_spi_dc_reset_config_t *comms_config = (qp_comms_spi_dc_reset_config_t *)driver->comms_config;
@@ -135,6 +165,10 @@ const painter_comms_with_command_vtable_t spi_comms_with_dc_vtable = {
             .comms_start = qp_comms_spi_start,
             .comms_send  = qp_comms_spi_dc_reset_send_data,
             .comms_stop  = qp_comms_spi_stop,
+#        if QUANTUM_PAINTER_ASYNC_COMMS && defined(PROTOCOL_CHIBIOS)
+            .comms_send_async = qp_comms_spi_dc_reset_send_data_async,
+            .comms_wait       = qp_comms_spi_wait,
+#        endif // QUANTUM_PAINTER_ASYNC_COMMS && defined(PROTOCOL_CHIBIOS)
         },
     .send_command          = qp_comms_spi_dc_reset_send_command,
     .bulk_command_sequence = qp_comms_spi_dc_reset_bulk_command_sequence,
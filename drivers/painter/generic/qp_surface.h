@@ -21,6 +21,23 @@
 #    define SURFACE_NUM_DEVICES 1
 #endif
 
+#ifndef SURFACE_DIRTY_REGION_COUNT
+/**
+ * @def This controls the maximum number of separate dirty regions tracked per surface. Updates far apart from each
+ *      other are transferred as separate regions, instead of one bounding box covering both. Each region requires 8
+ *      bytes of RAM.
+ */
+#    define SURFACE_DIRTY_REGION_COUNT 4
+#endif
+
+#ifndef SURFACE_DIRTY_MERGE_DISTANCE
+/**
+ * @def This controls how close, in pixels, updates need to be to an existing dirty region to be merged into it.
+ *      Each separate region costs a viewport command when transferred, so nearby updates are better merged.
+ */
+#    define SURFACE_DIRTY_MERGE_DISTANCE 8
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Forward declarations
 
@@ -29,6 +29,57 @@ void qp_surface_increment_pixdata_location(surface_viewport_data_t *viewport) {
     }
 }
 
+static inline bool qp_surface_region_near(const surface_dirty_region_t *region, uint16_t l, uint16_t t, uint16_t r, uint16_t b, uint16_t distance) {
+    return (int32_t)l <= (int32_t)region->r + distance && (int32_t)r + distance >= (int32_t)region->l && (int32_t)t <= (int32_t)region->b + distance && (int32_t)b + distance >= (int32_t)region->t;
+}
+
+static inline void qp_surface_region_extend(surface_dirty_region_t *region, uint16_t l, uint16_t t, uint16_t r, uint16_t b) {
+    if (region->l > l) {
+        region->l = l;
+    }
+    if (region->t > t) {
+        region->t = t;
+    }
+    if (region->r < r) {
+        region->r = r;
+    }
+    if (region->b < b) {
+        region->b = b;
+    }
+}
+
+static inline uint32_t qp_surface_region_area(uint16_t l, uint16_t t, uint16_t r, uint16_t b) {
+    return (uint32_t)(r - l + 1) * (b - t + 1);
+}
+
+static void qp_surface_coalesce_dirty(surface_dirty_data_t *dirty, uint8_t index) {
+    // Merge any region the grown one now touches, until none are left
+    bool merged;
+    do {
+        merged                         = false;
+        surface_dirty_region_t *target = &dirty->regions[index];
+        for (uint8_t i = 0; i < dirty->region_count; ++i) {
+            surface_dirty_region_t *other = &dirty->regions[i];
+            if (i == index || !qp_surface_region_near(target, other->l, other->t, other->r, other->b, SURFACE_DIRTY_MERGE_DISTANCE)) {
+                continue;
+            }
+            qp_surface_region_extend(target, other->l, other->t, other->r, other->b);
+
+            // Fill the gap with the last region, which may be the one being grown
+            dirty->region_count--;
+            if (i != dirty->region_count) {
+                *other = dirty->regions[dirty->region_count];
+                if (index == dirty->region_count) {
+                    index = i;
+                }
+            }
+            merged = true;
+            break;
+        }
+    } while (merged);
+    dirty->last_region = index;
+}
+
 void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y) {
     // Maintain dirty region
     if (dirty->l > x) {
@@ -49,6 +100,46 @@ void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y
     }
 }
 
+void qp_surface_update_dirty_regions(surface_dirty_data_t *dirty, uint16_t x, uint16_t y) {
+    qp_surface_update_dirty(dirty, x, y);
+
+    // Consecutive pixels usually land in the same region
+    if (dirty->region_count > 0 && qp_surface_region_near(&dirty->regions[dirty->last_region], x, y, x, y, 0)) {
+        return;
+    }
+
+    // Grow a region the pixel is close to
+    for (uint8_t i = 0; i < dirty->region_count; ++i) {
+        if (qp_surface_region_near(&dirty->regions[i], x, y, x, y, SURFACE_DIRTY_MERGE_DISTANCE)) {
+            qp_surface_region_extend(&dirty->regions[i], x, y, x, y);
+            qp_surface_coalesce_dirty(dirty, i);
+            return;
+        }
+    }
+
+    // Start a new region if there's room
+    if (dirty->region_count < SURFACE_DIRTY_REGION_COUNT) {
+        dirty->regions[dirty->region_count] = (surface_dirty_region_t){.l = x, .t = y, .r = x, .b = y};
+        dirty->last_region                  = dirty->region_count++;
+        return;
+    }
+
+    // Otherwise grow whichever region takes in the fewest extra pixels
+    uint8_t  best       = 0;
+    uint32_t best_extra = UINT32_MAX;
+    for (uint8_t i = 0; i < dirty->region_count; ++i) {
+        surface_dirty_region_t grown = dirty->regions[i];
+        qp_surface_region_extend(&grown, x, y, x, y);
+        uint32_t extra = qp_surface_region_area(grown.l, grown.t, grown.r, grown.b) - qp_surface_region_area(dirty->regions[i].l, dirty->regions[i].t, dirty->regions[i].r, dirty->regions[i].b);
+        if (extra < best_extra) {
+            best       = i;
+            best_extra = extra;
+        }
+    }
+    qp_surface_region_extend(&dirty->regions[best], x, y, x, y);
+    qp_surface_coalesce_dirty(dirty, best);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Driver vtable
 
@@ -57,11 +148,14 @@ bool qp_surface_init(painter_device_t device, painter_rotation_t rotation) {
     surface_painter_device_t *surface = (surface_painter_device_t *)driver;
     memset(surface->buffer, 0, SURFACE_REQUIRED_BUFFER_BYTE_SIZE(driver->panel_width, driver->panel_height, driver->native_bits_per_pixel));
 
-    surface->dirty.l        = 0;
-    surface->dirty.t        = 0;
-    surface->dirty.r        = surface->base.panel_width - 1;
-    surface->dirty.b        = surface->base.panel_height - 1;
-    surface->dirty.is_dirty = true;
+    surface->dirty.l            = 0;
+    surface->dirty.t            = 0;
+    surface->dirty.r            = surface->base.panel_width - 1;
+    surface->dirty.b            = surface->base.panel_height - 1;
+    surface->dirty.is_dirty     = true;
+    surface->dirty.regions[0]   = (surface_dirty_region_t){.l = surface->dirty.l, .t = surface->dirty.t, .r = surface->dirty.r, .b = surface->dirty.b};
+    surface->dirty.region_count = 1;
+    surface->dirty.last_region  = 0;
 
     return true;
 }
@@ -83,6 +177,8 @@ bool qp_surface_flush(painter_device_t device) {
     surface->dirty.l = surface->dirty.t = UINT16_MAX;
     surface->dirty.r = surface->dirty.b = 0;
     surface->dirty.is_dirty             = false;
+    surface->dirty.region_count         = 0;
+    surface->dirty.last_region          = 0;
     return true;
 }
 
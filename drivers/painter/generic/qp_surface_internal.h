@@ -16,12 +16,26 @@ typedef struct surface_painter_driver_vtable_t {
     bool (*target_pixdata_transfer)(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, bool entire_surface);
 } surface_painter_driver_vtable_t;
 
+typedef struct surface_dirty_region_t {
+    uint16_t l;
+    uint16_t t;
+    uint16_t r;
+    uint16_t b;
+} surface_dirty_region_t;
+
 typedef struct surface_dirty_data_t {
+    // Bounding box of everything that is dirty
     bool     is_dirty;
     uint16_t l;
     uint16_t t;
     uint16_t r;
     uint16_t b;
+
+    // Separate dirty regions within the bounding box, so that far apart updates can be transferred independently.
+    // Only maintained by qp_surface_update_dirty_regions(), for surfaces which transfer regions on their own.
+    uint8_t                region_count;
+    uint8_t                last_region; // most recently updated region, checked first
+    surface_dirty_region_t regions[SURFACE_DIRTY_REGION_COUNT];
 } surface_dirty_data_t;
 
 typedef struct surface_viewport_data_t {
@@ -89,6 +103,7 @@ bool qp_surface_flush(painter_device_t device);
 bool qp_surface_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom);
 void qp_surface_increment_pixdata_location(surface_viewport_data_t *viewport);
 void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y);
+void qp_surface_update_dirty_regions(surface_dirty_data_t *dirty, uint16_t x, uint16_t y);
 
 #endif // QUANTUM_PAINTER_SURFACE_ENABLE
 
@@ -28,6 +28,13 @@ void soft_serial_target_init(void);
 
 bool soft_serial_transaction(int sstd_index);
 
+#ifdef SPLIT_TRANSPORT_ASYNC
+// starts a transaction in the background, returns false if one is already in flight
+bool soft_serial_transaction_begin(int sstd_index);
+// status of the last transaction started in the background
+transport_async_status_t soft_serial_transaction_poll(void);
+#endif
+
 #ifdef SERIAL_DEBUG
 #    include <debug.h>
 #    include <print.h>
@@ -41,6 +41,19 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+bool backing_store_erase_range(uint32_t address, uint32_t length) {
+    _Static_assert((WEAR_LEVELING_CONSOLIDATE_ERASE_SIZE) % (EXTERNAL_FLASH_BLOCK_SIZE) == 0, "Consolidation erase size must be a multiple of EXTERNAL_FLASH_BLOCK_SIZE");
+    for (uint32_t offset = address; offset < address + length; offset += (EXTERNAL_FLASH_BLOCK_SIZE)) {
+        flash_status_t status = flash_erase_block((WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_OFFSET) * (EXTERNAL_FLASH_BLOCK_SIZE) + offset);
+        if (status != FLASH_STATUS_SUCCESS) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
@@ -32,3 +32,8 @@
 #ifndef WEAR_LEVELING_LOGICAL_SIZE
 #    define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
 #endif // WEAR_LEVELING_LOGICAL_SIZE
+
+// Erase one block per incremental consolidation step
+#ifndef WEAR_LEVELING_CONSOLIDATE_ERASE_SIZE
+#    define WEAR_LEVELING_CONSOLIDATE_ERASE_SIZE (EXTERNAL_FLASH_BLOCK_SIZE)
+#endif // WEAR_LEVELING_CONSOLIDATE_ERASE_SIZE
@@ -241,6 +241,35 @@ def encode_link(link: Dict[str, Any]) -> List[int]:
     return [byte_offset & 255, byte_offset >> 8]
 
 
+def make_prefilter(autocorrections: List[Tuple[str, str]], window: int) -> List[int]:
+    """Makes a bitmap of the hashes of the last `window` characters of each typo.
+  A typo can only match when the last characters typed hash to a set bit, which
+  lets the C code skip walking the trie for most keypresses. The hash must match
+  autocorrect_prefilter_hash() in process_autocorrect.c.
+  Args:
+    autocorrections: List of (typo, correction) tuples.
+    window: Number of trailing characters to hash.
+  Returns:
+    List of ints in the range 0-255, the bitmap in little endian bit order.
+  """
+    suffixes = {typo[-window:] for typo, _ in autocorrections}
+
+    # Around 8 bits per suffix keeps false positives near 10%, within a 2KB cap.
+    bits = 64
+    while bits < 8 * len(suffixes) and bits < 16384:
+        bits *= 2
+
+    bitmap = [0] * (bits // 8)
+    for suffix in suffixes:
+        h = 0
+        for c in suffix:
+            h = (h * 31 + TYPO_CHARS[c]) & 0xffff
+        h &= bits - 1
+        bitmap[h // 8] |= 1 << (h % 8)
+
+    return bitmap
+
+
 def typo_len(e: Tuple[str, str]) -> int:
     return len(e[0])
 
@@ -271,6 +300,9 @@ def generate_autocorrect_data(cli):
     min_typo = min(autocorrections, key=typo_len)[0]
     max_typo = max(autocorrections, key=typo_len)[0]
 
+    prefilter_window = min(3, len(min_typo))
+    prefilter = make_prefilter(autocorrections, prefilter_window)
+
     # Build the autocorrect_data.h file.
     autocorrect_data_h_lines = [GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE, '#pragma once', '']
 
@@ -286,6 +318,13 @@ def generate_autocorrect_data(cli):
     autocorrect_data_h_lines.append('static const uint8_t autocorrect_data[DICTIONARY_SIZE] PROGMEM = {')
     autocorrect_data_h_lines.append(textwrap.fill('    %s' % (', '.join(map(to_hex, data))), width=100, subsequent_indent='    '))
     autocorrect_data_h_lines.append('};')
+    autocorrect_data_h_lines.append('')
+    autocorrect_data_h_lines.append(f'#define AUTOCORRECT_PREFILTER_WINDOW {prefilter_window}')
+    autocorrect_data_h_lines.append(f'#define AUTOCORRECT_PREFILTER_BITS {len(prefilter) * 8}')
+    autocorrect_data_h_lines.append('')
+    autocorrect_data_h_lines.append('static const uint8_t autocorrect_prefilter[AUTOCORRECT_PREFILTER_BITS / 8] PROGMEM = {')
+    autocorrect_data_h_lines.append(textwrap.fill('    %s' % (', '.join(map(to_hex, prefilter))), width=100, subsequent_indent='    '))
+    autocorrect_data_h_lines.append('};')
 
     # Show the results
     dump_lines(cli.args.output, autocorrect_data_h_lines, cli.args.quiet)
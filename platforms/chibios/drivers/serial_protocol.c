@@ -38,11 +38,41 @@ void soft_serial_target_init(void) {
     chThdCreateStatic(waSlaveThread, sizeof(waSlaveThread), HIGHPRIO, SlaveThread, NULL);
 }
 
+#ifdef SPLIT_TRANSPORT_ASYNC
+/* Serializes access to the serial line between the master thread below and
+ * transactions that are executed in place. */
+static MUTEX_DECL(initiator_mutex);
+static BSEMAPHORE_DECL(async_start, true);
+static volatile uint8_t                  async_transaction_id;
+static volatile transport_async_status_t async_status = TRANSPORT_ASYNC_IDLE;
+
+/**
+ * @brief This thread runs on the master and executes transactions started by
+ * soft_serial_transaction_begin(), so that the main loop can carry on scanning
+ * in the meantime.
+ */
+static THD_WORKING_AREA(waMasterThread, 512);
+static THD_FUNCTION(MasterThread, arg) {
+    (void)arg;
+    chRegSetThreadName("split_protocol_async");
+
+    while (true) {
+        chBSemWait(&async_start);
+        async_status = soft_serial_transaction(async_transaction_id) ? TRANSPORT_ASYNC_SUCCESS : TRANSPORT_ASYNC_FAILED;
+    }
+}
+#endif // SPLIT_TRANSPORT_ASYNC
+
 /**
  * @brief Master specific initializations.
  */
 void soft_serial_initiator_init(void) {
     serial_transport_driver_master_init();
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+    /* Start async transaction thread, above the main loop so that it picks up the reply as soon as it arrives. */
+    chThdCreateStatic(waMasterThread, sizeof(waMasterThread), NORMALPRIO + 1, MasterThread, NULL);
+#endif
 }
 
 /**
@@ -100,12 +130,49 @@ static inline bool react_to_transaction(void) {
  * @return bool Indicates success of transaction.
  */
 bool soft_serial_transaction(int index) {
+#ifdef SPLIT_TRANSPORT_ASYNC
+    /* Wait for any transaction in flight to complete. */
+    chMtxLock(&initiator_mutex);
+#endif
+
     /* Clear the receive queue, to start with a clean slate.
      * Parts of failed transactions or spurious bytes could still be in it. */
     serial_transport_driver_clear();
 
-    return initiate_transaction((uint8_t)index);
+    bool success = initiate_transaction((uint8_t)index);
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+    chMtxUnlock(&initiator_mutex);
+#endif
+    return success;
+}
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+/**
+ * @brief Start transaction from the master half to the slave half, without
+ * waiting for its completion.
+ *
+ * @param index Transaction Table index of the transaction to start.
+ * @return bool false if a transaction is already in flight.
+ */
+bool soft_serial_transaction_begin(int index) {
+    if (async_status == TRANSPORT_ASYNC_BUSY) {
+        return false;
+    }
+
+    async_transaction_id = (uint8_t)index;
+    async_status         = TRANSPORT_ASYNC_BUSY;
+    chBSemSignal(&async_start);
+    return true;
+}
+
+/**
+ * @brief Status of the transaction last started by soft_serial_transaction_begin().
+ */
+transport_async_status_t soft_serial_transaction_poll(void) {
+    return async_status;
 }
+#endif // SPLIT_TRANSPORT_ASYNC
 
 /**
  * @brief Initiate transaction to slave half.
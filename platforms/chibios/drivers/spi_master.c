@@ -26,6 +26,36 @@ static pin_t currentSlavePin;
 
 static SPIConfig spiConfig;
 
+// Asynchronous transmit in flight, and whether spi_stop() was called before it finished
+static volatile bool        asyncInFlight = false;
+static spi_async_callback_t asyncCallback;
+static void *               asyncCallbackArg;
+static bool                 stopPending = false;
+static BSEMAPHORE_DECL(asyncDone, true);
+
+static void spi_async_end(SPIDriver *spip) {
+    if (asyncInFlight) {
+        asyncInFlight = false;
+        chSysLockFromISR();
+        chBSemSignalI(&asyncDone);
+        chSysUnlockFromISR();
+        if (asyncCallback) {
+            asyncCallback(asyncCallbackArg);
+        }
+    }
+}
+
+static void spi_stop_now(void) {
+#if SPI_SELECT_MODE == SPI_SELECT_MODE_NONE
+    if (currentSlavePin != NO_PIN) {
+        gpio_write_pin_high(currentSlavePin);
+    }
+#endif
+    spiUnselect(&SPI_DRIVER);
+    spiStop(&SPI_DRIVER);
+    spiStarted = false;
+}
+
 __attribute__((weak)) void spi_init(void) {
     static bool is_initialised = false;
     if (!is_initialised) {
@@ -64,6 +94,9 @@ __attribute__((weak)) void spi_init(void) {
 }
 
 bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
+    // Finish off the previous transaction if it was left to complete in the background
+    spi_wait();
+
     if (spiStarted) {
         return false;
     }
@@ -264,6 +297,12 @@ bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
     }
 #endif
 
+#if !defined(HAL_LLD_SELECT_SPI_V2)
+    spiConfig.end_cb = spi_async_end;
+#else
+    spiConfig.data_cb = spi_async_end;
+#endif
+
     spiStarted = true;
 #if SPI_SELECT_MODE == SPI_SELECT_MODE_NONE
     currentSlavePin = slavePin;
@@ -292,6 +331,8 @@ bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
 }
 
 spi_status_t spi_write(uint8_t data) {
+    spi_wait();
+
     uint8_t rxData;
     spiExchange(&SPI_DRIVER, 1, &data, &rxData);
 
@@ -299,6 +340,8 @@ spi_status_t spi_write(uint8_t data) {
 }
 
 spi_status_t spi_read(void) {
+    spi_wait();
+
     uint8_t data = 0;
     spiReceive(&SPI_DRIVER, 1, &data);
 
@@ -306,24 +349,54 @@ spi_status_t spi_read(void) {
 }
 
 spi_status_t spi_transmit(const uint8_t *data, uint16_t length) {
+    spi_wait();
+
     spiSend(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
 }
 
 spi_status_t spi_receive(uint8_t *data, uint16_t length) {
+    spi_wait();
+
     spiReceive(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
 }
 
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length, spi_async_callback_t callback, void *cb_arg) {
+    if (!spiStarted || stopPending) {
+        return SPI_STATUS_ERROR;
+    }
+
+    // Only one transmit is ever in flight
+    spi_wait();
+
+    asyncCallback    = callback;
+    asyncCallbackArg = cb_arg;
+    asyncInFlight    = true;
+    chBSemReset(&asyncDone, true);
+    spiStartSend(&SPI_DRIVER, length, data);
+    return SPI_STATUS_SUCCESS;
+}
+
+void spi_wait(void) {
+    // Sleeps rather than spins, the semaphore is signalled by the transfer complete interrupt
+    if (asyncInFlight) {
+        chBSemWait(&asyncDone);
+    }
+
+    if (stopPending) {
+        stopPending = false;
+        spi_stop_now();
+    }
+}
+
 void spi_stop(void) {
     if (spiStarted) {
-#if SPI_SELECT_MODE == SPI_SELECT_MODE_NONE
-        if (currentSlavePin != NO_PIN) {
-            gpio_write_pin_high(currentSlavePin);
+        // Leave the transaction open until an asynchronous transmit has finished, rather than waiting on it here
+        if (asyncInFlight) {
+            stopPending = true;
+            return;
         }
-#endif
-        spiUnselect(&SPI_DRIVER);
-        spiStop(&SPI_DRIVER);
-        spiStarted = false;
+        spi_stop_now();
     }
 }
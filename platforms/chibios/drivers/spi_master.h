@@ -72,6 +72,9 @@ typedef int16_t spi_status_t;
 #define SPI_TIMEOUT_IMMEDIATE (0)
 #define SPI_TIMEOUT_INFINITE (0xFFFF)
 
+// Invoked once an asynchronous transmit has finished, from the SPI interrupt
+typedef void (*spi_async_callback_t)(void *cb_arg);
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -87,6 +90,10 @@ spi_status_t spi_transmit(const uint8_t *data, uint16_t length);
 
 spi_status_t spi_receive(uint8_t *data, uint16_t length);
 
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length, spi_async_callback_t callback, void *cb_arg);
+
+void spi_wait(void);
+
 void spi_stop(void);
 #ifdef __cplusplus
 }
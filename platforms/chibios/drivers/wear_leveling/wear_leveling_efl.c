@@ -120,6 +120,37 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+bool backing_store_erase_range(uint32_t address, uint32_t length) {
+    bool          ret = true;
+    flash_error_t status;
+    for (int i = 0; i < sector_count; ++i) {
+        // Only erase the sectors overlapping the requested range
+        uint32_t sector_start = flashGetSectorOffset(flash, first_sector + i) - base_offset;
+        uint32_t sector_end   = sector_start + flashGetSectorSize(flash, first_sector + i);
+        if (sector_end <= address || sector_start >= address + length) {
+            continue;
+        }
+        if (sector_start < address || sector_end > address + length) {
+            // Sector straddles the other bank, erasing it would corrupt the live data
+            ret = false;
+            continue;
+        }
+
+        status = flashStartEraseSector(flash, first_sector + i);
+        if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+            ret = false;
+        }
+
+        status = flashWaitErase(flash);
+        if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+            ret = false;
+        }
+    }
+    return ret;
+}
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     uint32_t offset = (base_offset + address);
     bs_dprintf("Write ");
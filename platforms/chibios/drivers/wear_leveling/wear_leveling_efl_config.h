@@ -52,3 +52,11 @@
 #ifndef WEAR_LEVELING_LOGICAL_SIZE
 #    define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
 #endif // WEAR_LEVELING_LOGICAL_SIZE
+
+// Erase one sector per incremental consolidation step, where every sector has the same size. Otherwise, the sector
+// sizes are only known at runtime, so the whole bank is erased in one step.
+#ifndef WEAR_LEVELING_CONSOLIDATE_ERASE_SIZE
+#    if defined(STM32_FLASH_SECTOR_SIZE) // from some family's stm32_registry.h file
+#        define WEAR_LEVELING_CONSOLIDATE_ERASE_SIZE (STM32_FLASH_SECTOR_SIZE)
+#    endif
+#endif // WEAR_LEVELING_CONSOLIDATE_ERASE_SIZE
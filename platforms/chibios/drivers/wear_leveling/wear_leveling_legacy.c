@@ -36,6 +36,20 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+bool backing_store_erase_range(uint32_t address, uint32_t length) {
+    _Static_assert((WEAR_LEVELING_CONSOLIDATE_ERASE_SIZE) % (WEAR_LEVELING_LEGACY_EMULATION_PAGE_SIZE) == 0, "Consolidation erase size must be a multiple of the page size");
+
+    bool ret = true;
+    for (uint32_t offset = address; offset < address + length; offset += (WEAR_LEVELING_LEGACY_EMULATION_PAGE_SIZE)) {
+        if (FLASH_ErasePage(WEAR_LEVELING_LEGACY_EMULATION_BASE_PAGE_ADDRESS + offset) != FLASH_COMPLETE) {
+            ret = false;
+        }
+    }
+    return ret;
+}
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     uint32_t offset = ((WEAR_LEVELING_LEGACY_EMULATION_BASE_PAGE_ADDRESS) + address);
     bs_dprintf("Write ");
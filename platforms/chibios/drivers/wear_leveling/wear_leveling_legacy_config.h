@@ -65,3 +65,8 @@
 #ifndef WEAR_LEVELING_LOGICAL_SIZE
 #    define WEAR_LEVELING_LOGICAL_SIZE 1024
 #endif
+
+// Erase one page per incremental consolidation step
+#ifndef WEAR_LEVELING_CONSOLIDATE_ERASE_SIZE
+#    define WEAR_LEVELING_CONSOLIDATE_ERASE_SIZE (WEAR_LEVELING_LEGACY_EMULATION_PAGE_SIZE)
+#endif
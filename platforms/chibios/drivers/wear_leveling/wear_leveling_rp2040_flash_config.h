@@ -21,6 +21,11 @@
 #    define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
 #endif // WEAR_LEVELING_LOGICAL_SIZE
 
+// Erase one sector per incremental consolidation step
+#ifndef WEAR_LEVELING_CONSOLIDATE_ERASE_SIZE
+#    define WEAR_LEVELING_CONSOLIDATE_ERASE_SIZE (FLASH_SECTOR_SIZE)
+#endif // WEAR_LEVELING_CONSOLIDATE_ERASE_SIZE
+
 // Define how much flash space we have (defaults to lib/pico-sdk/src/boards/include/boards/***)
 #ifndef WEAR_LEVELING_RP2040_FLASH_SIZE
 #    define WEAR_LEVELING_RP2040_FLASH_SIZE (PICO_FLASH_SIZE_BYTES)
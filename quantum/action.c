@@ -1009,8 +1009,10 @@ __attribute__((weak)) void unregister_code(uint8_t code) {
  */
 __attribute__((weak)) void tap_code_delay(uint8_t code, uint16_t delay) {
     register_code(code);
+    report_scheduler_flush();
     wait_ms(delay);
     unregister_code(code);
+    report_scheduler_flush();
 }
 
 /** \brief Tap a keycode with the default delay.
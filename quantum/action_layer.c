@@ -1,5 +1,6 @@
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "keyboard.h"
 #include "action.h"
@@ -289,6 +290,60 @@ uint8_t read_source_layers_cache(keypos_t key) {
 }
 #endif
 
+#if !defined(NO_ACTION_LAYER) && defined(RESOLVED_LAYER_CACHE)
+/** \brief resolved layers cache
+ *
+ * Topmost non-transparent layer for each matrix position, valid for the layer stack in resolved_layers_state.
+ * Zero initialised, which matches an empty layer stack where every key falls back to layer 0.
+ */
+#    define RESOLVED_LAYER_INVALID UINT8_MAX
+
+static uint8_t       resolved_layers_cache[MATRIX_ROWS * MATRIX_COLS] = {0};
+static layer_state_t resolved_layers_state                             = 0;
+
+/** \brief clear resolved layers cache
+ *
+ * Drops every cached entry, required whenever the keymap contents change wholesale
+ */
+void resolved_layers_cache_clear(void) {
+    memset(resolved_layers_cache, RESOLVED_LAYER_INVALID, sizeof(resolved_layers_cache));
+}
+
+/** \brief invalidate resolved layers cache entry
+ *
+ * Drops the cached entry for a single key, required whenever one of its keymap entries changes
+ */
+void resolved_layers_cache_invalidate(keypos_t key) {
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        resolved_layers_cache[(uint16_t)(key.row * MATRIX_COLS) + key.col] = RESOLVED_LAYER_INVALID;
+    }
+}
+
+/** \brief sync resolved layers cache
+ *
+ * Brings the cache in line with the current layer stack. Only entries that can resolve differently are dropped:
+ * those whose layer is no longer active, and those below a newly activated layer. Layers deactivated above an
+ * entry were transparent for that key, so it stays valid without touching the keymap.
+ */
+static void resolved_layers_cache_sync(layer_state_t layers) {
+    if (layers == resolved_layers_state) {
+        return;
+    }
+
+    const layer_state_t added        = layers & ~resolved_layers_state;
+    const uint8_t       lowest_valid = added ? get_highest_layer(added) : 0;
+
+    for (uint16_t i = 0; i < MATRIX_ROWS * MATRIX_COLS; i++) {
+        const uint8_t layer = resolved_layers_cache[i];
+        if (layer != RESOLVED_LAYER_INVALID && (layer < lowest_valid || !(layers & ((layer_state_t)1 << layer)))) {
+            resolved_layers_cache[i] = RESOLVED_LAYER_INVALID;
+        }
+    }
+
+    resolved_layers_state = layers;
+}
+#endif
+
 /** \brief Store or get action (FIXME: Needs better summary)
  *
  * Make sure the action triggered when the key is released is the same
@@ -316,16 +371,15 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
 #endif
 }
 
-/** \brief Layer switch get layer
+#ifndef NO_ACTION_LAYER
+/** \brief Layer switch resolve layer
  *
- * Gets the layer based on key info
+ * Walks the supplied layer stack from the top, returning the first layer with a non-transparent action for key
  */
-uint8_t layer_switch_get_layer(keypos_t key) {
-#ifndef NO_ACTION_LAYER
+static uint8_t layer_switch_resolve_layer(keypos_t key, layer_state_t layers) {
     action_t action;
     action.code = ACTION_TRANSPARENT;
 
-    layer_state_t layers = layer_state | default_layer_state;
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
@@ -337,6 +391,27 @@ uint8_t layer_switch_get_layer(keypos_t key) {
     }
     /* fall back to layer 0 */
     return 0;
+}
+#endif
+
+/** \brief Layer switch get layer
+ *
+ * Gets the layer based on key info
+ */
+uint8_t layer_switch_get_layer(keypos_t key) {
+#ifndef NO_ACTION_LAYER
+    layer_state_t layers = layer_state | default_layer_state;
+#    ifdef RESOLVED_LAYER_CACHE
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        const uint16_t entry_number = (uint16_t)(key.row * MATRIX_COLS) + key.col;
+        resolved_layers_cache_sync(layers);
+        if (resolved_layers_cache[entry_number] == RESOLVED_LAYER_INVALID) {
+            resolved_layers_cache[entry_number] = layer_switch_resolve_layer(key, layers);
+        }
+        return resolved_layers_cache[entry_number];
+    }
+#    endif
+    return layer_switch_resolve_layer(key, layers);
 #else
     return get_highest_layer(default_layer_state);
 #endif
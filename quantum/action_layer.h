@@ -161,6 +161,13 @@ layer_state_t update_tri_layer_state(layer_state_t state, uint8_t layer1, uint8_
 void    update_source_layers_cache(keypos_t key, uint8_t layer);
 uint8_t read_source_layers_cache(keypos_t key);
 #endif
+
+/* resolved layers cache */
+#if !defined(NO_ACTION_LAYER) && defined(RESOLVED_LAYER_CACHE)
+void resolved_layers_cache_clear(void);
+void resolved_layers_cache_invalidate(keypos_t key);
+#endif
+
 action_t store_or_get_action(bool pressed, keypos_t key);
 
 /* return the topmost non-transparent layer currently associated with key */
@@ -1,5 +1,6 @@
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "action.h"
 #include "action_layer.h"
@@ -59,13 +60,34 @@ __attribute__((weak)) bool get_hold_on_other_key_press(uint16_t keycode, keyreco
 #        include "process_auto_shift.h"
 #    endif
 
-static keyrecord_t tapping_key                         = {};
-static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE] = {};
-static uint8_t     waiting_buffer_head                 = 0;
-static uint8_t     waiting_buffer_tail                 = 0;
+#    if WAITING_BUFFER_SIZE < 2 || WAITING_BUFFER_SIZE > 128 || (WAITING_BUFFER_SIZE & (WAITING_BUFFER_SIZE - 1)) != 0
+#        error "WAITING_BUFFER_SIZE must be a power of two between 2 and 128"
+#    endif
+
+// head and tail count up freely and are masked to index the buffer, so that all of its slots can be used
+#    define WAITING_BUFFER_SLOT(i) ((uint8_t)(i) & (WAITING_BUFFER_SIZE - 1))
+#    define WAITING_BUFFER_DEPTH() ((uint8_t)(waiting_buffer_head - waiting_buffer_tail))
+
+// Waiting records are indexed per key, hashed by position, so that they can be looked up without scanning the buffer
+#    define WAITING_BUFFER_KEY_SLOTS (WAITING_BUFFER_SIZE * 2)
+#    define WAITING_BUFFER_KEY_SLOT(key) (((key).row * 31 + (key).col) & (WAITING_BUFFER_KEY_SLOTS - 1))
+
+static keyrecord_t tapping_key                                            = {};
+static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE]                    = {};
+static uint8_t     waiting_buffer_head                                    = 0;
+static uint8_t     waiting_buffer_tail                                    = 0;
+static uint8_t     waiting_buffer_presses[WAITING_BUFFER_KEY_SLOTS]       = {};
+// Waiting releases of each key slot, chained from the oldest to the newest by their head position
+static uint8_t     waiting_buffer_releases[WAITING_BUFFER_KEY_SLOTS]      = {};
+static uint8_t     waiting_buffer_first_release[WAITING_BUFFER_KEY_SLOTS] = {};
+static uint8_t     waiting_buffer_last_release[WAITING_BUFFER_KEY_SLOTS]  = {};
+static uint8_t     waiting_buffer_next_release[WAITING_BUFFER_SIZE]       = {};
+
+waiting_buffer_stats_t waiting_buffer_stats;
 
 static bool process_tapping(keyrecord_t *record);
 static bool waiting_buffer_enq(keyrecord_t record);
+static void waiting_buffer_deq(void);
 static void waiting_buffer_clear(void);
 static bool waiting_buffer_typed(keyevent_t event);
 static bool waiting_buffer_has_anykey_pressed(void);
@@ -98,11 +120,13 @@ void action_tapping_process(keyrecord_t record) {
     if (IS_EVENT(record.event) && waiting_buffer_head != waiting_buffer_tail) {
         ac_dprintf("---- action_exec: process waiting_buffer -----\n");
     }
-    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
-        if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
-            ac_dprintf("processed: waiting_buffer[%u] =", waiting_buffer_tail);
-            debug_record(waiting_buffer[waiting_buffer_tail]);
+    while (waiting_buffer_tail != waiting_buffer_head) {
+        keyrecord_t *waiting = &waiting_buffer[WAITING_BUFFER_SLOT(waiting_buffer_tail)];
+        if (process_tapping(waiting)) {
+            ac_dprintf("processed: waiting_buffer[%u] =", WAITING_BUFFER_SLOT(waiting_buffer_tail));
+            debug_record(*waiting);
             ac_dprintf("\n\n");
+            waiting_buffer_deq();
         } else {
             break;
         }
@@ -441,19 +465,53 @@ bool waiting_buffer_enq(keyrecord_t record) {
         return true;
     }
 
-    if ((waiting_buffer_head + 1) % WAITING_BUFFER_SIZE == waiting_buffer_tail) {
+    if (WAITING_BUFFER_DEPTH() == WAITING_BUFFER_SIZE) {
         ac_dprintf("waiting_buffer_enq: Over flow.\n");
+        if (waiting_buffer_stats.overflows < UINT16_MAX) {
+            waiting_buffer_stats.overflows++;
+        }
         return false;
     }
 
-    waiting_buffer[waiting_buffer_head] = record;
-    waiting_buffer_head                 = (waiting_buffer_head + 1) % WAITING_BUFFER_SIZE;
+    uint8_t key_slot                                         = WAITING_BUFFER_KEY_SLOT(record.event.key);
+    waiting_buffer[WAITING_BUFFER_SLOT(waiting_buffer_head)] = record;
+    if (record.event.pressed) {
+        waiting_buffer_presses[key_slot]++;
+    } else {
+        if (waiting_buffer_releases[key_slot]++ == 0) {
+            waiting_buffer_first_release[key_slot] = waiting_buffer_head;
+        } else {
+            waiting_buffer_next_release[WAITING_BUFFER_SLOT(waiting_buffer_last_release[key_slot])] = waiting_buffer_head;
+        }
+        waiting_buffer_last_release[key_slot] = waiting_buffer_head;
+    }
+    waiting_buffer_head++;
+    if (WAITING_BUFFER_DEPTH() > waiting_buffer_stats.peak_depth) {
+        waiting_buffer_stats.peak_depth = WAITING_BUFFER_DEPTH();
+    }
 
     ac_dprintf("waiting_buffer_enq: ");
     debug_waiting_buffer();
     return true;
 }
 
+/** \brief Waiting buffer deq
+ *
+ * Drops the oldest record, once processed.
+ */
+void waiting_buffer_deq(void) {
+    keyrecord_t *record   = &waiting_buffer[WAITING_BUFFER_SLOT(waiting_buffer_tail)];
+    uint8_t      key_slot = WAITING_BUFFER_KEY_SLOT(record->event.key);
+    if (record->event.pressed) {
+        waiting_buffer_presses[key_slot]--;
+    } else {
+        // Records leave in order, so this is the oldest release of its slot
+        waiting_buffer_releases[key_slot]--;
+        waiting_buffer_first_release[key_slot] = waiting_buffer_next_release[WAITING_BUFFER_SLOT(waiting_buffer_tail)];
+    }
+    waiting_buffer_tail++;
+}
+
 /** \brief Waiting buffer clear
  *
  * FIXME: Needs docs
@@ -461,6 +519,17 @@ bool waiting_buffer_enq(keyrecord_t record) {
 void waiting_buffer_clear(void) {
     waiting_buffer_head = 0;
     waiting_buffer_tail = 0;
+    memset(waiting_buffer_presses, 0, sizeof(waiting_buffer_presses));
+    memset(waiting_buffer_releases, 0, sizeof(waiting_buffer_releases));
+}
+
+/** \brief Waiting buffer reset stats
+ *
+ * Clears the counters, starting the peak depth over from the records waiting right now.
+ */
+void waiting_buffer_reset_stats(void) {
+    waiting_buffer_stats.peak_depth = WAITING_BUFFER_DEPTH();
+    waiting_buffer_stats.overflows  = 0;
 }
 
 /** \brief Waiting buffer typed
@@ -468,8 +537,13 @@ void waiting_buffer_clear(void) {
  * FIXME: Needs docs
  */
 bool waiting_buffer_typed(keyevent_t event) {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (KEYEQ(event.key, waiting_buffer[i].event.key) && event.pressed != waiting_buffer[i].event.pressed) {
+    // A key which has not been pressed since it started waiting cannot have been typed
+    if (!event.pressed && waiting_buffer_presses[WAITING_BUFFER_KEY_SLOT(event.key)] == 0) {
+        return false;
+    }
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i++) {
+        const keyrecord_t *record = &waiting_buffer[WAITING_BUFFER_SLOT(i)];
+        if (KEYEQ(event.key, record->event.key) && event.pressed != record->event.pressed) {
             return true;
         }
     }
@@ -481,8 +555,8 @@ bool waiting_buffer_typed(keyevent_t event) {
  * FIXME: Needs docs
  */
 __attribute__((unused)) bool waiting_buffer_has_anykey_pressed(void) {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (waiting_buffer[i].event.pressed) return true;
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i++) {
+        if (waiting_buffer[WAITING_BUFFER_SLOT(i)].event.pressed) return true;
     }
     return false;
 }
@@ -502,18 +576,21 @@ void waiting_buffer_scan_tap(void) {
 #    if (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT))
     TAP_DEFINE_KEYCODE;
 #    endif
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        keyrecord_t *candidate = &waiting_buffer[i];
+    // Only visit the waiting releases sharing the tapping key's slot, oldest first
+    uint8_t key_slot = WAITING_BUFFER_KEY_SLOT(tapping_key.event.key);
+    uint8_t i        = waiting_buffer_first_release[key_slot];
+    for (uint8_t n = waiting_buffer_releases[key_slot]; n > 0; n--, i = waiting_buffer_next_release[WAITING_BUFFER_SLOT(i)]) {
+        keyrecord_t *candidate = &waiting_buffer[WAITING_BUFFER_SLOT(i)];
         // clang-format off
         if (IS_EVENT(candidate->event) && KEYEQ(candidate->event.key, tapping_key.event.key) && !candidate->event.pressed && (
-            WITHIN_TAPPING_TERM(waiting_buffer[i].event) || MAYBE_RETRO_SHIFTING(waiting_buffer[i].event, &tapping_key)
+            WITHIN_TAPPING_TERM(candidate->event) || MAYBE_RETRO_SHIFTING(candidate->event, &tapping_key)
         )) {
             // clang-format on
             tapping_key.tap.count = 1;
             candidate->tap.count  = 1;
             process_record(&tapping_key);
 
-            ac_dprintf("waiting_buffer_scan_tap: found at [%u]\n", i);
+            ac_dprintf("waiting_buffer_scan_tap: found at [%u]\n", WAITING_BUFFER_SLOT(i));
             debug_waiting_buffer();
             return;
         }
@@ -536,9 +613,9 @@ static void debug_tapping_key(void) {
  */
 static void debug_waiting_buffer(void) {
     ac_dprintf("{ ");
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        ac_dprintf("[%u]=", i);
-        debug_record(waiting_buffer[i]);
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i++) {
+        ac_dprintf("[%u]=", WAITING_BUFFER_SLOT(i));
+        debug_record(waiting_buffer[WAITING_BUFFER_SLOT(i)]);
         ac_dprintf(" ");
     }
     ac_dprintf("}\n");
@@ -32,12 +32,24 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define TAPPING_TOGGLE 5
 #endif
 
-#define WAITING_BUFFER_SIZE 8
+/* number of key events that can wait for a tapping key to be settled, a power of two up to 128 */
+#ifndef WAITING_BUFFER_SIZE
+#    define WAITING_BUFFER_SIZE 8
+#endif
 
 #ifndef NO_ACTION_TAPPING
 uint16_t get_record_keycode(keyrecord_t *record, bool update_layer_cache);
 uint16_t get_event_keycode(keyevent_t event, bool update_layer_cache);
 void     action_tapping_process(keyrecord_t record);
+
+typedef struct _waiting_buffer_stats_t {
+    uint8_t  peak_depth; // most key events waiting at once
+    uint16_t overflows;  // key events which did not fit, each of which clears all keys
+} waiting_buffer_stats_t;
+
+extern waiting_buffer_stats_t waiting_buffer_stats;
+
+void waiting_buffer_reset_stats(void);
 #endif
 
 uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record);
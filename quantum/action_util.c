@@ -20,6 +20,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "action_util.h"
 #include "action_layer.h"
 #include "timer.h"
+#include "wait.h"
 #include "keycode_config.h"
 #include <string.h>
 
@@ -282,10 +283,219 @@ static uint8_t get_mods_for_report(void) {
     return mods;
 }
 
+#ifdef REPORT_SCHEDULER_ENABLE
+#    ifndef REPORT_SCHEDULER_QUEUE_SIZE
+#        define REPORT_SCHEDULER_QUEUE_SIZE 4
+#    endif
+#    ifndef REPORT_SCHEDULER_INTERVAL
+#        define REPORT_SCHEDULER_INTERVAL 1
+#    endif
+#    ifndef REPORT_SCHEDULER_FLUSH_TIMEOUT
+#        define REPORT_SCHEDULER_FLUSH_TIMEOUT 100
+#    endif
+
+#    if REPORT_SCHEDULER_QUEUE_SIZE < 1 || REPORT_SCHEDULER_QUEUE_SIZE > 64
+#        error "REPORT_SCHEDULER_QUEUE_SIZE must be between 1 and 64"
+#    endif
+
+typedef struct {
+    bool is_nkro;
+    union {
+        report_keyboard_t keyboard;
+#    ifdef NKRO_ENABLE
+        report_nkro_t nkro;
+#    endif
+    };
+} scheduled_report_t;
+
+/*
+    Reports waiting to be sent, oldest first, paced to one per REPORT_SCHEDULER_INTERVAL and held back while the host
+    has yet to take the previous one. Changes made while a report is waiting are folded into it where the host can not
+    tell the difference, so bursts of changes go out in fewer reports.
+*/
+static scheduled_report_t sched_queue[REPORT_SCHEDULER_QUEUE_SIZE];
+static uint8_t            sched_head  = 0;
+static uint8_t            sched_count = 0;
+static scheduled_report_t sched_sent  = {0};   // the last report sent to the host
+static uint16_t           sched_time  = 0;     // when the last report was sent
+static bool               sched_retry = false; // a report was turned away by a full queue, and is sent again once there is room
+
+report_scheduler_stats_t report_scheduler_stats;
+
+void report_scheduler_reset_stats(void) {
+    memset(&report_scheduler_stats, 0, sizeof(report_scheduler_stats));
+    report_scheduler_stats.peak_depth = sched_count;
+}
+
+uint8_t report_scheduler_depth(void) {
+    return sched_count;
+}
+
+static inline uint8_t sched_slot(uint8_t n) {
+    return (sched_head + n) % REPORT_SCHEDULER_QUEUE_SIZE;
+}
+
+static uint8_t sched_mods(const scheduled_report_t *report) {
+#    ifdef NKRO_ENABLE
+    if (report->is_nkro) {
+        return report->nkro.mods;
+    }
+#    endif
+    return report->keyboard.mods;
+}
+
+static void sched_keys(const scheduled_report_t *report, uint8_t keys[NKRO_REPORT_BITS]) {
+#    ifdef NKRO_ENABLE
+    if (report->is_nkro) {
+        memcpy(keys, report->nkro.bits, NKRO_REPORT_BITS);
+        return;
+    }
+#    endif
+    memset(keys, 0, NKRO_REPORT_BITS);
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        uint8_t key = report->keyboard.keys[i];
+        if (key && (key >> 3) < NKRO_REPORT_BITS) {
+            keys[key >> 3] |= 1 << (key & 7);
+        }
+    }
+}
+
+static bool sched_equal(const scheduled_report_t *a, const scheduled_report_t *b) {
+    if (a->is_nkro != b->is_nkro) {
+        return false;
+    }
+#    ifdef NKRO_ENABLE
+    if (a->is_nkro) {
+        return memcmp(&a->nkro, &b->nkro, sizeof(report_nkro_t)) == 0;
+    }
+#    endif
+    return memcmp(&a->keyboard, &b->keyboard, sizeof(report_keyboard_t)) == 0;
+}
+
+/**
+ * \brief Whether the host would see the same thing if the changes from base to pending and from pending to next were
+ * sent as a single report.
+ *
+ * That is the case as long as no key or modifier changes back, which would lose a press or release, and the order
+ * of the changes does not matter: at most one key is pressed, and modifiers do not change after keys.
+ */
+static bool sched_can_merge(const scheduled_report_t *base, const scheduled_report_t *pending, const scheduled_report_t *next) {
+    if (base->is_nkro != next->is_nkro || pending->is_nkro != next->is_nkro) {
+        return false;
+    }
+
+    uint8_t mods_before = sched_mods(base) ^ sched_mods(pending);
+    uint8_t mods_after  = sched_mods(pending) ^ sched_mods(next);
+    if (mods_before & mods_after) {
+        return false;
+    }
+
+    uint8_t base_keys[NKRO_REPORT_BITS], pending_keys[NKRO_REPORT_BITS], next_keys[NKRO_REPORT_BITS];
+    sched_keys(base, base_keys);
+    sched_keys(pending, pending_keys);
+    sched_keys(next, next_keys);
+
+    bool keys_before    = false;
+    bool pressed_before = false;
+    bool pressed_after  = false;
+    for (uint8_t i = 0; i < NKRO_REPORT_BITS; i++) {
+        uint8_t before = base_keys[i] ^ pending_keys[i];
+        uint8_t after  = pending_keys[i] ^ next_keys[i];
+        if (before & after) {
+            return false;
+        }
+        keys_before |= before;
+        pressed_before |= pending_keys[i] & ~base_keys[i];
+        pressed_after |= next_keys[i] & ~pending_keys[i];
+    }
+    return !(pressed_before && pressed_after) && !(keys_before && mods_after);
+}
+
+static void sched_send(void) {
+    scheduled_report_t *report = &sched_queue[sched_head];
+
+    // Kept before sending, as the host functions fill in the report ID
+    sched_sent = *report;
+#    ifdef NKRO_ENABLE
+    if (report->is_nkro) {
+        host_nkro_send(&report->nkro);
+    } else
+#    endif
+    {
+        host_keyboard_send(&report->keyboard);
+    }
+    sched_time = timer_read();
+    sched_head = sched_slot(1);
+    sched_count--;
+    report_scheduler_stats.sent++;
+
+    // The report turned away carried the state at the time, which is still what the host needs to see next
+    if (sched_retry) {
+        sched_retry = false;
+        send_keyboard_report();
+    }
+}
+
+static void sched_push(const scheduled_report_t *next) {
+    const scheduled_report_t *newest = sched_count > 0 ? &sched_queue[sched_slot(sched_count - 1)] : &sched_sent;
+    if (sched_equal(next, newest)) {
+        report_scheduler_stats.dropped++;
+        return;
+    }
+
+    if (sched_count > 0) {
+        scheduled_report_t       *pending = &sched_queue[sched_slot(sched_count - 1)];
+        const scheduled_report_t *base    = sched_count > 1 ? &sched_queue[sched_slot(sched_count - 2)] : &sched_sent;
+        if (sched_can_merge(base, pending, next)) {
+            *pending = *next;
+            report_scheduler_stats.merged++;
+            return;
+        }
+    }
+
+    if (sched_count == REPORT_SCHEDULER_QUEUE_SIZE) {
+        // Sending the oldest report right away could block on a busy host, so this one is left for later instead
+        sched_retry = true;
+        report_scheduler_stats.overflows++;
+        return;
+    }
+
+    sched_queue[sched_slot(sched_count)] = *next;
+    sched_count++;
+    if (sched_count > report_scheduler_stats.peak_depth) {
+        report_scheduler_stats.peak_depth = sched_count;
+    }
+
+    report_scheduler_task();
+}
+
+void report_scheduler_task(void) {
+    if (sched_count > 0 && timer_elapsed(sched_time) >= REPORT_SCHEDULER_INTERVAL && host_keyboard_ready()) {
+        sched_send();
+    }
+}
+
+void report_scheduler_flush(void) {
+    uint16_t waited = 0;
+    while (sched_count > 0) {
+        if (waited < REPORT_SCHEDULER_FLUSH_TIMEOUT && (timer_elapsed(sched_time) < REPORT_SCHEDULER_INTERVAL || !host_keyboard_ready())) {
+            wait_ms(1);
+            waited++;
+            continue;
+        }
+        // Past the timeout, the rest is handed over regardless of the host, as it would have been without the scheduler
+        sched_send();
+    }
+}
+#endif
+
 void send_6kro_report(void) {
     keyboard_report->mods = get_mods_for_report();
 
-#ifdef PROTOCOL_VUSB
+#if defined(REPORT_SCHEDULER_ENABLE)
+    scheduled_report_t next = {.is_nkro = false, .keyboard = *keyboard_report};
+    sched_push(&next);
+#elif defined(PROTOCOL_VUSB)
     host_keyboard_send(keyboard_report);
 #else
     static report_keyboard_t last_report;
@@ -302,6 +512,10 @@ void send_6kro_report(void) {
 void send_nkro_report(void) {
     nkro_report->mods = get_mods_for_report();
 
+#    ifdef REPORT_SCHEDULER_ENABLE
+    scheduled_report_t next = {.is_nkro = true, .nkro = *nkro_report};
+    sched_push(&next);
+#    else
     static report_nkro_t last_report;
 
     /* Only send the report if there are changes to propagate to the host. */
@@ -309,6 +523,7 @@ void send_nkro_report(void) {
         memcpy(&last_report, nkro_report, sizeof(report_nkro_t));
         host_nkro_send(nkro_report);
     }
+#    endif
 }
 #endif
 
@@ -32,6 +32,36 @@ extern report_nkro_t *nkro_report;
 
 void send_keyboard_report(void);
 
+#ifdef REPORT_SCHEDULER_ENABLE
+typedef struct _report_scheduler_stats_t {
+    uint8_t  peak_depth; // most reports waiting to be sent at once
+    uint32_t sent;       // reports sent to the host
+    uint32_t merged;     // changes folded into a report still waiting to be sent, rather than queued on their own
+    uint32_t dropped;    // reports left unsent as nothing had changed since the one before
+    uint32_t overflows;  // reports turned away by a full queue, and sent again once there was room
+} report_scheduler_stats_t;
+
+extern report_scheduler_stats_t report_scheduler_stats;
+
+void report_scheduler_reset_stats(void);
+
+/** \brief Number of reports waiting to be sent. */
+uint8_t report_scheduler_depth(void);
+
+/** \brief Sends the oldest waiting report, once the interval has passed and the host is ready for it. */
+void report_scheduler_task(void);
+
+/**
+ * \brief Sends every waiting report before returning, waiting for the host for up to REPORT_SCHEDULER_FLUSH_TIMEOUT
+ * milliseconds.
+ *
+ * Blocking helpers such as tap_code() call this so their keystrokes reach the host, as does shutting down.
+ */
+void report_scheduler_flush(void);
+#else
+#    define report_scheduler_flush()
+#endif
+
 /* key */
 inline void add_key(uint8_t key) {
     add_key_to_report(key);
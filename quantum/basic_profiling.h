@@ -19,19 +19,19 @@
         PROFILE_CALL_NAMED(1000, "matrix_task", {
             matrix_task();
         });
+
+    When the profiler is enabled (`PROFILER_ENABLE = yes`), wrapped calls are recorded as profiler zones instead, see
+    profiler.h. The count is then ignored.
 */
 
-#if defined(PROTOCOL_LUFA) || defined(PROTOCOL_VUSB)
-#    define TIMESTAMP_GETTER TCNT0
-#elif defined(PROTOCOL_CHIBIOS)
-#    define TIMESTAMP_GETTER chSysGetRealtimeCounterX()
-#elif defined(PROTOCOL_ARM_ATSAM)
-#    error arm_atsam not currently supported
-#else
-#    error Unknown protocol in use
-#endif
+#include "profiler.h"
+#include "profiler_timestamp.h"
+
+#define TIMESTAMP_GETTER PROFILER_TIMESTAMP()
 
-#ifndef CONSOLE_ENABLE
+#if defined(PROFILER_ENABLE)
+#    define PROFILE_CALL_NAMED(count, name, call) PROFILE_ZONE(name, call)
+#elif !defined(CONSOLE_ENABLE)
 // Can't do anything if we don't have console output enabled.
 #    define PROFILE_CALL_NAMED(count, name, call) \
         do {                                      \
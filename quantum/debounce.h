@@ -18,4 +18,12 @@ bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool
 
 void debounce_init(uint8_t num_rows);
 
+/**
+ * @brief Invoked by the debounce algorithms for each row of cooked they write a change to.
+ *
+ * @param cooked The debounced key state passed to debounce()
+ * @param row The row of cooked that changed
+ */
+void debounce_row_changed(matrix_row_t cooked[], uint8_t row);
+
 void debounce_free(void);
@@ -128,8 +128,11 @@ static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[],
                     } else {
                         // key-up: defer
                         matrix_row_t cooked_next = (cooked[row] & ~col_mask) | (raw[row] & col_mask);
-                        cooked_changed |= cooked_next ^ cooked[row];
-                        cooked[row] = cooked_next;
+                        if (cooked[row] != cooked_next) {
+                            cooked[row] = cooked_next;
+                            debounce_row_changed(cooked, row);
+                            cooked_changed = true;
+                        }
                     }
                 } else {
                     debounce_pointer->time -= elapsed_time;
@@ -160,6 +163,7 @@ static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], ui
                     if (debounce_pointer->pressed) {
                         // key-down: eager
                         cooked[row] ^= col_mask;
+                        debounce_row_changed(cooked, row);
                         cooked_changed = true;
                     }
                 }
@@ -15,7 +15,6 @@
  */
 
 #include "debounce.h"
-#include <string.h>
 
 void debounce_init(uint8_t num_rows) {}
 
@@ -23,10 +22,12 @@ bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool
     bool cooked_changed = false;
 
     if (changed) {
-        size_t matrix_size = num_rows * sizeof(matrix_row_t);
-        if (memcmp(cooked, raw, matrix_size) != 0) {
-            memcpy(cooked, raw, matrix_size);
-            cooked_changed = true;
+        for (uint8_t row = 0; row < num_rows; row++) {
+            if (cooked[row] != raw[row]) {
+                cooked[row] = raw[row];
+                debounce_row_changed(cooked, row);
+                cooked_changed = true;
+            }
         }
     }
 
@@ -19,7 +19,6 @@ When no state changes have occured for DEBOUNCE milliseconds, we push the state.
 */
 #include "debounce.h"
 #include "timer.h"
-#include <string.h>
 #ifndef DEBOUNCE
 #    define DEBOUNCE 5
 #endif
@@ -43,10 +42,12 @@ bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool
         debouncing      = true;
         debouncing_time = timer_read_fast();
     } else if (debouncing && timer_elapsed_fast(debouncing_time) >= DEBOUNCE) {
-        size_t matrix_size = num_rows * sizeof(matrix_row_t);
-        if (memcmp(cooked, raw, matrix_size) != 0) {
-            memcpy(cooked, raw, matrix_size);
-            cooked_changed = true;
+        for (uint8_t row = 0; row < num_rows; row++) {
+            if (cooked[row] != raw[row]) {
+                cooked[row] = raw[row];
+                debounce_row_changed(cooked, row);
+                cooked_changed = true;
+            }
         }
         debouncing = false;
     }
@@ -109,8 +109,11 @@ static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[],
                 if (*debounce_pointer <= elapsed_time) {
                     *debounce_pointer        = DEBOUNCE_ELAPSED;
                     matrix_row_t cooked_next = (cooked[row] & ~(ROW_SHIFTER << col)) | (raw[row] & (ROW_SHIFTER << col));
-                    cooked_changed |= cooked[row] ^ cooked_next;
-                    cooked[row] = cooked_next;
+                    if (cooked[row] != cooked_next) {
+                        cooked[row] = cooked_next;
+                        debounce_row_changed(cooked, row);
+                        cooked_changed = true;
+                    }
                 } else {
                     *debounce_pointer -= elapsed_time;
                     counters_need_update = true;
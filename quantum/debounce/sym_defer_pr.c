@@ -63,9 +63,12 @@ bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool
         } else if (*countdown > elapsed) {
             *countdown -= elapsed;
         } else if (*countdown) {
-            cooked_changed |= cooked[row] ^ raw_row;
-            cooked[row] = raw_row;
-            *countdown  = 0;
+            if (cooked[row] != raw_row) {
+                cooked[row] = raw_row;
+                debounce_row_changed(cooked, row);
+                cooked_changed = true;
+            }
+            *countdown = 0;
         }
     }
 
@@ -141,7 +141,10 @@ static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], ui
             }
             debounce_pointer++;
         }
-        cooked[row] = existing_row;
+        if (cooked[row] != existing_row) {
+            cooked[row] = existing_row;
+            debounce_row_changed(cooked, row);
+        }
     }
 }
 
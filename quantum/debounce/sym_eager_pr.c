@@ -127,10 +127,11 @@ static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], ui
         // determine new value basd on debounce pointer + raw value
         if (existing_row != raw_row) {
             if (*debounce_pointer == DEBOUNCE_ELAPSED) {
-                *debounce_pointer = DEBOUNCE;
-                cooked_changed |= cooked[row] ^ raw_row;
+                *debounce_pointer    = DEBOUNCE;
+                cooked_changed       = true;
                 cooked[row]          = raw_row;
                 counters_need_update = true;
+                debounce_row_changed(cooked, row);
             }
         }
         debounce_pointer++;
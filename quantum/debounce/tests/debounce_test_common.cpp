@@ -34,6 +34,12 @@ void     set_time(uint32_t t);
 void     advance_time(uint32_t ms);
 }
 
+static bool marked_rows[MATRIX_ROWS];
+
+void debounce_row_changed(matrix_row_t cooked[], uint8_t row) {
+    marked_rows[row] = true;
+}
+
 void DebounceTest::addEvents(std::initializer_list<DebounceTestEvent> events) {
     events_.insert(events_.end(), events.begin(), events.end());
 }
@@ -130,6 +136,7 @@ void DebounceTest::runDebounce(bool changed) {
     std::copy(std::begin(output_matrix_), std::end(output_matrix_), std::begin(cooked_matrix_));
 
     reset_access_counter();
+    std::fill(std::begin(marked_rows), std::end(marked_rows), false);
 
     bool cooked_changed = debounce(raw_matrix_, cooked_matrix_, MATRIX_ROWS, changed);
 
@@ -141,6 +148,12 @@ void DebounceTest::runDebounce(bool changed) {
         FAIL() << "Fatal error: debounce() reported a wrong cooked matrix change result at " << strTime() << "\noutput_matrix: cooked_changed=" << cooked_changed << "\n" << strMatrix(output_matrix_) << "\ncooked_matrix:\n" << strMatrix(cooked_matrix_);
     }
 
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (marked_rows[row] != (output_matrix_[row] != cooked_matrix_[row])) {
+            FAIL() << "Fatal error: debounce() reported a wrong changed state for row " << +row << " at " << strTime() << "\nrow_marked=" << marked_rows[row] << "\noutput_matrix:\n" << strMatrix(output_matrix_) << "\ncooked_matrix:\n" << strMatrix(cooked_matrix_);
+        }
+    }
+
     if (current_access_counter() > 1) {
         FAIL() << "Fatal error: debounce() read the timer multiple times, which is not allowed, at " << strTime() << "\ntimer: access_count=" << current_access_counter() << "\noutput_matrix: cooked_changed=" << cooked_changed << "\n" << strMatrix(output_matrix_) << "\ncooked_matrix:\n" << strMatrix(cooked_matrix_);
     }
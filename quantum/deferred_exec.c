@@ -13,30 +13,34 @@
 // Helpers
 //
 
-static deferred_token current_token = 0;
+// Every slot needs at least two generations of tokens, so at most this many entries of a table are usable
+static inline size_t usable_count(size_t table_count) {
+    return table_count < UINT16_MAX / 2 ? table_count : UINT16_MAX / 2;
+}
 
-static inline bool token_can_be_used(deferred_executor_t *table, size_t table_count, deferred_token token) {
-    if (token == INVALID_DEFERRED_TOKEN) {
-        return false;
-    }
-    for (int i = 0; i < table_count; ++i) {
-        if (table[i].token == token) {
-            return false;
-        }
-    }
-    return true;
+// Tokens encode the slot they refer to, combined with a generation which is advanced each time the slot is reused,
+// so that a freed token is never handed straight back out for the same slot. This makes tokens unique by
+// construction and lookups constant-time.
+static inline deferred_token allocate_token(deferred_executor_t *entry, size_t table_count, size_t slot) {
+    const uint16_t generations = UINT16_MAX / table_count;
+    entry->generation          = (entry->generation + 1) % generations;
+    return (deferred_token)(1 + slot + entry->generation * table_count);
 }
 
-static inline deferred_token allocate_token(deferred_executor_t *table, size_t table_count) {
-    deferred_token first = ++current_token;
-    while (!token_can_be_used(table, table_count, current_token)) {
-        ++current_token;
-        if (current_token == first) {
-            // If we've looped back around to the first, everything is already allocated (yikes!). Need to exit with a failure.
-            return INVALID_DEFERRED_TOKEN;
-        }
+static inline deferred_executor_t *find_executor(deferred_executor_t *table, size_t table_count, deferred_token token) {
+    if (table_count == 0 || token == INVALID_DEFERRED_TOKEN) {
+        return NULL;
     }
-    return current_token;
+    deferred_executor_t *entry = &table[(token - 1) % table_count];
+    return entry->token == token ? entry : NULL;
+}
+
+// The generation is kept, so the next token allocated for the slot differs from the one being freed
+static inline void clear_executor(deferred_executor_t *entry) {
+    entry->token        = INVALID_DEFERRED_TOKEN;
+    entry->trigger_time = 0;
+    entry->callback     = NULL;
+    entry->cb_arg       = NULL;
 }
 
 //------------------------------------
@@ -50,21 +54,16 @@ deferred_token defer_exec_advanced(deferred_executor_t *table, size_t table_coun
     }
 
     // Find an unused slot and claim it
+    table_count = usable_count(table_count);
     for (int i = 0; i < table_count; ++i) {
         deferred_executor_t *entry = &table[i];
         if (entry->token == INVALID_DEFERRED_TOKEN) {
-            // Work out the new token value, dropping out if none were available
-            deferred_token token = allocate_token(table, table_count);
-            if (token == INVALID_DEFERRED_TOKEN) {
-                return false;
-            }
-
             // Set up the executor table entry
-            entry->token        = current_token;
+            entry->token        = allocate_token(entry, table_count, i);
             entry->trigger_time = timer_read32() + delay_ms;
             entry->callback     = callback;
             entry->cb_arg       = cb_arg;
-            return current_token;
+            return entry->token;
         }
     }
 
@@ -79,17 +78,14 @@ bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, extend the delay
-            entry->trigger_time = timer_read32() + delay_ms;
-            return true;
-        }
+    deferred_executor_t *entry = find_executor(table, usable_count(table_count), token);
+    if (!entry) {
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, extend the delay
+    entry->trigger_time = timer_read32() + delay_ms;
+    return true;
 }
 
 bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token) {
@@ -99,20 +95,14 @@ bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, cancel and clear the table entry
-            entry->token        = INVALID_DEFERRED_TOKEN;
-            entry->trigger_time = 0;
-            entry->callback     = NULL;
-            entry->cb_arg       = NULL;
-            return true;
-        }
+    deferred_executor_t *entry = find_executor(table, usable_count(table_count), token);
+    if (!entry) {
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, cancel and clear the table entry
+    clear_executor(entry);
+    return true;
 }
 
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time) {
@@ -146,10 +136,7 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
                     entry->trigger_time += delay_ms;
                 } else {
                     // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
-                    entry->token        = INVALID_DEFERRED_TOKEN;
-                    entry->trigger_time = 0;
-                    entry->callback     = NULL;
-                    entry->cb_arg       = NULL;
+                    clear_executor(entry);
                 }
             }
         }
@@ -163,6 +150,8 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
 static uint32_t            last_deferred_exec_check                = 0;
 static deferred_executor_t basic_executors[MAX_DEFERRED_EXECUTORS] = {0};
 
+#ifndef DEFERRED_EXEC_MIN_HEAP
+
 deferred_token defer_exec(uint32_t delay_ms, deferred_exec_callback callback, void *cb_arg) {
     return defer_exec_advanced(basic_executors, MAX_DEFERRED_EXECUTORS, delay_ms, callback, cb_arg);
 }
@@ -175,3 +164,221 @@ bool cancel_deferred_exec(deferred_token token) {
 void deferred_exec_task(void) {
     deferred_exec_advanced_task(basic_executors, MAX_DEFERRED_EXECUTORS, &last_deferred_exec_check);
 }
+
+#else // DEFERRED_EXEC_MIN_HEAP
+
+//------------------------------------
+// Min-heap scheduler: pending executors are kept ordered by trigger time, so each task only looks at the ones that are
+// due, and free slots are handed out from a queue instead of being searched for.
+//
+
+#    if MAX_DEFERRED_EXECUTORS >= UINT8_MAX
+#        error MAX_DEFERRED_EXECUTORS must be less than 255 when DEFERRED_EXEC_MIN_HEAP is enabled
+#    endif
+
+#    define NO_SLOT UINT8_MAX
+
+static uint8_t heap[MAX_DEFERRED_EXECUTORS];          // slots ordered as a binary min-heap on trigger time
+static uint8_t heap_position[MAX_DEFERRED_EXECUTORS]; // heap index of each slot, NO_SLOT when not queued
+static uint8_t heap_size = 0;
+static uint8_t free_next[MAX_DEFERRED_EXECUTORS]; // free slots, handed out oldest first
+static uint8_t free_head = NO_SLOT;
+static uint8_t free_tail = NO_SLOT;
+static uint8_t due_slots[MAX_DEFERRED_EXECUTORS];
+static bool    heap_initialised = false;
+
+static void free_slot_push(uint8_t slot) {
+    free_next[slot] = NO_SLOT;
+    if (free_tail == NO_SLOT) {
+        free_head = slot;
+    } else {
+        free_next[free_tail] = slot;
+    }
+    free_tail = slot;
+}
+
+static uint8_t free_slot_pop(void) {
+    uint8_t slot = free_head;
+    if (slot != NO_SLOT) {
+        free_head = free_next[slot];
+        if (free_head == NO_SLOT) {
+            free_tail = NO_SLOT;
+        }
+    }
+    return slot;
+}
+
+static void heap_init(void) {
+    for (uint8_t i = 0; i < MAX_DEFERRED_EXECUTORS; ++i) {
+        heap_position[i] = NO_SLOT;
+        free_slot_push(i);
+    }
+    heap_initialised = true;
+}
+
+static inline bool heap_before(uint8_t a, uint8_t b) {
+    return ((int32_t)TIMER_DIFF_32(basic_executors[a].trigger_time, basic_executors[b].trigger_time)) < 0;
+}
+
+static inline void heap_place(uint8_t index, uint8_t slot) {
+    heap[index]         = slot;
+    heap_position[slot] = index;
+}
+
+static void heap_sift_up(uint8_t index) {
+    uint8_t slot = heap[index];
+    while (index > 0) {
+        uint8_t parent = (index - 1) / 2;
+        if (!heap_before(slot, heap[parent])) {
+            break;
+        }
+        heap_place(index, heap[parent]);
+        index = parent;
+    }
+    heap_place(index, slot);
+}
+
+static void heap_sift_down(uint8_t index) {
+    uint8_t slot = heap[index];
+    while (true) {
+        uint16_t child = (uint16_t)index * 2 + 1;
+        if (child >= heap_size) {
+            break;
+        }
+        if (child + 1 < heap_size && heap_before(heap[child + 1], heap[child])) {
+            ++child;
+        }
+        if (!heap_before(heap[child], slot)) {
+            break;
+        }
+        heap_place(index, heap[child]);
+        index = child;
+    }
+    heap_place(index, slot);
+}
+
+static void heap_push(uint8_t slot) {
+    heap_place(heap_size++, slot);
+    heap_sift_up(heap_size - 1);
+}
+
+static void heap_remove(uint8_t slot) {
+    uint8_t index       = heap_position[slot];
+    heap_position[slot] = NO_SLOT;
+    if (index != --heap_size) {
+        // Move the last entry into the hole, then restore ordering in whichever direction it violates
+        uint8_t moved = heap[heap_size];
+        heap_place(index, moved);
+        heap_sift_up(index);
+        heap_sift_down(heap_position[moved]);
+    }
+}
+
+deferred_token defer_exec(uint32_t delay_ms, deferred_exec_callback callback, void *cb_arg) {
+    // Ignore queueing if it's a zero-time delay, or the callback is not valid
+    if (delay_ms == 0 || !callback) {
+        return INVALID_DEFERRED_TOKEN;
+    }
+
+    if (!heap_initialised) {
+        heap_init();
+    }
+
+    uint8_t slot = free_slot_pop();
+    if (slot == NO_SLOT) {
+        return INVALID_DEFERRED_TOKEN;
+    }
+
+    deferred_executor_t *entry = &basic_executors[slot];
+    entry->token               = allocate_token(entry, MAX_DEFERRED_EXECUTORS, slot);
+    entry->trigger_time        = timer_read32() + delay_ms;
+    entry->callback            = callback;
+    entry->cb_arg              = cb_arg;
+    heap_push(slot);
+    return entry->token;
+}
+
+bool extend_deferred_exec(deferred_token token, uint32_t delay_ms) {
+    deferred_executor_t *entry = find_executor(basic_executors, MAX_DEFERRED_EXECUTORS, token);
+    if (delay_ms == 0 || !entry) {
+        return false;
+    }
+
+    entry->trigger_time = timer_read32() + delay_ms;
+
+    // Executors that are currently being run are requeued once their callback returns
+    uint8_t slot = entry - basic_executors;
+    if (heap_position[slot] != NO_SLOT) {
+        heap_sift_up(heap_position[slot]);
+        heap_sift_down(heap_position[slot]);
+    }
+    return true;
+}
+
+bool cancel_deferred_exec(deferred_token token) {
+    deferred_executor_t *entry = find_executor(basic_executors, MAX_DEFERRED_EXECUTORS, token);
+    if (!entry) {
+        return false;
+    }
+
+    uint8_t slot = entry - basic_executors;
+    if (heap_position[slot] != NO_SLOT) {
+        heap_remove(slot);
+    }
+    clear_executor(entry);
+    free_slot_push(slot);
+    return true;
+}
+
+void deferred_exec_task(void) {
+    uint32_t now = timer_read32();
+
+    // Throttle only once per millisecond
+    if (((int32_t)TIMER_DIFF_32(now, last_deferred_exec_check)) <= 0) {
+        return;
+    }
+    last_deferred_exec_check = now;
+
+    // Dequeue everything that is due first, so that each executor runs at most once per task, matching the table scan
+    uint8_t due_count = 0;
+    while (heap_size > 0 && ((int32_t)TIMER_DIFF_32(basic_executors[heap[0]].trigger_time, now)) <= 0) {
+        due_slots[due_count++] = heap[0];
+        heap_remove(heap[0]);
+    }
+
+    for (uint8_t i = 0; i < due_count; ++i) {
+        uint8_t              slot       = due_slots[i];
+        deferred_executor_t *entry      = &basic_executors[slot];
+        deferred_token       curr_token = entry->token;
+
+        // Skip executors cancelled (and possibly reallocated) by an earlier callback during this task
+        if (curr_token == INVALID_DEFERRED_TOKEN || heap_position[slot] != NO_SLOT) {
+            continue;
+        }
+
+        // Executors extended by an earlier callback during this task are no longer due
+        if (((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) > 0) {
+            heap_push(slot);
+            continue;
+        }
+
+        // Invoke the callback and work work out if we should be requeued
+        uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
+
+        // If the token has changed or the slot was requeued, then the callback has canceled and re-queued. Skip further processing.
+        if (entry->token != curr_token || heap_position[slot] != NO_SLOT) {
+            continue;
+        }
+
+        if (delay_ms > 0) {
+            // Same best-effort timing as the table scan, relative to the previous trigger
+            entry->trigger_time += delay_ms;
+            heap_push(slot);
+        } else {
+            clear_executor(entry);
+            free_slot_push(slot);
+        }
+    }
+}
+
+#endif // DEFERRED_EXEC_MIN_HEAP
@@ -17,10 +17,16 @@
 #include "dynamic_keymap.h"
 #include "keymap_introspection.h"
 #include "action.h"
+#include "action_layer.h"
 #include "eeprom.h"
 #include "progmem.h"
 #include "send_string.h"
 #include "keycodes.h"
+#include <string.h>
+#include "util.h"
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+#    include "timer.h"
+#endif
 
 #ifdef VIA_ENABLE
 #    include "via.h"
@@ -101,6 +107,142 @@ _Static_assert((DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) - (DYNAMIC_KEYMAP_MACRO_EEPROM_A
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
 
+#define DYNAMIC_KEYMAP_KEYMAP_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2)
+#ifdef ENCODER_MAP_ENABLE
+#    define DYNAMIC_KEYMAP_ENCODER_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * NUM_ENCODERS * 2 * 2)
+#else
+#    define DYNAMIC_KEYMAP_ENCODER_SIZE 0
+#endif
+
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+// Time since the last modification before dirty ranges are written back to EEPROM
+#    ifndef DYNAMIC_KEYMAP_WRITE_BACK_DELAY
+#        define DYNAMIC_KEYMAP_WRITE_BACK_DELAY 500
+#    endif
+// Number of separate dirty ranges tracked, further ranges are merged with the nearest one
+#    ifndef DYNAMIC_KEYMAP_DIRTY_RANGE_COUNT
+#        define DYNAMIC_KEYMAP_DIRTY_RANGE_COUNT 4
+#    endif
+
+typedef struct {
+    uint16_t start;
+    uint16_t end; // exclusive
+} dynamic_keymap_range_t;
+
+// Keymap followed by the encoder map, in the same big-endian layout as EEPROM
+static uint8_t                dynamic_keymap_mirror[DYNAMIC_KEYMAP_KEYMAP_SIZE + DYNAMIC_KEYMAP_ENCODER_SIZE];
+static bool                   dynamic_keymap_mirror_loaded = false;
+static dynamic_keymap_range_t dynamic_keymap_dirty[DYNAMIC_KEYMAP_DIRTY_RANGE_COUNT];
+static uint8_t                dynamic_keymap_dirty_count = 0;
+static uint32_t               dynamic_keymap_last_write  = 0;
+
+static void *dynamic_keymap_mirror_to_eeprom_address(uint16_t offset) {
+    if (offset < DYNAMIC_KEYMAP_KEYMAP_SIZE) {
+        return ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + offset;
+    }
+    return ((void *)DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR) + (offset - DYNAMIC_KEYMAP_KEYMAP_SIZE);
+}
+
+static uint8_t *dynamic_keymap_mirror_get(void) {
+    if (!dynamic_keymap_mirror_loaded) {
+        eeprom_read_block(dynamic_keymap_mirror, (void *)DYNAMIC_KEYMAP_EEPROM_ADDR, DYNAMIC_KEYMAP_KEYMAP_SIZE);
+#    ifdef ENCODER_MAP_ENABLE
+        eeprom_read_block(dynamic_keymap_mirror + DYNAMIC_KEYMAP_KEYMAP_SIZE, (void *)DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR, DYNAMIC_KEYMAP_ENCODER_SIZE);
+#    endif // ENCODER_MAP_ENABLE
+        dynamic_keymap_mirror_loaded = true;
+    }
+    return dynamic_keymap_mirror;
+}
+
+static void dynamic_keymap_mark_dirty(uint16_t start, uint16_t end) {
+    dynamic_keymap_last_write = timer_read32();
+
+    // Find the range which would grow the least by absorbing this one, overlapping or adjacent ranges cost nothing
+    uint8_t  nearest = 0;
+    uint16_t best    = UINT16_MAX;
+    for (uint8_t i = 0; i < dynamic_keymap_dirty_count; i++) {
+        dynamic_keymap_range_t *range = &dynamic_keymap_dirty[i];
+        uint16_t                gap   = (start > range->end) ? start - range->end : (range->start > end) ? range->start - end : 0;
+        if (gap < best) {
+            best    = gap;
+            nearest = i;
+        }
+    }
+
+    if (best > 0 && dynamic_keymap_dirty_count < DYNAMIC_KEYMAP_DIRTY_RANGE_COUNT) {
+        dynamic_keymap_dirty[dynamic_keymap_dirty_count++] = (dynamic_keymap_range_t){.start = start, .end = end};
+        return;
+    }
+
+    dynamic_keymap_range_t *range = &dynamic_keymap_dirty[nearest];
+    range->start                  = MIN(range->start, start);
+    range->end                    = MAX(range->end, end);
+
+    // The grown range may now touch others, fold them in
+    for (uint8_t i = 0; i < dynamic_keymap_dirty_count;) {
+        dynamic_keymap_range_t *other = &dynamic_keymap_dirty[i];
+        if (i != nearest && other->start <= range->end && range->start <= other->end) {
+            range->start = MIN(range->start, other->start);
+            range->end   = MAX(range->end, other->end);
+            // Swap in the last range, keeping track of the one being grown
+            *other = dynamic_keymap_dirty[--dynamic_keymap_dirty_count];
+            if (nearest == dynamic_keymap_dirty_count) {
+                nearest = i;
+                range   = other;
+            }
+            i = 0;
+            continue;
+        }
+        i++;
+    }
+}
+
+static void dynamic_keymap_mirror_update(uint16_t offset, const uint8_t *data, uint16_t size) {
+    uint8_t *mirror = dynamic_keymap_mirror_get();
+
+    // Only the span which actually changed needs writing back
+    uint16_t first = 0;
+    while (first < size && mirror[offset + first] == data[first]) {
+        first++;
+    }
+    if (first == size) {
+        return;
+    }
+    uint16_t last = size;
+    while (mirror[offset + last - 1] == data[last - 1]) {
+        last--;
+    }
+
+    memcpy(&mirror[offset + first], &data[first], last - first);
+    dynamic_keymap_mark_dirty(offset + first, offset + last);
+}
+
+void dynamic_keymap_flush(void) {
+    for (uint8_t i = 0; i < dynamic_keymap_dirty_count; i++) {
+        uint16_t start = dynamic_keymap_dirty[i].start;
+        uint16_t end   = dynamic_keymap_dirty[i].end;
+        // Ranges may span both the keymap and the encoder map, which need not be contiguous in EEPROM
+        if (start < DYNAMIC_KEYMAP_KEYMAP_SIZE && end > DYNAMIC_KEYMAP_KEYMAP_SIZE) {
+            eeprom_update_block(&dynamic_keymap_mirror[start], dynamic_keymap_mirror_to_eeprom_address(start), DYNAMIC_KEYMAP_KEYMAP_SIZE - start);
+            start = DYNAMIC_KEYMAP_KEYMAP_SIZE;
+        }
+        eeprom_update_block(&dynamic_keymap_mirror[start], dynamic_keymap_mirror_to_eeprom_address(start), end - start);
+    }
+    dynamic_keymap_dirty_count = 0;
+}
+
+void dynamic_keymap_mirror_invalidate(void) {
+    dynamic_keymap_mirror_loaded = false;
+    dynamic_keymap_dirty_count   = 0;
+}
+
+void dynamic_keymap_task(void) {
+    if (dynamic_keymap_dirty_count > 0 && timer_elapsed32(dynamic_keymap_last_write) >= DYNAMIC_KEYMAP_WRITE_BACK_DELAY) {
+        dynamic_keymap_flush();
+    }
+}
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
+
 uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
@@ -112,19 +254,29 @@ void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t c
 
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
-    void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    const uint8_t *entry = &dynamic_keymap_mirror_get()[(layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2) + (column * 2)];
+    return (entry[0] << 8) | entry[1];
+#else
+    uint8_t entry[2];
     // Big endian, so we can read/write EEPROM directly from host if we want
-    uint16_t keycode = eeprom_read_byte(address) << 8;
-    keycode |= eeprom_read_byte(address + 1);
-    return keycode;
+    eeprom_read_block(entry, dynamic_keymap_key_to_eeprom_address(layer, row, column), sizeof(entry));
+    return (entry[0] << 8) | entry[1];
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
 }
 
 void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
-    void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address, (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    const uint8_t entry[2] = {keycode >> 8, keycode & 0xFF};
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    dynamic_keymap_mirror_update((layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2) + (column * 2), entry, sizeof(entry));
+#else
+    eeprom_update_block(entry, dynamic_keymap_key_to_eeprom_address(layer, row, column), sizeof(entry));
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
+#if !defined(NO_ACTION_LAYER) && defined(RESOLVED_LAYER_CACHE)
+    resolved_layers_cache_invalidate((keypos_t){.row = row, .col = column});
+#endif
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -134,29 +286,46 @@ void *dynamic_keymap_encoder_to_eeprom_address(uint8_t layer, uint8_t encoder_id
 
 uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return KC_NO;
-    void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
+#    ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    const uint8_t *entry = &dynamic_keymap_mirror_get()[DYNAMIC_KEYMAP_KEYMAP_SIZE + (layer * NUM_ENCODERS * 2 * 2) + (encoder_id * 2 * 2) + (clockwise ? 0 : 2)];
+    return (entry[0] << 8) | entry[1];
+#    else
+    uint8_t entry[2];
     // Big endian, so we can read/write EEPROM directly from host if we want
-    uint16_t keycode = ((uint16_t)eeprom_read_byte(address + (clockwise ? 0 : 2))) << 8;
-    keycode |= eeprom_read_byte(address + (clockwise ? 0 : 2) + 1);
-    return keycode;
+    eeprom_read_block(entry, dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id) + (clockwise ? 0 : 2), sizeof(entry));
+    return (entry[0] << 8) | entry[1];
+#    endif // DYNAMIC_KEYMAP_RAM_MIRROR
 }
 
 void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise, uint16_t keycode) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return;
-    void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
+    const uint8_t entry[2] = {keycode >> 8, keycode & 0xFF};
+#    ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    dynamic_keymap_mirror_update(DYNAMIC_KEYMAP_KEYMAP_SIZE + (layer * NUM_ENCODERS * 2 * 2) + (encoder_id * 2 * 2) + (clockwise ? 0 : 2), entry, sizeof(entry));
+#    else
+    eeprom_update_block(entry, dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id) + (clockwise ? 0 : 2), sizeof(entry));
+#    endif // DYNAMIC_KEYMAP_RAM_MIRROR
 }
 #endif // ENCODER_MAP_ENABLE
 
 void dynamic_keymap_reset(void) {
-    // Reset the keymaps in EEPROM to what is in flash.
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    // The EEPROM may have been erased behind the mirror's back, so it is filled in full below and all of it is written
+    // back, rather than only what differs from the mirror.
+    dynamic_keymap_mirror_loaded = true;
+    dynamic_keymap_dirty_count   = 0;
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
+    // Reset the keymaps in EEPROM to what is in flash, a row at a time.
+    uint8_t row_buffer[MATRIX_COLS * 2];
     for (int layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
         for (int row = 0; row < MATRIX_ROWS; row++) {
             for (int column = 0; column < MATRIX_COLS; column++) {
-                dynamic_keymap_set_keycode(layer, row, column, keycode_at_keymap_location_raw(layer, row, column));
+                uint16_t keycode           = keycode_at_keymap_location_raw(layer, row, column);
+                row_buffer[column * 2]     = (uint8_t)(keycode >> 8);
+                row_buffer[column * 2 + 1] = (uint8_t)(keycode & 0xFF);
             }
+            dynamic_keymap_set_buffer((layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2), sizeof(row_buffer), row_buffer);
         }
 #ifdef ENCODER_MAP_ENABLE
         for (int encoder = 0; encoder < NUM_ENCODERS; encoder++) {
@@ -165,34 +334,39 @@ void dynamic_keymap_reset(void) {
         }
 #endif // ENCODER_MAP_ENABLE
     }
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    dynamic_keymap_dirty_count = 0;
+    dynamic_keymap_mark_dirty(0, sizeof(dynamic_keymap_mirror));
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
+#if !defined(NO_ACTION_LAYER) && defined(RESOLVED_LAYER_CACHE)
+    resolved_layers_cache_clear();
+#endif
 }
 
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *target                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
-        }
-        source++;
-        target++;
-    }
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    uint16_t valid = (offset < DYNAMIC_KEYMAP_KEYMAP_SIZE) ? MIN(size, DYNAMIC_KEYMAP_KEYMAP_SIZE - offset) : 0;
+    memcpy(data, &dynamic_keymap_mirror_get()[offset], valid);
+#else
+    uint16_t valid = (offset < DYNAMIC_KEYMAP_KEYMAP_SIZE) ? MIN(size, DYNAMIC_KEYMAP_KEYMAP_SIZE - offset) : 0;
+    eeprom_read_block(data, (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset), valid);
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
+    memset(data + valid, 0x00, size - valid);
 }
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *source                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    if (offset < DYNAMIC_KEYMAP_KEYMAP_SIZE) {
+        dynamic_keymap_mirror_update(offset, data, MIN(size, DYNAMIC_KEYMAP_KEYMAP_SIZE - offset));
+    }
+#else
+    if (offset < DYNAMIC_KEYMAP_KEYMAP_SIZE) {
+        eeprom_update_block(data, (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset), MIN(size, DYNAMIC_KEYMAP_KEYMAP_SIZE - offset));
     }
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
+#if !defined(NO_ACTION_LAYER) && defined(RESOLVED_LAYER_CACHE)
+    resolved_layers_cache_clear();
+#endif
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -220,37 +394,21 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
 }
 
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *target = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
-        }
-        source++;
-        target++;
-    }
+    uint16_t valid = (offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) ? MIN(size, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset) : 0;
+    eeprom_read_block(data, (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), valid);
+    memset(data + valid, 0x00, size - valid);
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *source = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
+    if (offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
+        eeprom_update_block(data, (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), MIN(size, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset));
     }
 }
 
 void dynamic_keymap_macro_reset(void) {
-    void *p   = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
-    void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
-    while (p != end) {
-        eeprom_update_byte(p, 0);
-        ++p;
+    uint8_t zeroes[32] = {0};
+    for (uint16_t offset = 0; offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE; offset += sizeof(zeroes)) {
+        eeprom_update_block(zeroes, (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), MIN(sizeof(zeroes), DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset));
     }
 }
 
@@ -38,6 +38,17 @@ void dynamic_keymap_reset(void);
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+// With DYNAMIC_KEYMAP_RAM_MIRROR defined, the keymap and encoder map are loaded into RAM on first access and all reads
+// are served from there. Modifications are tracked as dirty ranges, written back to EEPROM once nothing has changed
+// for DYNAMIC_KEYMAP_WRITE_BACK_DELAY milliseconds, or immediately with dynamic_keymap_flush().
+void dynamic_keymap_flush(void);
+void dynamic_keymap_task(void);
+// Drops the mirror along with any pending write back, so that it is reloaded from EEPROM on next access. Needed after
+// the EEPROM is modified behind the mirror's back, such as when eeconfig erases it.
+void dynamic_keymap_mirror_invalidate(void);
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
+
 // This overrides the one in quantum/keymap_common.c
 // uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key);
 
@@ -13,6 +13,10 @@
 #    include "haptic.h"
 #endif
 
+#if defined(DYNAMIC_KEYMAP_ENABLE)
+#    include "dynamic_keymap.h"
+#endif
+
 #if defined(VIA_ENABLE)
 bool via_eeprom_is_valid(void);
 void via_eeprom_set_valid(bool valid);
@@ -47,6 +51,10 @@ __attribute__((weak)) void eeconfig_init_kb(void) {
 void eeconfig_init_quantum(void) {
 #if defined(EEPROM_DRIVER)
     eeprom_driver_erase();
+#    if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_MIRROR)
+    // The keymap was erased along with everything else, so must be read again
+    dynamic_keymap_mirror_invalidate();
+#    endif
 #endif
 
     eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
@@ -109,6 +117,10 @@ void eeconfig_enable(void) {
 void eeconfig_disable(void) {
 #if defined(EEPROM_DRIVER)
     eeprom_driver_erase();
+#    if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_MIRROR)
+    // The keymap was erased along with everything else, so must be read again
+    dynamic_keymap_mirror_invalidate();
+#    endif
 #endif
     eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER_OFF);
 }
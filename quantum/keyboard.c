@@ -19,6 +19,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "keyboard.h"
 #include "keycode_config.h"
 #include "matrix.h"
+#include "debounce.h"
 #include "keymap_introspection.h"
 #include "host.h"
 #include "led.h"
@@ -32,6 +33,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "sendchar.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "profiler.h"
 #ifdef BOOTMAGIC_ENABLE
 #    include "bootmagic.h"
 #endif
@@ -110,6 +112,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef EEPROM_DRIVER
 #    include "eeprom_driver.h"
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    include "dynamic_keymap.h"
+#endif
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_INCREMENTAL_CONSOLIDATION)
+#    include "wear_leveling.h"
+#endif
 #if defined(CRC_ENABLE)
 #    include "crc.h"
 #endif
@@ -140,6 +148,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef OS_DETECTION_ENABLE
 #    include "os_detection.h"
 #endif
+#if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_ASYNC_ENABLE)
+#    include "send_string.h"
+#endif
+#ifdef REPORT_SCHEDULER_ENABLE
+#    include "action_util.h"
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -520,6 +534,20 @@ static inline void generate_tick_event(void) {
     }
 }
 
+/** \brief matrix_get_changed_rows
+ *
+ * Fallback for matrix implementations that do not report changed rows, matrix_task diffs every row instead.
+ */
+__attribute__((weak)) const uint32_t *matrix_get_changed_rows(void) {
+    return NULL;
+}
+
+__attribute__((weak)) void matrix_clear_changed_rows(void) {}
+
+__attribute__((weak)) void matrix_mark_row_changed(uint8_t row) {}
+
+__attribute__((weak)) void debounce_row_changed(matrix_row_t cooked[], uint8_t row) {}
+
 /**
  * @brief This task scans the keyboards matrix and processes any key presses
  * that occur.
@@ -534,11 +562,40 @@ static bool matrix_task(void) {
     }
 
     static matrix_row_t matrix_previous[MATRIX_ROWS];
+    // rows held back by ghosting, which are revisited until they resolve
+    static uint32_t ghost_rows[MATRIX_ROW_BITMAP_WORDS];
 
     matrix_scan();
-    bool matrix_changed = false;
-    for (uint8_t row = 0; row < MATRIX_ROWS && !matrix_changed; row++) {
-        matrix_changed |= matrix_previous[row] ^ matrix_get_row(row);
+
+    uint32_t        changed_rows[MATRIX_ROW_BITMAP_WORDS];
+    const uint32_t *reported_rows     = matrix_get_changed_rows();
+    bool            matrix_changed    = false;
+    uint8_t         first_changed_row = MATRIX_ROWS;
+    if (!reported_rows) {
+        // Rows are only compared up to the first change, every row from it on is walked below and skipped there if
+        // unchanged
+        for (uint8_t row = 0; row < MATRIX_ROWS && !matrix_changed; row++) {
+            if (matrix_previous[row] ^ matrix_get_row(row)) {
+                first_changed_row = row;
+                matrix_changed    = true;
+            }
+        }
+    }
+    for (uint8_t word = 0; word < MATRIX_ROW_BITMAP_WORDS; word++) {
+        changed_rows[word] = ghost_rows[word];
+        if (reported_rows) {
+            changed_rows[word] |= reported_rows[word];
+        } else if (first_changed_row < (word + 1) * 32) {
+            uint32_t rows = first_changed_row > word * 32 ? UINT32_MAX << (first_changed_row % 32) : UINT32_MAX;
+            if (MATRIX_ROWS < (word + 1) * 32) {
+                rows &= ((uint32_t)1 << (MATRIX_ROWS % 32)) - 1;
+            }
+            changed_rows[word] |= rows;
+        }
+        matrix_changed |= changed_rows[word] != 0;
+    }
+    if (reported_rows) {
+        matrix_clear_changed_rows();
     }
 
     matrix_scan_perf_task();
@@ -555,18 +612,24 @@ static bool matrix_task(void) {
 
     const bool process_keypress = should_process_keypress();
 
-    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
-        const matrix_row_t current_row = matrix_get_row(row);
-        const matrix_row_t row_changes = current_row ^ matrix_previous[row];
+    for (uint8_t word = 0; word < MATRIX_ROW_BITMAP_WORDS; word++) {
+        ghost_rows[word] = 0;
+        for (uint32_t rows = changed_rows[word]; rows; rows &= rows - 1) {
+            const uint8_t      row         = word * 32 + __builtin_ctzl(rows);
+            const matrix_row_t current_row = matrix_get_row(row);
+            const matrix_row_t row_changes = current_row ^ matrix_previous[row];
 
-        if (!row_changes || has_ghost_in_row(row, current_row)) {
-            continue;
-        }
+            if (!row_changes) {
+                continue;
+            }
+            if (has_ghost_in_row(row, current_row)) {
+                ghost_rows[word] |= (uint32_t)1 << (row % 32);
+                continue;
+            }
 
-        matrix_row_t col_mask = 1;
-        for (uint8_t col = 0; col < MATRIX_COLS; col++, col_mask <<= 1) {
-            if (row_changes & col_mask) {
-                const bool key_pressed = current_row & col_mask;
+            for (matrix_row_t cols = row_changes; cols; cols &= cols - 1) {
+                const uint8_t col         = __builtin_ctzl(cols);
+                const bool    key_pressed = current_row & (MATRIX_ROW_SHIFTER << col);
 
                 if (process_keypress) {
                     action_exec(MAKE_KEYEVENT(row, col, key_pressed));
@@ -574,9 +637,9 @@ static bool matrix_task(void) {
 
                 switch_events(row, col, key_pressed);
             }
-        }
 
-        matrix_previous[row] = current_row;
+            matrix_previous[row] = current_row;
+        }
     }
 
     return matrix_changed;
@@ -613,97 +676,101 @@ void quantum_task(void) {
 #endif
 
 #if defined(AUDIO_ENABLE) && !defined(NO_MUSIC_MODE)
-    music_task();
+    PROFILE_TASK(music_task);
 #endif
 
 #ifdef KEY_OVERRIDE_ENABLE
-    key_override_task();
+    PROFILE_TASK(key_override_task);
 #endif
 
 #ifdef SEQUENCER_ENABLE
-    sequencer_task();
+    PROFILE_TASK(sequencer_task);
 #endif
 
 #ifdef TAP_DANCE_ENABLE
-    tap_dance_task();
+    PROFILE_TASK(tap_dance_task);
 #endif
 
 #ifdef COMBO_ENABLE
-    combo_task();
+    PROFILE_TASK(combo_task);
 #endif
 
 #ifdef LEADER_ENABLE
-    leader_task();
+    PROFILE_TASK(leader_task);
 #endif
 
 #ifdef WPM_ENABLE
-    decay_wpm();
+    PROFILE_TASK(decay_wpm);
 #endif
 
 #ifdef DIP_SWITCH_ENABLE
-    dip_switch_task();
+    PROFILE_TASK(dip_switch_task);
 #endif
 
 #ifdef AUTO_SHIFT_ENABLE
-    autoshift_matrix_scan();
+    PROFILE_TASK(autoshift_matrix_scan);
 #endif
 
 #ifdef CAPS_WORD_ENABLE
-    caps_word_task();
+    PROFILE_TASK(caps_word_task);
 #endif
 
 #ifdef SECURE_ENABLE
-    secure_task();
+    PROFILE_TASK(secure_task);
 #endif
 }
 
 /** \brief Main task that is repeatedly called as fast as possible. */
 void keyboard_task(void) {
     __attribute__((unused)) bool activity_has_occurred = false;
-    if (matrix_task()) {
+    if (PROFILE_TASK_RESULT(matrix_task)) {
         last_matrix_activity_trigger();
         activity_has_occurred = true;
     }
 
-    quantum_task();
+    PROFILE_TASK(quantum_task);
+
+#if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_ASYNC_ENABLE)
+    PROFILE_TASK(send_string_async_task);
+#endif
 
 #if defined(SPLIT_WATCHDOG_ENABLE)
-    split_watchdog_task();
+    PROFILE_TASK(split_watchdog_task);
 #endif
 
 #if defined(RGBLIGHT_ENABLE)
-    rgblight_task();
+    PROFILE_TASK(rgblight_task);
 #endif
 
 #ifdef LED_MATRIX_ENABLE
-    led_matrix_task();
+    PROFILE_TASK(led_matrix_task);
 #endif
 #ifdef RGB_MATRIX_ENABLE
-    rgb_matrix_task();
+    PROFILE_TASK(rgb_matrix_task);
 #endif
 
 #if defined(BACKLIGHT_ENABLE)
 #    if defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)
-    backlight_task();
+    PROFILE_TASK(backlight_task);
 #    endif
 #endif
 
 #ifdef ENCODER_ENABLE
-    if (encoder_task()) {
+    if (PROFILE_TASK_RESULT(encoder_task)) {
         last_encoder_activity_trigger();
         activity_has_occurred = true;
     }
 #endif
 
 #ifdef POINTING_DEVICE_ENABLE
-    if (pointing_device_task()) {
+    if (PROFILE_TASK_RESULT(pointing_device_task)) {
         last_pointing_device_activity_trigger();
         activity_has_occurred = true;
     }
 #endif
 
 #ifdef OLED_ENABLE
-    oled_task();
+    PROFILE_TASK(oled_task);
 #    if OLED_TIMEOUT > 0
     // Wake up oled if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) oled_on();
@@ -711,7 +778,7 @@ void keyboard_task(void) {
 #endif
 
 #ifdef ST7565_ENABLE
-    st7565_task();
+    PROFILE_TASK(st7565_task);
 #    if ST7565_TIMEOUT > 0
     // Wake up display if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) st7565_on();
@@ -720,32 +787,48 @@ void keyboard_task(void) {
 
 #ifdef MOUSEKEY_ENABLE
     // mousekey repeat & acceleration
-    mousekey_task();
+    PROFILE_TASK(mousekey_task);
 #endif
 
 #ifdef PS2_MOUSE_ENABLE
-    ps2_mouse_task();
+    PROFILE_TASK(ps2_mouse_task);
 #endif
 
 #ifdef MIDI_ENABLE
-    midi_task();
+    PROFILE_TASK(midi_task);
 #endif
 
 #ifdef JOYSTICK_ENABLE
-    joystick_task();
+    PROFILE_TASK(joystick_task);
 #endif
 
 #ifdef BLUETOOTH_ENABLE
-    bluetooth_task();
+    PROFILE_TASK(bluetooth_task);
 #endif
 
 #ifdef HAPTIC_ENABLE
-    haptic_task();
+    PROFILE_TASK(haptic_task);
 #endif
 
-    led_task();
+    PROFILE_TASK(led_task);
 
 #ifdef OS_DETECTION_ENABLE
-    os_detection_task();
+    PROFILE_TASK(os_detection_task);
+#endif
+
+#if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_MIRROR)
+    PROFILE_TASK(dynamic_keymap_task);
+#endif
+
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_INCREMENTAL_CONSOLIDATION)
+    PROFILE_TASK(wear_leveling_task);
+#endif
+
+#ifdef REPORT_SCHEDULER_ENABLE
+    PROFILE_TASK(report_scheduler_task);
+#endif
+
+#ifdef PROFILER_ENABLE
+    profiler_task();
 #endif
 }
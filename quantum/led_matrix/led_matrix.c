@@ -211,6 +211,32 @@ static bool led_matrix_none(effect_params_t *params) {
     return false;
 }
 
+typedef bool (*led_matrix_effect_f)(effect_params_t *params);
+
+// Effects indexed by mode, each rendering part of a frame and returning whether there is more to render
+static led_matrix_effect_f const led_matrix_effects[LED_MATRIX_EFFECT_MAX] PROGMEM = {
+    [LED_MATRIX_NONE] = led_matrix_none,
+
+// ---------------------------------------------
+// -----Begin led effect table macros-----------
+#define LED_MATRIX_EFFECT(name, ...) [LED_MATRIX_##name] = name,
+#include "led_matrix_effects.inc"
+#undef LED_MATRIX_EFFECT
+
+#if defined(LED_MATRIX_CUSTOM_KB) || defined(LED_MATRIX_CUSTOM_USER)
+#    define LED_MATRIX_EFFECT(name, ...) [LED_MATRIX_CUSTOM_##name] = name,
+#    ifdef LED_MATRIX_CUSTOM_KB
+#        include "led_matrix_kb.inc"
+#    endif
+#    ifdef LED_MATRIX_CUSTOM_USER
+#        include "led_matrix_user.inc"
+#    endif
+#    undef LED_MATRIX_EFFECT
+#endif
+    // -----End led effect table macros-------------
+    // ---------------------------------------------
+};
+
 static void led_task_timers(void) {
 #if defined(LED_MATRIX_KEYREACTIVE_ENABLED)
     uint32_t deltaTime = sync_timer_elapsed32(led_timer_buffer);
@@ -260,35 +286,9 @@ static void led_task_render(uint8_t effect) {
 
     // each effect can opt to do calculations
     // and/or request PWM buffer updates.
-    switch (effect) {
-        case LED_MATRIX_NONE:
-            rendering = led_matrix_none(&led_effect_params);
-            break;
-
-// ---------------------------------------------
-// -----Begin led effect switch case macros-----
-#define LED_MATRIX_EFFECT(name, ...)          \
-    case LED_MATRIX_##name:                   \
-        rendering = name(&led_effect_params); \
-        break;
-#include "led_matrix_effects.inc"
-#undef LED_MATRIX_EFFECT
-
-#if defined(LED_MATRIX_CUSTOM_KB) || defined(LED_MATRIX_CUSTOM_USER)
-#    define LED_MATRIX_EFFECT(name, ...)          \
-        case LED_MATRIX_CUSTOM_##name:            \
-            rendering = name(&led_effect_params); \
-            break;
-#    ifdef LED_MATRIX_CUSTOM_KB
-#        include "led_matrix_kb.inc"
-#    endif
-#    ifdef LED_MATRIX_CUSTOM_USER
-#        include "led_matrix_user.inc"
-#    endif
-#    undef LED_MATRIX_EFFECT
-#endif
-            // -----End led effect switch case macros-------
-            // ---------------------------------------------
+    if (effect < LED_MATRIX_EFFECT_MAX) {
+        led_matrix_effect_f render = (led_matrix_effect_f)pgm_read_ptr(&led_matrix_effects[effect]);
+        rendering                  = render(&led_effect_params);
     }
 
     led_effect_params.iter++;
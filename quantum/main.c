@@ -15,6 +15,7 @@
  */
 
 #include "keyboard.h"
+#include "profiler.h"
 
 void platform_setup(void);
 
@@ -27,7 +28,7 @@ void protocol_post_task(void);
 // Bodge as refactoring this area sucks....
 void protocol_keyboard_task(void) __attribute__((weak));
 void protocol_keyboard_task(void) {
-    keyboard_task();
+    PROFILE_TASK(keyboard_task);
 }
 
 /** \brief Main
@@ -63,15 +64,15 @@ int main(void) {
 #ifdef QUANTUM_PAINTER_ENABLE
         // Run Quantum Painter task
         void qp_internal_task(void);
-        qp_internal_task();
+        PROFILE_TASK(qp_internal_task);
 #endif
 
 #ifdef DEFERRED_EXEC_ENABLE
         // Run deferred executions
         void deferred_exec_task(void);
-        deferred_exec_task();
+        PROFILE_TASK(deferred_exec_task);
 #endif // DEFERRED_EXEC_ENABLE
 
-        housekeeping_task();
+        PROFILE_TASK(housekeeping_task);
     }
 }
@@ -345,5 +345,7 @@ uint8_t matrix_scan(void) {
     changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
     matrix_scan_kb();
 #endif
+
+    matrix_track_changed_rows();
     return (uint8_t)changed;
 }
@@ -37,6 +37,9 @@ typedef uint32_t matrix_row_t;
 
 #define MATRIX_ROW_SHIFTER ((matrix_row_t)1)
 
+/* number of 32-bit words in a bitmap holding one bit per row */
+#define MATRIX_ROW_BITMAP_WORDS ((MATRIX_ROWS + 31) / 32)
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -57,6 +60,14 @@ bool matrix_can_read(void);
 bool matrix_is_on(uint8_t row, uint8_t col);
 /* matrix state on row */
 matrix_row_t matrix_get_row(uint8_t row);
+/* bitmap of rows changed since they were last cleared, or NULL when the matrix implementation does not report it */
+const uint32_t *matrix_get_changed_rows(void);
+/* clear the changed rows bitmap once its rows have been processed */
+void matrix_clear_changed_rows(void);
+/* mark a row as changed, for code that writes to the matrix outside of debounce, such as matrix_scan_kb() */
+void matrix_mark_row_changed(uint8_t row);
+/* called by matrix_scan() implementations which mark every row they change, so that the bitmap is used */
+void matrix_track_changed_rows(void);
 /* print matrix for debug */
 void matrix_print(void);
 /* delay between changing matrix pin state and reading values */
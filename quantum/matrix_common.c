@@ -4,10 +4,11 @@
 #include "print.h"
 #include "debug.h"
 
+#include <string.h>
+
 #ifdef SPLIT_KEYBOARD
 #    include "split_common/split_util.h"
 #    include "split_common/transactions.h"
-#    include <string.h>
 
 #    define ROWS_PER_HAND (MATRIX_ROWS / 2)
 #else
@@ -22,6 +23,10 @@
 matrix_row_t raw_matrix[MATRIX_ROWS];
 matrix_row_t matrix[MATRIX_ROWS];
 
+// rows written since matrix_task() last consumed them, marked by debounce and the split transport as they write them
+static uint32_t matrix_changed_rows[MATRIX_ROW_BITMAP_WORDS];
+static bool     matrix_changed_rows_valid = false;
+
 #ifdef SPLIT_KEYBOARD
 // row offsets for each hand
 uint8_t thisHand, thatHand;
@@ -69,6 +74,27 @@ inline matrix_row_t matrix_get_row(uint8_t row) {
 #endif
 }
 
+const uint32_t *matrix_get_changed_rows(void) {
+    return matrix_changed_rows_valid ? matrix_changed_rows : NULL;
+}
+
+void matrix_clear_changed_rows(void) {
+    memset(matrix_changed_rows, 0, sizeof(matrix_changed_rows));
+}
+
+void matrix_mark_row_changed(uint8_t row) {
+    matrix_changed_rows[row / 32] |= (uint32_t)1 << (row % 32);
+}
+
+void matrix_track_changed_rows(void) {
+    matrix_changed_rows_valid = true;
+}
+
+// Debounce is only ever handed rows of matrix here, so the row it changed is found from where cooked points to
+void debounce_row_changed(matrix_row_t cooked[], uint8_t row) {
+    matrix_mark_row_changed((uint8_t)(cooked - matrix) + row);
+}
+
 #if (MATRIX_COLS <= 8)
 #    define print_matrix_header() print("\nr/c 01234567\n")
 #    define print_matrix_row(row) print_bin_reverse8(matrix_get_row(row))
@@ -92,28 +118,47 @@ void matrix_print(void) {
 }
 
 #ifdef SPLIT_KEYBOARD
+// Copies the other half's rows into the matrix, marking the ones which changed
+static bool matrix_copy_rows(matrix_row_t *dest, const matrix_row_t *src, uint8_t first_row) {
+    bool changed = false;
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        if (dest[row] != src[row]) {
+            dest[row] = src[row];
+            matrix_mark_row_changed(first_row + row);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
 bool matrix_post_scan(void) {
     bool changed = false;
     if (is_keyboard_master()) {
         static bool  last_connected              = false;
         matrix_row_t slave_matrix[ROWS_PER_HAND] = {0};
+        bool         update                      = false;
         if (transport_master_if_connected(matrix + thisHand, slave_matrix)) {
-            changed = memcmp(matrix + thatHand, slave_matrix, sizeof(slave_matrix)) != 0;
+            update = true;
 
             last_connected = true;
         } else if (last_connected) {
             // reset other half when disconnected
             memset(slave_matrix, 0, sizeof(slave_matrix));
-            changed = true;
+            update = true;
 
             last_connected = false;
         }
 
-        if (changed) memcpy(matrix + thatHand, slave_matrix, sizeof(slave_matrix));
+        if (update) {
+            changed = matrix_copy_rows(matrix + thatHand, slave_matrix, thatHand);
+        }
 
         matrix_scan_kb();
     } else {
-        transport_slave(matrix + thatHand, matrix + thisHand);
+        matrix_row_t master_matrix[ROWS_PER_HAND];
+        memcpy(master_matrix, matrix + thatHand, sizeof(master_matrix));
+        transport_slave(master_matrix, matrix + thisHand);
+        matrix_copy_rows(matrix + thatHand, master_matrix, thatHand);
 
         matrix_slave_scan_kb();
     }
@@ -175,6 +220,7 @@ __attribute__((weak)) uint8_t matrix_scan(void) {
     matrix_scan_kb();
 #endif
 
+    matrix_track_changed_rows();
     return changed;
 }
 
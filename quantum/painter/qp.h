@@ -56,6 +56,22 @@
 #    define QUANTUM_PAINTER_LOAD_FONTS_TO_RAM FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_SIZE
+/**
+ * @def This controls the amount of RAM (in bytes) used to cache decoded glyphs in the display's native pixel format,
+ *      keyed by font, code point and colors. Cached glyphs are sent straight to the display instead of being decoded
+ *      again, which benefits text that is redrawn frequently. Set to 0 to disable the cache.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_SIZE 0
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE
+
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES
+/**
+ * @def This controls the maximum number of glyphs held in the glyph cache, regardless of their size.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES 32
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES
+
 #ifndef QUANTUM_PAINTER_CONCURRENT_ANIMATIONS
 /**
  * @def This controls the maximum number of animations that Quantum Painter can play simultaneously. Increasing this
@@ -72,6 +88,16 @@
 #    define QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE 1024
 #endif
 
+#ifndef QUANTUM_PAINTER_ASYNC_COMMS
+/**
+ * @def This controls whether pixel data transfers are pipelined, on comms drivers which support it. Each transmission
+ *      is copied into one of two additional QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE buffers, so that the next block of pixel
+ *      data can be prepared while the previous one is still being sent. Draw calls still return only once their last
+ *      block has been sent, so this shortens drawing but does not make it run in the background.
+ */
+#    define QUANTUM_PAINTER_ASYNC_COMMS FALSE
+#endif
+
 #ifndef QUANTUM_PAINTER_SUPPORTS_256_PALETTE
 /**
  * @def This controls whether 256-color palettes are supported. This has relatively hefty requirements on RAM -- at
@@ -488,6 +514,33 @@ int16_t qp_drawtext(painter_device_t device, uint16_t x, uint16_t y, painter_fon
  */
 int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, painter_font_handle_t font, const char *str, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg);
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
+/**
+ * @typedef Glyph cache statistics, as returned by \ref qp_glyph_cache_get_stats.
+ */
+typedef struct painter_glyph_cache_stats_t {
+    uint32_t hits;       // glyphs drawn from the cache
+    uint32_t misses;     // glyphs decoded from the font
+    uint32_t evictions;  // cached glyphs dropped to make room for others
+    uint16_t entries;    // glyphs currently cached
+    uint32_t bytes_used; // RAM used by the currently cached glyphs
+} painter_glyph_cache_stats_t;
+
+/**
+ * Retrieves the glyph cache statistics.
+ *
+ * @param stats[out] the statistics since the last call to \ref qp_glyph_cache_clear
+ */
+void qp_glyph_cache_get_stats(painter_glyph_cache_stats_t *stats);
+
+/**
+ * Drops every cached glyph and resets the glyph cache statistics.
+ */
+void qp_glyph_cache_clear(void);
+
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter Drivers
 
@@ -1,8 +1,73 @@
 // Copyright 2021 Nick Brassel (@tzarc)
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <string.h>
 #include "qp_comms.h"
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Asynchronous transfers
+
+#if QUANTUM_PAINTER_ASYNC_COMMS
+
+// Transmissions are copied into alternating buffers, so that the caller can reuse its own buffer straight away.
+static __attribute__((__aligned__(4))) uint8_t async_buffers[2][QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+static uint8_t                                 async_next_buffer = 0;
+
+// The device with a transfer in flight, if any. Only one transfer is ever in flight, as the buffer it was sent from
+// is the only one which cannot be overwritten.
+static volatile painter_device_t async_device = NULL;
+
+void qp_comms_async_complete(painter_device_t device) {
+    if (async_device == device) {
+        async_device = NULL;
+    }
+}
+
+void qp_comms_wait(painter_device_t device) {
+    painter_device_t in_flight = async_device;
+    if (in_flight) {
+        painter_driver_t *driver = (painter_driver_t *)in_flight;
+        driver->comms_vtable->comms_wait(in_flight);
+        async_device = NULL;
+    }
+}
+
+static uint32_t qp_comms_send_async(painter_device_t device, const void *data, uint32_t byte_count) {
+    painter_driver_t *driver          = (painter_driver_t *)device;
+    uint32_t          bytes_remaining = byte_count;
+    const uint8_t    *p               = (const uint8_t *)data;
+
+    while (bytes_remaining > 0) {
+        uint32_t bytes_this_loop = QP_MIN(bytes_remaining, QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE);
+
+        // Fill the idle buffer while the other one may still be in flight, then wait for the bus to become free
+        uint8_t *buffer = async_buffers[async_next_buffer];
+        memcpy(buffer, p, bytes_this_loop);
+        qp_comms_wait(device);
+
+        async_device = device;
+        if (!driver->comms_vtable->comms_send_async(device, buffer, bytes_this_loop)) {
+            qp_dprintf("qp_comms_send: fail (async transfer could not be started)\n");
+            async_device = NULL;
+            break;
+        }
+
+        async_next_buffer ^= 1;
+        p += bytes_this_loop;
+        bytes_remaining -= bytes_this_loop;
+    }
+
+    return byte_count - bytes_remaining;
+}
+
+#else // QUANTUM_PAINTER_ASYNC_COMMS
+
+void qp_comms_async_complete(painter_device_t device) {}
+
+void qp_comms_wait(painter_device_t device) {}
+
+#endif // QUANTUM_PAINTER_ASYNC_COMMS
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Base comms APIs
 
@@ -33,6 +98,8 @@ void qp_comms_stop(painter_device_t device) {
         return;
     }
 
+    // The last transfer is left to finish in the background, so that drawing does not block until it is out on the bus.
+    // The comms driver releases the bus once it has finished, and the next draw waits on it if still in flight.
     driver->comms_vtable->comms_stop(device);
 }
 
@@ -43,6 +110,12 @@ uint32_t qp_comms_send(painter_device_t device, const void *data, uint32_t byte_
         return false;
     }
 
+#if QUANTUM_PAINTER_ASYNC_COMMS
+    if (driver->comms_vtable->comms_send_async && driver->comms_vtable->comms_wait) {
+        return qp_comms_send_async(device, data, byte_count);
+    }
+#endif // QUANTUM_PAINTER_ASYNC_COMMS
+
     return driver->comms_vtable->comms_send(device, data, byte_count);
 }
 
@@ -52,6 +125,7 @@ uint32_t qp_comms_send(painter_device_t device, const void *data, uint32_t byte_
 void qp_comms_command(painter_device_t device, uint8_t cmd) {
     painter_driver_t *                   driver       = (painter_driver_t *)device;
     painter_comms_with_command_vtable_t *comms_vtable = (painter_comms_with_command_vtable_t *)driver->comms_vtable;
+    qp_comms_wait(device);
     comms_vtable->send_command(device, cmd);
 }
 
@@ -68,5 +142,6 @@ uint32_t qp_comms_command_databuf(painter_device_t device, uint8_t cmd, const vo
 void qp_comms_bulk_command_sequence(painter_device_t device, const uint8_t *sequence, size_t sequence_len) {
     painter_driver_t *                   driver       = (painter_driver_t *)device;
     painter_comms_with_command_vtable_t *comms_vtable = (painter_comms_with_command_vtable_t *)driver->comms_vtable;
+    qp_comms_wait(device);
     comms_vtable->bulk_command_sequence(device, sequence, sequence_len);
 }
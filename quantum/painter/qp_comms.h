@@ -16,6 +16,15 @@ bool     qp_comms_start(painter_device_t device);
 void     qp_comms_stop(painter_device_t device);
 uint32_t qp_comms_send(painter_device_t device, const void* data, uint32_t byte_count);
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Asynchronous transfer APIs, no-ops unless QUANTUM_PAINTER_ASYNC_COMMS is enabled
+
+// Blocks until any transfer in flight has finished. Called before anything else is sent, and before comms are stopped.
+void qp_comms_wait(painter_device_t device);
+
+// Invoked by comms drivers once a transfer started by comms_send_async has finished, potentially from an interrupt.
+void qp_comms_async_complete(painter_device_t device);
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Comms APIs that use a D/C pin
 
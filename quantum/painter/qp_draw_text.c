@@ -36,6 +36,126 @@ typedef struct qff_font_handle_t {
 
 static qff_font_handle_t font_descriptors[QUANTUM_PAINTER_NUM_FONTS] = {0};
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Glyph cache
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
+typedef struct glyph_cache_entry_t {
+    painter_device_t   device; // pixel data is in the native format of the device the glyph was drawn on
+    qff_font_handle_t *font;   // NULL if the entry is unused
+    uint32_t           code_point;
+    uint32_t           fg_hsv888;
+    uint32_t           bg_hsv888;
+    uint32_t           offset; // location of the pixel data within the arena
+    uint32_t           length;
+    uint8_t            width;
+} glyph_cache_entry_t;
+
+static __attribute__((__aligned__(4))) uint8_t glyph_cache_arena[QUANTUM_PAINTER_GLYPH_CACHE_SIZE];
+static glyph_cache_entry_t                     glyph_cache[QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES];
+static painter_glyph_cache_stats_t             glyph_cache_stats;
+
+// Both the arena and the entries are allocated in a circular fashion, so the oldest glyphs are evicted first
+static uint32_t glyph_cache_head       = 0;
+static uint16_t glyph_cache_next_entry = 0;
+
+static inline uint32_t glyph_cache_color_key(qp_pixel_t color) {
+    return ((uint32_t)color.hsv888.h << 16) | ((uint32_t)color.hsv888.s << 8) | color.hsv888.v;
+}
+
+static void glyph_cache_drop(glyph_cache_entry_t *entry) {
+    if (entry->font) {
+        entry->font = NULL;
+        glyph_cache_stats.entries--;
+        glyph_cache_stats.bytes_used -= entry->length;
+    }
+}
+
+static void glyph_cache_evict(glyph_cache_entry_t *entry) {
+    if (entry->font) {
+        glyph_cache_drop(entry);
+        glyph_cache_stats.evictions++;
+    }
+}
+
+static void glyph_cache_drop_font(qff_font_handle_t *font) {
+    for (uint16_t i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        if (glyph_cache[i].font == font) {
+            glyph_cache_drop(&glyph_cache[i]);
+        }
+    }
+}
+
+static glyph_cache_entry_t *glyph_cache_find(painter_device_t device, qff_font_handle_t *font, uint32_t code_point, uint32_t fg_hsv888, uint32_t bg_hsv888) {
+    for (uint16_t i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        glyph_cache_entry_t *entry = &glyph_cache[i];
+        if (entry->font == font && entry->code_point == code_point && entry->device == device && entry->fg_hsv888 == fg_hsv888 && entry->bg_hsv888 == bg_hsv888) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static glyph_cache_entry_t *glyph_cache_find_any(qff_font_handle_t *font, uint32_t code_point) {
+    for (uint16_t i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        glyph_cache_entry_t *entry = &glyph_cache[i];
+        if (entry->font == font && entry->code_point == code_point) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void glyph_cache_insert(painter_device_t device, qff_font_handle_t *font, uint32_t code_point, uint32_t fg_hsv888, uint32_t bg_hsv888, uint8_t width, const void *pixdata, uint32_t length) {
+    // Keep allocations aligned, as drivers may access the pixel data in words
+    uint32_t aligned_length = (length + 3) & ~3u;
+    if (aligned_length > sizeof(glyph_cache_arena)) {
+        return;
+    }
+    if (glyph_cache_head + aligned_length > sizeof(glyph_cache_arena)) {
+        glyph_cache_head = 0;
+    }
+
+    // Evict whichever glyphs overlap the new allocation, as well as the one occupying the entry about to be reused
+    for (uint16_t i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        glyph_cache_entry_t *entry = &glyph_cache[i];
+        if (entry->font && entry->offset < glyph_cache_head + aligned_length && glyph_cache_head < entry->offset + entry->length) {
+            glyph_cache_evict(entry);
+        }
+    }
+    glyph_cache_entry_t *entry = &glyph_cache[glyph_cache_next_entry];
+    glyph_cache_evict(entry);
+    glyph_cache_next_entry = (glyph_cache_next_entry + 1) % QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES;
+
+    entry->device     = device;
+    entry->font       = font;
+    entry->code_point = code_point;
+    entry->fg_hsv888  = fg_hsv888;
+    entry->bg_hsv888  = bg_hsv888;
+    entry->offset     = glyph_cache_head;
+    entry->length     = length;
+    entry->width      = width;
+    memcpy(&glyph_cache_arena[entry->offset], pixdata, length);
+
+    glyph_cache_head += aligned_length;
+    glyph_cache_stats.entries++;
+    glyph_cache_stats.bytes_used += length;
+}
+
+void qp_glyph_cache_get_stats(painter_glyph_cache_stats_t *stats) {
+    *stats = glyph_cache_stats;
+}
+
+void qp_glyph_cache_clear(void) {
+    memset(glyph_cache, 0, sizeof(glyph_cache));
+    memset(&glyph_cache_stats, 0, sizeof(glyph_cache_stats));
+    glyph_cache_head       = 0;
+    glyph_cache_next_entry = 0;
+}
+
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helper: load font from stream
 
@@ -151,6 +271,11 @@ bool qp_close_font(painter_font_handle_t font) {
     }
 #endif // QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    // The font slot may be reused by another font, so its glyphs can no longer be served from the cache
+    glyph_cache_drop_font(qff_font);
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
     // Free up this font for use elsewhere.
     qp_stream_close(&qff_font->stream);
     qff_font->validate_ok = false;
@@ -163,6 +288,9 @@ bool qp_close_font(painter_font_handle_t font) {
 // Callback to be invoked for each codepoint detected in the UTF8 input string
 typedef bool (*code_point_handler)(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg);
 
+// Optional callback invoked before the glyph is looked up in the font, setting `handled` if it was served from the glyph cache
+typedef bool (*code_point_cache_handler)(qff_font_handle_t *qff_font, uint32_t code_point, bool *handled, void *cb_arg);
+
 // Helper that sets up the palette (if required) and returns the offset in the stream that the data starts
 static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device, qff_font_handle_t *qff_font, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, uint32_t *data_offset) {
     painter_driver_t *driver = (painter_driver_t *)device;
@@ -293,7 +421,7 @@ static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_f
 }
 
 // Function to iterate over each UTF8 codepoint, invoking the callback for each decoded glyph
-static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const char *str, code_point_handler handler, void *cb_arg) {
+static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const char *str, code_point_cache_handler cache_handler, code_point_handler handler, void *cb_arg) {
     while (*str) {
         int32_t code_point = 0;
         str                = decode_utf8(str, &code_point);
@@ -302,6 +430,17 @@ static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const cha
             return false;
         }
 
+        if (cache_handler) {
+            bool handled = false;
+            if (!cache_handler(qff_font, code_point, &handled, cb_arg)) {
+                qp_dprintf("Failed to execute glyph cache handler.\n");
+                return false;
+            }
+            if (handled) {
+                continue;
+            }
+        }
+
         uint8_t width;
         if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
             qp_dprintf("Failed to prepare glyph for rendering.\n");
@@ -334,6 +473,21 @@ static inline bool qp_font_code_point_handler_calcwidth(qff_font_handle_t *qff_f
     return true;
 }
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+// Codepoint cache handler callback: width calc, using any cached copy of the glyph
+static inline bool qp_font_code_point_cache_handler_calcwidth(qff_font_handle_t *qff_font, uint32_t code_point, bool *handled, void *cb_arg) {
+    code_point_iter_calcwidth_state_t *state = (code_point_iter_calcwidth_state_t *)cb_arg;
+    glyph_cache_entry_t               *entry = glyph_cache_find_any(qff_font, code_point);
+    if (entry) {
+        state->width += entry->width;
+        *handled = true;
+    }
+    return true;
+}
+#else  // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+#    define qp_font_code_point_cache_handler_calcwidth NULL
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // String drawing implementation
 
@@ -345,6 +499,10 @@ typedef struct code_point_iter_drawglyph_state_t {
     qp_internal_byte_input_callback   input_callback;
     qp_internal_byte_input_state_t *  input_state;
     qp_internal_pixel_output_state_t *output_state;
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    uint32_t fg_hsv888;
+    uint32_t bg_hsv888;
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
 } code_point_iter_drawglyph_state_t;
 
 // Codepoint handler callback: drawing
@@ -366,8 +524,48 @@ static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_f
 
     // Decode the pixel data for the glyph, and stream it
     uint32_t pixel_count = ((uint32_t)width) * height;
-    return qp_internal_appender(state->device, qff_font->bpp, pixel_count, state->input_callback, state->input_state);
+    if (!qp_internal_appender(state->device, qff_font->bpp, pixel_count, state->input_callback, state->input_state)) {
+        return false;
+    }
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    // Glyphs which fit within the pixdata buffer were sent in one go, so the buffer still holds all of their native pixels
+    glyph_cache_stats.misses++;
+    if (pixel_count <= qp_internal_num_pixels_in_buffer(state->device)) {
+        uint32_t byte_count = (pixel_count * driver->native_bits_per_pixel + 7) / 8;
+        glyph_cache_insert(state->device, qff_font, code_point, state->fg_hsv888, state->bg_hsv888, width, qp_internal_global_pixdata_buffer, byte_count);
+    }
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
+    return true;
+}
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+// Codepoint cache handler callback: drawing pre-decoded pixels
+static inline bool qp_font_code_point_cache_handler_drawglyph(qff_font_handle_t *qff_font, uint32_t code_point, bool *handled, void *cb_arg) {
+    code_point_iter_drawglyph_state_t *state  = (code_point_iter_drawglyph_state_t *)cb_arg;
+    painter_driver_t                  *driver = (painter_driver_t *)state->device;
+    glyph_cache_entry_t               *entry  = glyph_cache_find(state->device, qff_font, code_point, state->fg_hsv888, state->bg_hsv888);
+    if (!entry) {
+        return true;
+    }
+
+    glyph_cache_stats.hits++;
+    *handled = true;
+
+    // Configure where we're going to be rendering to
+    uint8_t width = entry->width;
+    driver->driver_vtable->viewport(state->device, state->xpos, state->ypos, state->xpos + width - 1, state->ypos + qff_font->base.line_height - 1);
+
+    // Move the x-position for the next glyph
+    state->xpos += width;
+
+    // Stream the cached pixel data as-is
+    return driver->driver_vtable->pixdata(state->device, &glyph_cache_arena[entry->offset], ((uint32_t)width) * qff_font->base.line_height);
 }
+#else  // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+#    define qp_font_code_point_cache_handler_drawglyph NULL
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_textwidth
@@ -382,7 +580,7 @@ int16_t qp_textwidth(painter_font_handle_t font, const char *str) {
     // Create the codepoint iterator state
     code_point_iter_calcwidth_state_t state = {.width = 0};
     // Iterate each codepoint, return the calculated width if successful.
-    return qp_iterate_code_points(qff_font, str, qp_font_code_point_handler_calcwidth, &state) ? state.width : 0;
+    return qp_iterate_code_points(qff_font, str, qp_font_code_point_cache_handler_calcwidth, qp_font_code_point_handler_calcwidth, &state) ? state.width : 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -437,7 +635,13 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
                                                .input_callback = input_callback,
                                                .input_state    = &input_state,
                                                // Output
-                                               .output_state = &output_state};
+                                               .output_state = &output_state,
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+                                               // Cache key, palette fonts render the same regardless of colors
+                                               .fg_hsv888 = qff_font->has_palette ? 0 : glyph_cache_color_key((qp_pixel_t){.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}}),
+                                               .bg_hsv888 = qff_font->has_palette ? 0 : glyph_cache_color_key((qp_pixel_t){.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}}),
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+                                               };
 
     qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
     qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
@@ -449,7 +653,7 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
     }
 
     // Iterate the codepoints with the drawglyph callback
-    bool ret = qp_iterate_code_points(qff_font, str, qp_font_code_point_handler_drawglyph, &state);
+    bool ret = qp_iterate_code_points(qff_font, str, qp_font_code_point_cache_handler_drawglyph, qp_font_code_point_handler_drawglyph, &state);
 
     qp_dprintf("qp_drawtext_recolor: %s\n", ret ? "ok" : "fail");
     qp_comms_stop(device);
@@ -20,7 +20,7 @@ enum {
                      + (SH1106_NUM_DEVICES)  // SH1106
 };
 
-static painter_device_t qp_devices[QP_NUM_DEVICES] = {NULL};
+static painter_device_t qp_devices[QP_NUM_DEVICES];
 
 bool qp_internal_register_device(painter_device_t driver) {
     for (uint8_t i = 0; i < QP_NUM_DEVICES; i++) {
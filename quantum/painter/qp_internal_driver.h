@@ -38,12 +38,22 @@ typedef bool (*painter_driver_comms_init_func)(painter_device_t device);
 typedef bool (*painter_driver_comms_start_func)(painter_device_t device);
 typedef void (*painter_driver_comms_stop_func)(painter_device_t device);
 typedef uint32_t (*painter_driver_comms_send_func)(painter_device_t device, const void *data, uint32_t byte_count);
+typedef bool (*painter_driver_comms_send_async_func)(painter_device_t device, const void *data, uint32_t byte_count);
+typedef void (*painter_driver_comms_wait_func)(painter_device_t device);
 
 typedef struct painter_comms_vtable_t {
     painter_driver_comms_init_func  comms_init;
     painter_driver_comms_start_func comms_start;
     painter_driver_comms_stop_func  comms_stop;
     painter_driver_comms_send_func  comms_send;
+
+    // Optional non-blocking transfers, used when QUANTUM_PAINTER_ASYNC_COMMS is enabled. `comms_send_async` starts a
+    // transfer of the supplied buffer and returns immediately; the comms driver must invoke qp_comms_async_complete()
+    // once it has finished. `comms_wait` blocks until the transfer in flight has finished. `comms_stop` may be invoked
+    // while a transfer is still in flight, and must then leave the bus to be released once it has finished, with the
+    // next `comms_start` waiting on it if need be.
+    painter_driver_comms_send_async_func comms_send_async;
+    painter_driver_comms_wait_func       comms_wait;
 } painter_comms_vtable_t;
 
 typedef void (*painter_driver_comms_send_command_func)(painter_device_t device, uint8_t cmd);
@@ -0,0 +1,186 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "qp_comms.h"
+#include "qp_comms_mock.h"
+}
+
+class QpCommsAsync : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        qp_comms_mock_reset();
+        driver.validate_ok  = true;
+        driver.comms_vtable = (const painter_comms_vtable_t *)&mock_comms_vtable;
+    }
+
+    void TearDown() override {
+        qp_comms_stop(device());
+        qp_comms_wait(device());
+    }
+
+    painter_device_t device() {
+        return &driver;
+    }
+
+    static std::vector<uint8_t> pattern(size_t length, uint8_t seed) {
+        std::vector<uint8_t> data(length);
+        for (size_t i = 0; i < length; i++) {
+            data[i] = (uint8_t)(seed + i);
+        }
+        return data;
+    }
+
+    static std::vector<uint8_t> captured() {
+        const uint8_t *capture = qp_comms_mock_capture();
+        return std::vector<uint8_t>(capture, capture + qp_comms_mock_stats()->bytes_captured);
+    }
+
+    painter_driver_t driver = {};
+};
+
+TEST_F(QpCommsAsync, SendReturnsWhileTransferInFlight) {
+    auto data = pattern(32, 0x10);
+
+    EXPECT_EQ(qp_comms_send(device(), data.data(), data.size()), data.size());
+    EXPECT_TRUE(qp_comms_mock_busy());
+    EXPECT_EQ(qp_comms_mock_stats()->bytes_captured, 0);
+
+    EXPECT_TRUE(qp_comms_mock_complete());
+    EXPECT_FALSE(qp_comms_mock_busy());
+    EXPECT_EQ(captured(), data);
+    EXPECT_EQ(qp_comms_mock_stats()->async_transfers, 1);
+    EXPECT_EQ(qp_comms_mock_stats()->sync_transfers, 0);
+}
+
+TEST_F(QpCommsAsync, CallerBufferCanBeReusedImmediately) {
+    auto first  = pattern(QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE, 0x00);
+    auto second = pattern(QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE, 0x80);
+
+    // Refill the same buffer straight after each send, as the drawing routines do with the pixdata buffer
+    std::vector<uint8_t> buffer = first;
+    qp_comms_send(device(), buffer.data(), buffer.size());
+    buffer = second;
+    qp_comms_send(device(), buffer.data(), buffer.size());
+    std::fill(buffer.begin(), buffer.end(), 0xFF);
+    qp_comms_wait(device());
+
+    auto expected = first;
+    expected.insert(expected.end(), second.begin(), second.end());
+    EXPECT_EQ(captured(), expected);
+    EXPECT_EQ(qp_comms_mock_stats()->buffer_modified, 0);
+    EXPECT_EQ(qp_comms_mock_stats()->overlap_errors, 0);
+}
+
+TEST_F(QpCommsAsync, LargeSendsAreChunked) {
+    auto data = pattern(QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE * 3 + 7, 0x42);
+
+    EXPECT_EQ(qp_comms_send(device(), data.data(), data.size()), data.size());
+    qp_comms_wait(device());
+
+    EXPECT_EQ(captured(), data);
+    EXPECT_EQ(qp_comms_mock_stats()->async_transfers, 4);
+    EXPECT_EQ(qp_comms_mock_stats()->buffer_modified, 0);
+    EXPECT_EQ(qp_comms_mock_stats()->overlap_errors, 0);
+}
+
+TEST_F(QpCommsAsync, CompletionBeforeNextSendDoesNotBlock) {
+    auto data = pattern(16, 0x20);
+
+    qp_comms_send(device(), data.data(), data.size());
+    // Emulates the transfer complete interrupt firing while the next block is being prepared
+    qp_comms_mock_complete();
+    qp_comms_send(device(), data.data(), data.size());
+    qp_comms_mock_complete();
+
+    EXPECT_EQ(qp_comms_mock_stats()->async_transfers, 2);
+    EXPECT_EQ(qp_comms_mock_stats()->waits_blocked, 0);
+}
+
+TEST_F(QpCommsAsync, CommandsWaitForPixelData) {
+    auto data = pattern(16, 0x30);
+
+    qp_comms_send(device(), data.data(), data.size());
+    qp_comms_command(device(), 0x2C);
+
+    EXPECT_FALSE(qp_comms_mock_busy());
+    EXPECT_EQ(qp_comms_mock_stats()->commands, 1);
+    EXPECT_EQ(qp_comms_mock_stats()->waits_blocked, 1);
+    EXPECT_EQ(qp_comms_mock_stats()->overlap_errors, 0);
+
+    static const uint8_t sequence[] = {0x01, 0, 0, 0x3A, 0, 1, 0x55};
+    qp_comms_send(device(), data.data(), data.size());
+    qp_comms_bulk_command_sequence(device(), sequence, sizeof(sequence));
+
+    EXPECT_EQ(qp_comms_mock_stats()->commands, 3);
+    EXPECT_EQ(qp_comms_mock_stats()->waits_blocked, 2);
+    EXPECT_EQ(qp_comms_mock_stats()->overlap_errors, 0);
+}
+
+TEST_F(QpCommsAsync, StopLeavesPixelDataInFlight) {
+    auto data = pattern(16, 0x40);
+
+    qp_comms_start(device());
+    qp_comms_send(device(), data.data(), data.size());
+    qp_comms_stop(device());
+
+    EXPECT_TRUE(qp_comms_mock_busy());
+    EXPECT_EQ(qp_comms_mock_stats()->stops_deferred, 1);
+    EXPECT_EQ(qp_comms_mock_stats()->waits_blocked, 0);
+
+    EXPECT_TRUE(qp_comms_mock_complete());
+    EXPECT_EQ(captured(), data);
+    EXPECT_EQ(qp_comms_mock_stats()->overlap_errors, 0);
+}
+
+TEST_F(QpCommsAsync, NextDrawWaitsForPixelData) {
+    auto first  = pattern(16, 0x40);
+    auto second = pattern(16, 0x60);
+
+    qp_comms_start(device());
+    qp_comms_send(device(), first.data(), first.size());
+    qp_comms_stop(device());
+
+    // The previous draw's transfer is still in flight, so starting the next one has to wait on it
+    qp_comms_start(device());
+    EXPECT_FALSE(qp_comms_mock_busy());
+    EXPECT_EQ(qp_comms_mock_stats()->waits_blocked, 1);
+
+    qp_comms_send(device(), second.data(), second.size());
+    qp_comms_stop(device());
+    qp_comms_mock_complete();
+
+    auto expected = first;
+    expected.insert(expected.end(), second.begin(), second.end());
+    EXPECT_EQ(captured(), expected);
+    EXPECT_EQ(qp_comms_mock_stats()->buffer_modified, 0);
+    EXPECT_EQ(qp_comms_mock_stats()->overlap_errors, 0);
+}
+
+TEST_F(QpCommsAsync, NextDrawDoesNotBlockOnceComplete) {
+    auto data = pattern(16, 0x70);
+
+    qp_comms_start(device());
+    qp_comms_send(device(), data.data(), data.size());
+    qp_comms_stop(device());
+    qp_comms_mock_complete();
+
+    qp_comms_start(device());
+    EXPECT_EQ(qp_comms_mock_stats()->waits_blocked, 0);
+}
+
+TEST_F(QpCommsAsync, FallsBackToBlockingSends) {
+    driver.comms_vtable = (const painter_comms_vtable_t *)&mock_comms_sync_vtable;
+    auto data           = pattern(QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE * 2, 0x50);
+
+    EXPECT_EQ(qp_comms_send(device(), data.data(), data.size()), data.size());
+    EXPECT_FALSE(qp_comms_mock_busy());
+
+    EXPECT_EQ(captured(), data);
+    EXPECT_EQ(qp_comms_mock_stats()->sync_transfers, 1);
+    EXPECT_EQ(qp_comms_mock_stats()->async_transfers, 0);
+}
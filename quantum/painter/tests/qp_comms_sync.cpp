@@ -0,0 +1,39 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "qp_comms.h"
+#include "qp_comms_mock.h"
+}
+
+class QpCommsSync : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        qp_comms_mock_reset();
+        driver.validate_ok  = true;
+        driver.comms_vtable = (const painter_comms_vtable_t *)&mock_comms_vtable;
+    }
+
+    painter_device_t device() {
+        return &driver;
+    }
+
+    painter_driver_t driver = {};
+};
+
+TEST_F(QpCommsSync, AsyncCapableBusIsUsedSynchronouslyWhenDisabled) {
+    std::vector<uint8_t> data(QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE * 2, 0xA5);
+
+    EXPECT_EQ(qp_comms_send(device(), data.data(), data.size()), data.size());
+    qp_comms_command(device(), 0x2C);
+
+    EXPECT_FALSE(qp_comms_mock_busy());
+    EXPECT_EQ(qp_comms_mock_stats()->sync_transfers, 1);
+    EXPECT_EQ(qp_comms_mock_stats()->async_transfers, 0);
+    EXPECT_EQ(qp_comms_mock_stats()->bytes_captured, data.size());
+    EXPECT_EQ(qp_comms_mock_stats()->overlap_errors, 0);
+}
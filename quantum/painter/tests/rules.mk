@@ -0,0 +1,31 @@
+qp_comms_common_DEFS := \
+	-DMATRIX_ROWS=1 \
+	-DMATRIX_COLS=1 \
+	-DNO_DEBUG \
+	-DEEPROM_TEST_HARNESS \
+	-DQUANTUM_PAINTER_ENABLE \
+	-DQUANTUM_PAINTER_MOCK_COMMS_ENABLE \
+	-DQUANTUM_PAINTER_PIXDATA_BUFFER_SIZE=64
+qp_comms_common_SRC := \
+	$(QUANTUM_PATH)/painter/qp_comms.c \
+	$(DRIVER_PATH)/painter/comms/qp_comms_mock.c
+qp_comms_common_INC := \
+	$(QUANTUM_PATH)/painter \
+	$(DRIVER_PATH)/painter/comms
+
+qp_comms_async_DEFS := \
+	$(qp_comms_common_DEFS) \
+	-DQUANTUM_PAINTER_ASYNC_COMMS=1
+qp_comms_async_SRC := \
+	$(qp_comms_common_SRC) \
+	$(QUANTUM_PATH)/painter/tests/qp_comms_async.cpp
+qp_comms_async_INC := \
+	$(qp_comms_common_INC)
+
+qp_comms_sync_DEFS := \
+	$(qp_comms_common_DEFS)
+qp_comms_sync_SRC := \
+	$(qp_comms_common_SRC) \
+	$(QUANTUM_PATH)/painter/tests/qp_comms_sync.cpp
+qp_comms_sync_INC := \
+	$(qp_comms_common_INC)
@@ -0,0 +1 @@
+TEST_LIST += qp_comms_async qp_comms_sync
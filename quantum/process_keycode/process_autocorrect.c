@@ -19,9 +19,51 @@
 #    include "autocorrect_data_default.h"
 #endif
 
+// Ring buffer of the last characters typed, oldest first
 static uint8_t typo_buffer[AUTOCORRECT_MAX_LENGTH] = {KC_SPC};
+static uint8_t typo_buffer_start                   = 0; // slot of the oldest character
 static uint8_t typo_buffer_size                    = 1;
 
+/**
+ * @brief the nth oldest character in the typo buffer
+ */
+static inline uint8_t typo_buffer_at(uint8_t n) {
+    uint8_t slot = typo_buffer_start + n;
+    return typo_buffer[slot < AUTOCORRECT_MAX_LENGTH ? slot : slot - AUTOCORRECT_MAX_LENGTH];
+}
+
+/**
+ * @brief appends a character to the typo buffer, dropping the oldest one if it is full
+ */
+static void typo_buffer_append(uint8_t keycode) {
+    if (typo_buffer_size >= AUTOCORRECT_MAX_LENGTH) {
+        typo_buffer_start = typo_buffer_start + 1 < AUTOCORRECT_MAX_LENGTH ? typo_buffer_start + 1 : 0;
+        typo_buffer_size  = AUTOCORRECT_MAX_LENGTH - 1;
+    }
+    uint8_t slot = typo_buffer_start + typo_buffer_size++;
+    typo_buffer[slot < AUTOCORRECT_MAX_LENGTH ? slot : slot - AUTOCORRECT_MAX_LENGTH] = keycode;
+}
+
+#ifdef AUTOCORRECT_PREFILTER_BITS
+/**
+ * @brief checks whether any typo ends with the last characters in the typo buffer
+ *
+ * The dictionary comes with a bitmap of the hashes of the last AUTOCORRECT_PREFILTER_WINDOW characters of every
+ * typo, so that most keypresses can be ruled out with a single lookup rather than by walking the trie. The hash
+ * must match make_prefilter() in the generator.
+ *
+ * @return false if no typo can match
+ */
+static bool autocorrect_prefilter_match(void) {
+    uint16_t hash = 0;
+    for (uint8_t i = typo_buffer_size - AUTOCORRECT_PREFILTER_WINDOW; i < typo_buffer_size; ++i) {
+        hash = hash * 31 + typo_buffer_at(i);
+    }
+    hash &= AUTOCORRECT_PREFILTER_BITS - 1;
+    return pgm_read_byte(autocorrect_prefilter + hash / 8) & (1 << (hash % 8));
+}
+#endif
+
 /**
  * @brief function for querying the enabled state of autocorrect
  *
@@ -265,24 +307,25 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
             return true;
     }
 
-    // Rotate oldest character if buffer is full.
-    if (typo_buffer_size >= AUTOCORRECT_MAX_LENGTH) {
-        memmove(typo_buffer, typo_buffer + 1, AUTOCORRECT_MAX_LENGTH - 1);
-        typo_buffer_size = AUTOCORRECT_MAX_LENGTH - 1;
-    }
-
-    // Append `keycode` to buffer.
-    typo_buffer[typo_buffer_size++] = keycode;
+    // Append `keycode` to buffer, dropping the oldest character if it is full.
+    typo_buffer_append(keycode);
     // Return if buffer is smaller than the shortest word.
     if (typo_buffer_size < AUTOCORRECT_MIN_LENGTH) {
         return true;
     }
 
+#ifdef AUTOCORRECT_PREFILTER_BITS
+    // Return if no typo ends with the last few characters.
+    if (!autocorrect_prefilter_match()) {
+        return true;
+    }
+#endif
+
     // Check for typo in buffer using a trie stored in `autocorrect_data`.
     uint16_t state = 0;
     uint8_t  code  = pgm_read_byte(autocorrect_data + state);
     for (int8_t i = typo_buffer_size - 1; i >= 0; --i) {
-        uint8_t const key_i = typo_buffer[i];
+        uint8_t const key_i = typo_buffer_at(i);
 
         if (code & 64) { // Check for match in node with multiple children.
             code &= 63;
@@ -319,10 +362,10 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
 
             uint8_t typo_len   = 0;
             uint8_t typo_start = 0;
-            bool    space_last = typo_buffer[typo_buffer_size - 1] == KC_SPC;
+            bool    space_last = typo_buffer_at(typo_buffer_size - 1) == KC_SPC;
             for (uint8_t i = typo_buffer_size; i > 0; --i) {
                 // stop counting after finding space (unless it is the last thing)
-                if (typo_buffer[i - 1] == KC_SPC && i != typo_buffer_size) {
+                if (typo_buffer_at(i - 1) == KC_SPC && i != typo_buffer_size) {
                     typo_start = i;
                     break;
                 }
@@ -337,7 +380,7 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
 
             // convert buffer of keycodes into a string
             for (uint8_t i = 0; i < typo_len; ++i) {
-                typo[i] = typo_buffer[typo_start + i] - KC_A + 'a';
+                typo[i] = typo_buffer_at(typo_start + i) - KC_A + 'a';
             }
 
             /* Gather the corrected word
@@ -362,8 +405,8 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
             }
 
             if (keycode == KC_SPC) {
-                typo_buffer[0]   = KC_SPC;
-                typo_buffer_size = 1;
+                typo_buffer_size = 0;
+                typo_buffer_append(KC_SPC);
                 return true;
             } else {
                 typo_buffer_size = 0;
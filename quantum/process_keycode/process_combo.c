@@ -16,6 +16,7 @@
 
 #include "process_combo.h"
 #include <stddef.h>
+#include <stdlib.h>
 #include "process_auto_shift.h"
 #include "caps_word.h"
 #include "timer.h"
@@ -26,6 +27,7 @@
 #include "action_tapping.h"
 #include "action_util.h"
 #include "keymap_introspection.h"
+#include "debug.h"
 
 __attribute__((weak)) void process_combo_event(uint16_t combo_index, bool pressed) {}
 
@@ -141,6 +143,116 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
         } while (0)
 #endif
 
+#ifdef COMBO_INDEX_SIZE
+#    define COMBO_IS_CLEAN(combo) (0 == COMBO_STATE(combo) && !COMBO_DISABLED(combo))
+
+/* Inverted index from keycode to the combos containing it, sorted by keycode
+ * and then combo index so that candidates are visited in the same order as a
+ * full scan would. Built the first time a key is processed. */
+typedef struct {
+    uint16_t keycode;
+    uint16_t combo_index;
+    uint8_t  key_index;
+    uint8_t  key_count;
+} combo_keycode_index_entry_t;
+
+static combo_keycode_index_entry_t combo_keycode_index[COMBO_INDEX_SIZE];
+static uint16_t                    combo_keycode_index_length = 0;
+static uint16_t                    combo_keycode_index_combos = 0; // combo_count() the index was built for
+static bool                        combo_keycode_index_built  = false;
+static bool                        combo_keycode_index_valid  = false; // false if the combos did not fit
+
+#    ifndef COMBO_DIRTY_LENGTH
+#        define COMBO_DIRTY_LENGTH 32
+#    endif
+
+/* Combos whose state may need resetting, so that clear_combos() does not
+ * have to visit every combo. Falls back to a full scan on overflow. */
+static uint16_t combo_dirty[COMBO_DIRTY_LENGTH];
+static uint8_t  combo_dirty_count    = 0;
+static bool     combo_dirty_overflow = false;
+
+static int combo_keycode_index_compare(const void *a, const void *b) {
+    const combo_keycode_index_entry_t *entry_a = a;
+    const combo_keycode_index_entry_t *entry_b = b;
+    if (entry_a->keycode != entry_b->keycode) {
+        return entry_a->keycode < entry_b->keycode ? -1 : 1;
+    }
+    return entry_a->combo_index < entry_b->combo_index ? -1 : (entry_a->combo_index > entry_b->combo_index);
+}
+
+static void combo_keycode_index_build(void) {
+    combo_keycode_index_built  = true;
+    combo_keycode_index_valid  = false;
+    combo_keycode_index_length = 0;
+    combo_keycode_index_combos = combo_count();
+
+    for (uint16_t idx = 0; idx < combo_keycode_index_combos; ++idx) {
+        const uint16_t *keys        = combo_get(idx)->keys;
+        uint16_t        first_entry = combo_keycode_index_length;
+        uint8_t         key_count   = 0;
+        uint16_t        key;
+
+        while (COMBO_END != (key = pgm_read_word(&keys[key_count]))) {
+            bool duplicate = false;
+            for (uint16_t i = first_entry; i < combo_keycode_index_length; ++i) {
+                if (combo_keycode_index[i].keycode == key) {
+                    // Same as a full scan, the last occurrence of a key wins
+                    combo_keycode_index[i].key_index = key_count;
+                    duplicate                        = true;
+                }
+            }
+            if (!duplicate) {
+                if (combo_keycode_index_length >= COMBO_INDEX_SIZE) {
+                    dprintf("combo: %u combos do not fit COMBO_INDEX_SIZE, falling back to scanning\n", combo_keycode_index_combos);
+                    return;
+                }
+                combo_keycode_index[combo_keycode_index_length++] = (combo_keycode_index_entry_t){
+                    .keycode     = key,
+                    .combo_index = idx,
+                    .key_index   = key_count,
+                };
+            }
+            key_count++;
+        }
+        for (uint16_t i = first_entry; i < combo_keycode_index_length; ++i) {
+            combo_keycode_index[i].key_count = key_count;
+        }
+    }
+
+    qsort(combo_keycode_index, combo_keycode_index_length, sizeof(combo_keycode_index_entry_t), combo_keycode_index_compare);
+    combo_keycode_index_valid = true;
+}
+
+/* Returns the position of the first entry for keycode, or combo_keycode_index_length if none. */
+static uint16_t combo_keycode_index_find(uint16_t keycode) {
+    uint16_t low = 0, high = combo_keycode_index_length;
+    while (low < high) {
+        uint16_t mid = low + (high - low) / 2;
+        if (combo_keycode_index[mid].keycode < keycode) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static inline void mark_combo_dirty(uint16_t combo_index, combo_t *combo) {
+    if (!COMBO_IS_CLEAN(combo) || combo_dirty_overflow) {
+        // Already tracked, or about to be found by a full scan
+        return;
+    }
+    if (combo_dirty_count < COMBO_DIRTY_LENGTH) {
+        combo_dirty[combo_dirty_count++] = combo_index;
+    } else {
+        combo_dirty_overflow = true;
+    }
+}
+#else
+#    define mark_combo_dirty(combo_index, combo)
+#endif
+
 static inline void release_combo(uint16_t combo_index, combo_t *combo) {
     if (combo->keycode) {
         keyrecord_t record = {
@@ -194,11 +306,36 @@ static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
 void clear_combos(void) {
     uint16_t index = 0;
     longest_term   = 0;
+#ifdef COMBO_INDEX_SIZE
+    if (!combo_dirty_overflow) {
+        // Only the tracked combos can hold state, active ones stay tracked until released
+        uint8_t kept = 0;
+        for (uint8_t i = 0; i < combo_dirty_count; ++i) {
+            combo_t *combo = combo_get(combo_dirty[i]);
+            if (COMBO_ACTIVE(combo)) {
+                combo_dirty[kept++] = combo_dirty[i];
+            } else {
+                RESET_COMBO_STATE(combo);
+            }
+        }
+        combo_dirty_count = kept;
+        return;
+    }
+    combo_dirty_overflow = false;
+    combo_dirty_count    = 0;
+#endif
     for (index = 0; index < combo_count(); ++index) {
         combo_t *combo = combo_get(index);
         if (!COMBO_ACTIVE(combo)) {
             RESET_COMBO_STATE(combo);
         }
+#ifdef COMBO_INDEX_SIZE
+        else if (combo_dirty_count < COMBO_DIRTY_LENGTH) {
+            combo_dirty[combo_dirty_count++] = index;
+        } else {
+            combo_dirty_overflow = true;
+        }
+#endif
     }
 }
 
@@ -287,6 +424,7 @@ void drop_combo_from_buffer(uint16_t combo_index) {
 
         if (qcombo->combo_index == combo_index) {
             combo_t *combo = combo_get(combo_index);
+            mark_combo_dirty(combo_index, combo);
             DISABLE_COMBO(combo);
 
             if (i == combo_buffer_read) {
@@ -414,16 +552,7 @@ static bool keys_pressed_in_order(uint16_t combo_index, combo_t *combo, uint16_t
 }
 #endif
 
-static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index) {
-    uint8_t  key_count = 0;
-    uint16_t key_index = -1;
-    _find_key_index_and_count(combo->keys, keycode, &key_index, &key_count);
-
-    /* Continue processing if key isn't part of current combo. */
-    if (-1 == (int16_t)key_index) {
-        return false;
-    }
-
+static bool process_combo_key(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index, uint16_t key_index, uint8_t key_count) {
     bool key_is_part_of_combo = (!COMBO_DISABLED(combo) && is_combo_enabled()
 #if defined(COMBO_MUST_PRESS_IN_ORDER) || defined(COMBO_MUST_PRESS_IN_ORDER_PER_COMBO)
                                  && keys_pressed_in_order(combo_index, combo, key_index, keycode, record)
@@ -435,6 +564,7 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
 
     if (record->event.pressed && key_is_part_of_combo) {
         uint16_t time = _get_combo_term(combo_index, combo);
+        mark_combo_dirty(combo_index, combo);
         if (!COMBO_ACTIVE(combo)) {
             KEY_STATE_DOWN(combo->state, key_index);
             if (longest_term < time) {
@@ -461,6 +591,7 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
                     combo_t *       buffered_combo = combo_get(qcombo->combo_index);
 
                     if ((drop = overlaps(buffered_combo, combo))) {
+                        mark_combo_dirty(drop == combo ? combo_index : qcombo->combo_index, drop);
                         DISABLE_COMBO(drop);
                         if (drop == combo) {
                             // stop checking for overlaps if dropped combo was current combo.
@@ -534,9 +665,21 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
     return key_is_part_of_combo;
 }
 
+static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index) {
+    uint8_t  key_count = 0;
+    uint16_t key_index = -1;
+    _find_key_index_and_count(combo->keys, keycode, &key_index, &key_count);
+
+    /* Continue processing if key isn't part of current combo. */
+    if (-1 == (int16_t)key_index) {
+        return false;
+    }
+
+    return process_combo_key(combo, keycode, record, combo_index, key_index, key_count);
+}
+
 bool process_combo(uint16_t keycode, keyrecord_t *record) {
-    bool is_combo_key          = false;
-    bool no_combo_keys_pressed = true;
+    bool is_combo_key = false;
 
     if (keycode == QK_COMBO_ON && record->event.pressed) {
         combo_enable();
@@ -564,10 +707,23 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifdef COMBO_INDEX_SIZE
+    if (!combo_keycode_index_built || combo_keycode_index_combos != combo_count()) {
+        combo_keycode_index_build();
+    }
+    if (combo_keycode_index_valid) {
+        // Only visit the combos that contain this key
+        for (uint16_t i = combo_keycode_index_find(keycode); i < combo_keycode_index_length && combo_keycode_index[i].keycode == keycode; ++i) {
+            const combo_keycode_index_entry_t *entry = &combo_keycode_index[i];
+            is_combo_key |= process_combo_key(combo_get(entry->combo_index), keycode, record, entry->combo_index, entry->key_index, entry->key_count);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            combo_t *combo = combo_get(idx);
+            is_combo_key |= process_single_combo(combo, keycode, record, idx);
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
@@ -16,6 +16,7 @@
  */
 
 #include "process_key_override.h"
+#include <stdlib.h>
 #include "report.h"
 #include "timer.h"
 #include "debug.h"
@@ -112,6 +113,11 @@ bool key_override_is_enabled(void) {
     return enabled;
 }
 
+// Folds both sides of each modifier onto the left side
+static inline uint8_t one_sided_mods(const uint8_t mods) {
+    return (mods & 0b1111) | (mods >> 4);
+}
+
 // Returns whether the modifiers that are pressed are such that the override should activate
 static bool key_override_matches_active_modifiers(const key_override_t *override, const uint8_t mods) {
     // Check that negative keys pass
@@ -131,13 +137,13 @@ static bool key_override_matches_active_modifiers(const key_override_t *override
         // All trigger modifiers must be down, but each mod can be active on either side (if both sides are specified).
 
         // Which mods, regardless of side, are required?
-        uint8_t one_sided_required_mods = (override->trigger_mods & 0b1111) | (override->trigger_mods >> 4);
+        uint8_t one_sided_required_mods = one_sided_mods(override->trigger_mods);
 
         // Which of the required modifiers are active?
         uint8_t active_required_mods = override->trigger_mods & mods;
 
         // Move the active requird mods to one side
-        uint8_t one_sided_active_required_mods = (active_required_mods & 0b1111) | (active_required_mods >> 4);
+        uint8_t one_sided_active_required_mods = one_sided_mods(active_required_mods);
 
         // Check that there is a full match between the required one-sided mods and active required one sided mods
         return one_sided_active_required_mods == one_sided_required_mods;
@@ -245,147 +251,295 @@ static bool check_activation_event(const key_override_t *override, const bool ke
     }
 }
 
-/** Iterates through the list of key overrides and tries activating each, until it finds one that activates or reaches the end of overrides. Returns true if the key action for `keycode` should be sent */
-static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
-    if (key_overrides == NULL) {
-        return true;
+/** Checks whether the override should activate for the given key event, apart from its place in the list of key overrides. */
+static bool can_activate_override(const key_override_t *override, const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods) {
+    // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
+    if (active_mods == 0 && override->trigger_mods != 0) {
+        key_override_printf("Not activating override: Modifiers don't match\n");
+        return false;
     }
 
-    for (uint8_t i = 0;; i++) {
-        const key_override_t *const override = key_overrides[i];
-
-        // End of array
-        if (override == NULL) {
-            break;
-        }
+    // Check layer
+    if ((override->layers & (1 << layer)) == 0) {
+        key_override_printf("Not activating override: Not set to activate on pressed layer\n");
+        return false;
+    }
 
-        // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
-        if (active_mods == 0 && override->trigger_mods != 0) {
-            key_override_printf("Not activating override: Modifiers don't match\n");
-            continue;
-        }
+    // Check allowed activation events
+    if (!check_activation_event(override, key_down, is_mod)) {
+        key_override_printf("Not activating override: Activation event not allowed\n");
+        return false;
+    }
 
-        // Check layer
-        if ((override->layers & (1 << layer)) == 0) {
-            key_override_printf("Not activating override: Not set to activate on pressed layer\n");
-            continue;
-        }
+    const bool is_trigger = override->trigger == keycode;
 
-        // Check allowed activation events
-        if (!check_activation_event(override, key_down, is_mod)) {
-            key_override_printf("Not activating override: Activation event not allowed\n");
-            continue;
-        }
+    // Check if trigger lifted. This is a small optimization in order to skip the remaining checks
+    if (is_trigger && !key_down) {
+        key_override_printf("Not activating override: Trigger lifted\n");
+        return false;
+    }
 
-        const bool is_trigger = override->trigger == keycode;
+    // If the trigger is KC_NO it means 'no key', so only the required modifiers need to be down.
+    const bool no_trigger = override->trigger == KC_NO;
 
-        // Check if trigger lifted. This is a small optimization in order to skip the remaining checks
-        if (is_trigger && !key_down) {
-            key_override_printf("Not activating override: Trigger lifted\n");
-            continue;
-        }
+    // Check if aleady active
+    if (override == active_override) {
+        key_override_printf("Not activating override: Alerady actived\n");
+        return false;
+    }
 
-        // If the trigger is KC_NO it means 'no key', so only the required modifiers need to be down.
-        const bool no_trigger = override->trigger == KC_NO;
+    // Check if enabled
+    if (override->enabled != NULL && !((*(override->enabled) & 1))) {
+        key_override_printf("Not activating override: Not enabled\n");
+        return false;
+    }
 
-        // Check if aleady active
-        if (override == active_override) {
-            key_override_printf("Not activating override: Alerady actived\n");
-            continue;
-        }
+    // Check mods precisely
+    if (!key_override_matches_active_modifiers(override, active_mods)) {
+        key_override_printf("Not activating override: Modifiers don't match\n");
+        return false;
+    }
 
-        // Check if enabled
-        if (override->enabled != NULL && !((*(override->enabled) & 1))) {
-            key_override_printf("Not activating override: Not enabled\n");
-            continue;
-        }
+    // Check if trigger key is down.
+    const bool trigger_down = is_trigger && key_down;
 
-        // Check mods precisely
-        if (!key_override_matches_active_modifiers(override, active_mods)) {
-            key_override_printf("Not activating override: Modifiers don't match\n");
-            continue;
-        }
+    // At this point, all requirements for activation are checked, except whether the trigger key is pressed. Now we check if the required trigger is down
+    // If no trigger key is required, yes.
+    // If the trigger was just pressed, yes.
+    // If the last non-mod key that was pressed down is the trigger key, yes.
+    bool should_activate = no_trigger || trigger_down || last_key_down == override->trigger;
 
-        // Check if trigger key is down.
-        const bool trigger_down = is_trigger && key_down;
+    if (!should_activate) {
+        key_override_printf("Not activating override. Trigger not down\n");
+        return false;
+    }
 
-        // At this point, all requirements for activation are checked, except whether the trigger key is pressed. Now we check if the required trigger is down
-        // If no trigger key is required, yes.
-        // If the trigger was just pressed, yes.
-        // If the last non-mod key that was pressed down is the trigger key, yes.
-        bool should_activate = no_trigger || trigger_down || last_key_down == override->trigger;
+    return true;
+}
 
-        if (!should_activate) {
-            key_override_printf("Not activating override. Trigger not down\n");
-            continue;
-        }
+/** Activates the override. Returns true if the key action for `keycode` should be sent */
+static bool activate_override(const key_override_t *override, const uint16_t keycode, const bool key_down, const bool is_mod, const uint8_t active_mods) {
+    const bool trigger_down = override->trigger == keycode && key_down;
+    const bool no_trigger   = override->trigger == KC_NO;
 
-        key_override_printf("Activating override\n");
+    key_override_printf("Activating override\n");
 
-        clear_active_override(false);
+    clear_active_override(false);
 
 #ifdef DUMMY_MOD_NEUTRALIZER_KEYCODE
-        // Send a dummy keycode before unregistering the modifier(s)
-        // so that suppressing the modifier(s) doesn't falsely get interpreted
-        // by the host OS as a tap of a modifier key.
-        // For example, unintended activations of the start menu on Windows when
-        // using a GUI+<kc> key override with suppressed mods.
-        neutralize_flashing_modifiers(active_mods);
+    // Send a dummy keycode before unregistering the modifier(s)
+    // so that suppressing the modifier(s) doesn't falsely get interpreted
+    // by the host OS as a tap of a modifier key.
+    // For example, unintended activations of the start menu on Windows when
+    // using a GUI+<kc> key override with suppressed mods.
+    neutralize_flashing_modifiers(active_mods);
 #endif
 
-        active_override                 = override;
-        active_override_trigger_is_down = true;
+    active_override                 = override;
+    active_override_trigger_is_down = true;
+
+    set_suppressed_override_mods(override->suppressed_mods);
+
+    if (!trigger_down && !no_trigger) {
+        // When activating a key override the trigger is is always unregistered. In the case where the key that newly pressed is not the trigger key, we have to explicitly remove the trigger key from the keyboard report. If the trigger was just pressed down we simply suppress the event which also has the effect of the trigger key not being registered in the keyboard report.
+        if (IS_BASIC_KEYCODE(override->trigger)) {
+            del_key(override->trigger);
+        } else {
+            unregister_code(override->trigger);
+        }
+    }
+
+    const uint16_t mod_free_replacement = clear_mods_from(override->replacement);
+
+    bool register_replacement = mod_free_replacement != KC_NO &&   // KC_NO is never registered
+                                mod_free_replacement < SAFE_RANGE; // Custom keycodes are never registered
 
-        set_suppressed_override_mods(override->suppressed_mods);
+    // Try firing the custom handler
+    if (override->custom_action != NULL) {
+        register_replacement &= override->custom_action(true, override->context);
+    }
 
-        if (!trigger_down && !no_trigger) {
-            // When activating a key override the trigger is is always unregistered. In the case where the key that newly pressed is not the trigger key, we have to explicitly remove the trigger key from the keyboard report. If the trigger was just pressed down we simply suppress the event which also has the effect of the trigger key not being registered in the keyboard report.
-            if (IS_BASIC_KEYCODE(override->trigger)) {
-                del_key(override->trigger);
+    if (register_replacement) {
+        const uint8_t override_mods = extract_mod_bits(override->replacement);
+        set_weak_override_mods(override_mods);
+
+        // If this is a modifier event that activates the key override we _always_ defer the actual full activation of the override
+        if (is_mod) {
+            key_override_printf("Deferring register replacement key\n");
+            schedule_deferred_register(mod_free_replacement);
+            send_keyboard_report();
+        } else {
+            if (IS_BASIC_KEYCODE(mod_free_replacement)) {
+                add_key(mod_free_replacement);
             } else {
-                unregister_code(override->trigger);
+                key_override_printf("NOT KEY 2\n");
+                send_keyboard_report();
+                // On macOS there seems to be a race condition when it comes to the keyboard report and consumer keycodes. It seems the OS may recognize a consumer keycode before an updated keyboard report, even if the keyboard report is actually sent before the consumer key. I assume it is some sort of race condition because it happens infrequently and very irregularly. Waiting for about at least 10ms between sending the keyboard report and sending the consumer code has shown to fix this.
+                wait_ms(10);
+                register_code(mod_free_replacement);
             }
         }
+    } else {
+        // If not registering the replacement key send keyboard report to update the unregistered keys.
+        send_keyboard_report();
+    }
 
-        const uint16_t mod_free_replacement = clear_mods_from(override->replacement);
+    // If the trigger is down, suppress the event so that it does not get added to the keyboard report.
+    return !trigger_down;
+}
+
+#ifdef KEY_OVERRIDE_INDEX_SIZE
+#    if KEY_OVERRIDE_INDEX_SIZE < 1 || KEY_OVERRIDE_INDEX_SIZE > 255
+#        error "KEY_OVERRIDE_INDEX_SIZE must be between 1 and 255"
+#    endif
+
+/* Index of the key overrides grouped by trigger keycode, sorted by trigger
+ * and then position in key_overrides so that each group is visited in the
+ * same order as a full scan would. Built the first time a key is processed,
+ * and again whenever key_overrides is pointed at a different array. */
+typedef struct {
+    uint16_t trigger;
+    uint8_t  override_index;
+    uint8_t  required_mods; // one-sided mods that must all be down, 0 for ko_option_one_mod
+} key_override_index_entry_t;
+
+static key_override_index_entry_t key_override_index[KEY_OVERRIDE_INDEX_SIZE];
+static uint8_t                    key_override_index_length = 0;
+static const key_override_t     **key_override_index_source = NULL; // key_overrides the index was built for
+static bool                       key_override_index_valid  = false; // false if the overrides did not fit
+
+static int key_override_index_compare(const void *a, const void *b) {
+    const key_override_index_entry_t *entry_a = a;
+    const key_override_index_entry_t *entry_b = b;
+    if (entry_a->trigger != entry_b->trigger) {
+        return entry_a->trigger < entry_b->trigger ? -1 : 1;
+    }
+    return entry_a->override_index < entry_b->override_index ? -1 : (entry_a->override_index > entry_b->override_index);
+}
 
-        bool register_replacement = mod_free_replacement != KC_NO &&   // KC_NO is never registered
-                                    mod_free_replacement < SAFE_RANGE; // Custom keycodes are never registered
+static void key_override_index_build(void) {
+    key_override_index_source = key_overrides;
+    key_override_index_valid  = false;
+    key_override_index_length = 0;
 
-        // Try firing the custom handler
-        if (override->custom_action != NULL) {
-            register_replacement &= override->custom_action(true, override->context);
+    // Wider than the index positions, so that the loop still ends on the size check with 256 or more overrides
+    for (uint16_t i = 0; key_overrides[i] != NULL; i++) {
+        const key_override_t *const override = key_overrides[i];
+        if (key_override_index_length >= KEY_OVERRIDE_INDEX_SIZE) {
+            dprintf("key_override: overrides do not fit KEY_OVERRIDE_INDEX_SIZE, falling back to scanning\n");
+            return;
         }
+        key_override_index[key_override_index_length++] = (key_override_index_entry_t){
+            .trigger        = override->trigger,
+            .override_index = i,
+            .required_mods  = (override->options & ko_option_one_mod) != 0 ? 0 : one_sided_mods(override->trigger_mods),
+        };
+    }
 
-        if (register_replacement) {
-            const uint8_t override_mods = extract_mod_bits(override->replacement);
-            set_weak_override_mods(override_mods);
+    qsort(key_override_index, key_override_index_length, sizeof(key_override_index_entry_t), key_override_index_compare);
+    key_override_index_valid = true;
+}
 
-            // If this is a modifier event that activates the key override we _always_ defer the actual full activation of the override
-            if (is_mod) {
-                key_override_printf("Deferring register replacement key\n");
-                schedule_deferred_register(mod_free_replacement);
-                send_keyboard_report();
-            } else {
-                if (IS_BASIC_KEYCODE(mod_free_replacement)) {
-                    add_key(mod_free_replacement);
-                } else {
-                    key_override_printf("NOT KEY 2\n");
-                    send_keyboard_report();
-                    // On macOS there seems to be a race condition when it comes to the keyboard report and consumer keycodes. It seems the OS may recognize a consumer keycode before an updated keyboard report, even if the keyboard report is actually sent before the consumer key. I assume it is some sort of race condition because it happens infrequently and very irregularly. Waiting for about at least 10ms between sending the keyboard report and sending the consumer code has shown to fix this.
-                    wait_ms(10);
-                    register_code(mod_free_replacement);
-                }
-            }
+/* Returns the position of the first entry for trigger, or key_override_index_length if none. */
+static uint8_t key_override_index_find(uint16_t trigger) {
+    uint8_t low = 0, high = key_override_index_length;
+    while (low < high) {
+        uint8_t mid = low + (high - low) / 2;
+        if (key_override_index[mid].trigger < trigger) {
+            low = mid + 1;
         } else {
-            // If not registering the replacement key send keyboard report to update the unregistered keys.
-            send_keyboard_report();
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/* Candidate overrides for an event are those triggered by the key itself, by
+ * the last key held down, or by no key at all. Each group is a run of the
+ * index, and the runs are merged so that overrides are still tried in the
+ * order they appear in key_overrides. */
+#    define KEY_OVERRIDE_INDEX_RUNS 3
+
+static bool try_activating_indexed_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
+    const uint16_t triggers[KEY_OVERRIDE_INDEX_RUNS] = {keycode, last_key_down, KC_NO};
+    uint8_t        next[KEY_OVERRIDE_INDEX_RUNS];
+    uint8_t        end[KEY_OVERRIDE_INDEX_RUNS];
+    uint8_t        runs = 0;
+
+    for (uint8_t i = 0; i < KEY_OVERRIDE_INDEX_RUNS; i++) {
+        bool duplicate = false;
+        for (uint8_t j = 0; j < i; j++) {
+            duplicate |= triggers[j] == triggers[i];
+        }
+        if (duplicate) {
+            continue;
+        }
+        next[runs] = end[runs] = key_override_index_find(triggers[i]);
+        while (end[runs] < key_override_index_length && key_override_index[end[runs]].trigger == triggers[i]) {
+            end[runs]++;
+        }
+        runs++;
+    }
+
+    const uint8_t one_sided_active_mods = one_sided_mods(active_mods);
+
+    while (true) {
+        // Take the candidate that comes first in key_overrides
+        int8_t run = -1;
+        for (uint8_t i = 0; i < runs; i++) {
+            if (next[i] < end[i] && (run < 0 || key_override_index[next[i]].override_index < key_override_index[next[run]].override_index)) {
+                run = i;
+            }
+        }
+        if (run < 0) {
+            break;
         }
+        const key_override_index_entry_t *const entry = &key_override_index[next[run]++];
 
-        *activated = true;
+        // All of the required mods must be down on either side, which rules out most overrides without looking at them
+        if ((one_sided_active_mods & entry->required_mods) != entry->required_mods) {
+            continue;
+        }
+
+        const key_override_t *const override = key_overrides[entry->override_index];
+        if (can_activate_override(override, keycode, layer, key_down, is_mod, active_mods)) {
+            *activated = true;
+            return activate_override(override, keycode, key_down, is_mod, active_mods);
+        }
+    }
 
-        // If the trigger is down, suppress the event so that it does not get added to the keyboard report.
-        return !trigger_down;
+    *activated = false;
+    return true;
+}
+#endif
+
+/** Iterates through the list of key overrides and tries activating each, until it finds one that activates or reaches the end of overrides. Returns true if the key action for `keycode` should be sent */
+static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
+    if (key_overrides == NULL) {
+        return true;
+    }
+
+#ifdef KEY_OVERRIDE_INDEX_SIZE
+    if (key_override_index_source != key_overrides) {
+        key_override_index_build();
+    }
+    if (key_override_index_valid) {
+        return try_activating_indexed_override(keycode, layer, key_down, is_mod, active_mods, activated);
+    }
+#endif
+
+    for (uint8_t i = 0;; i++) {
+        const key_override_t *const override = key_overrides[i];
+
+        // End of array
+        if (override == NULL) {
+            break;
+        }
+
+        if (can_activate_override(override, keycode, layer, key_down, is_mod, active_mods)) {
+            *activated = true;
+            return activate_override(override, keycode, key_down, is_mod, active_mods);
+        }
     }
 
     *activated = false;
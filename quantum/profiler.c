@@ -0,0 +1,289 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <limits.h>
+#include <string.h>
+#include "profiler.h"
+#include "timer.h"
+#include "print.h"
+
+#ifndef PROFILER_MAX_DEPTH
+#    define PROFILER_MAX_DEPTH 8
+#endif
+
+#ifndef PROFILER_PRINT_INTERVAL
+#    define PROFILER_PRINT_INTERVAL 10000
+#endif
+
+#ifndef PROFILER_RAW_HID_COMMAND_ID
+#    define PROFILER_RAW_HID_COMMAND_ID 0xFE
+#endif
+
+enum profiler_raw_hid_command {
+    PROFILER_RAW_HID_GET_COUNT = 0x01,
+    PROFILER_RAW_HID_GET_STATS = 0x02,
+    PROFILER_RAW_HID_GET_NAME  = 0x03,
+    PROFILER_RAW_HID_RESET     = 0x04,
+};
+
+typedef struct {
+    profiler_zone_t *zone;
+    uint32_t         start;
+    uint32_t         nested; // time spent in zones nested within this one
+} profiler_frame_t;
+
+static profiler_zone_t *first_zone = NULL;
+static profiler_zone_t *last_zone  = NULL;
+static uint8_t          zone_count = 0;
+
+static profiler_frame_t stack[PROFILER_MAX_DEPTH];
+static uint8_t          stack_depth = 0;
+static uint8_t          overflow    = 0; // zones entered beyond PROFILER_MAX_DEPTH, which are not recorded
+
+//------------------------------------
+// Recording
+//
+
+static void register_zone(profiler_zone_t *zone) {
+    zone->registered = true;
+    zone->parent     = stack_depth > 0 ? stack[stack_depth - 1].zone : NULL;
+    zone->depth      = stack_depth;
+    zone->min        = UINT32_MAX;
+    if (last_zone) {
+        last_zone->next = zone;
+    } else {
+        first_zone = zone;
+    }
+    last_zone = zone;
+    zone_count++;
+}
+
+static uint8_t histogram_bucket(uint32_t duration) {
+    uint8_t bucket = duration ? sizeof(unsigned long) * CHAR_BIT - __builtin_clzl(duration) : 0;
+    return bucket < PROFILER_HISTOGRAM_BUCKETS ? bucket : PROFILER_HISTOGRAM_BUCKETS - 1;
+}
+
+static void record_duration(profiler_zone_t *zone, uint32_t duration, uint32_t nested) {
+    zone->calls++;
+    zone->total += duration;
+    zone->self += duration - nested;
+    if (duration < zone->min) {
+        zone->min = duration;
+    }
+    if (duration > zone->max) {
+        zone->max = duration;
+    }
+
+    uint16_t *bucket = &zone->histogram[histogram_bucket(duration)];
+    if (*bucket == UINT16_MAX) {
+        // Keep proportions when saturating, percentiles only depend on relative counts
+        for (uint8_t i = 0; i < PROFILER_HISTOGRAM_BUCKETS; i++) {
+            zone->histogram[i] /= 2;
+        }
+    }
+    (*bucket)++;
+}
+
+void profiler_zone_begin(profiler_zone_t *zone) {
+    if (stack_depth >= PROFILER_MAX_DEPTH) {
+        overflow++;
+        return;
+    }
+    if (!zone->registered) {
+        register_zone(zone);
+    }
+    stack[stack_depth].zone   = zone;
+    stack[stack_depth].nested = 0;
+    // Read the timestamp last, so that registration does not count towards the zone
+    stack[stack_depth++].start = PROFILER_TIMESTAMP();
+}
+
+void profiler_zone_end(profiler_zone_t *zone) {
+    uint32_t now = PROFILER_TIMESTAMP();
+
+    if (overflow > 0) {
+        overflow--;
+        return;
+    }
+    if (stack_depth == 0 || stack[stack_depth - 1].zone != zone) {
+        // Unbalanced begin/end, drop the sample rather than attributing it to the wrong zone
+        return;
+    }
+
+    profiler_frame_t *frame    = &stack[--stack_depth];
+    uint32_t          duration = now - frame->start;
+    record_duration(zone, duration, frame->nested);
+    if (stack_depth > 0) {
+        stack[stack_depth - 1].nested += duration;
+    }
+}
+
+//------------------------------------
+// Results
+//
+
+uint8_t profiler_zone_count(void) {
+    return zone_count;
+}
+
+const profiler_zone_t *profiler_get_zone(uint8_t index) {
+    profiler_zone_t *zone = first_zone;
+    while (zone && index--) {
+        zone = zone->next;
+    }
+    return zone;
+}
+
+const profiler_zone_t *profiler_find_zone(const char *name) {
+    for (profiler_zone_t *zone = first_zone; zone; zone = zone->next) {
+        if (strcmp(zone->name, name) == 0) {
+            return zone;
+        }
+    }
+    return NULL;
+}
+
+static uint8_t zone_index(const profiler_zone_t *target) {
+    uint8_t index = 0;
+    for (profiler_zone_t *zone = first_zone; zone; zone = zone->next, index++) {
+        if (zone == target) {
+            return index;
+        }
+    }
+    return UINT8_MAX;
+}
+
+uint32_t profiler_zone_mean(const profiler_zone_t *zone) {
+    return zone->calls ? (uint32_t)(zone->total / zone->calls) : 0;
+}
+
+uint32_t profiler_zone_percentile(const profiler_zone_t *zone, uint8_t percentile) {
+    uint32_t samples = 0;
+    for (uint8_t i = 0; i < PROFILER_HISTOGRAM_BUCKETS; i++) {
+        samples += zone->histogram[i];
+    }
+    if (samples == 0) {
+        return 0;
+    }
+
+    uint32_t target = (samples * percentile + 99) / 100;
+    uint32_t seen   = 0;
+    for (uint8_t i = 0; i < PROFILER_HISTOGRAM_BUCKETS; i++) {
+        seen += zone->histogram[i];
+        if (seen >= target) {
+            // Upper bound of the bucket, which holds durations of bit length i, the last one holding everything longer
+            if (i == PROFILER_HISTOGRAM_BUCKETS - 1) {
+                return zone->max;
+            }
+            uint32_t upper = (i == 0) ? 0 : (uint32_t)((1ULL << i) - 1);
+            return upper < zone->max ? upper : zone->max;
+        }
+    }
+    return zone->max;
+}
+
+void profiler_reset(void) {
+    for (profiler_zone_t *zone = first_zone; zone; zone = zone->next) {
+        zone->calls = 0;
+        zone->min   = UINT32_MAX;
+        zone->max   = 0;
+        zone->total = 0;
+        zone->self  = 0;
+        memset(zone->histogram, 0, sizeof(zone->histogram));
+    }
+}
+
+// Divides the total down rather than multiplying self up, which would overflow 32 bit accumulators
+__attribute__((unused)) static unsigned self_percentage(const profiler_zone_t *zone) {
+    if (zone->total < 100) {
+        return zone->total ? (unsigned)(zone->self * 100 / zone->total) : 100;
+    }
+    profiler_total_t percentage = zone->self / (zone->total / 100);
+    return percentage < 100 ? (unsigned)percentage : 100;
+}
+
+void profiler_print(void) {
+    xprintf("profiler: zone calls min mean p99 max self%%\n");
+    for (profiler_zone_t *zone = first_zone; zone; zone = zone->next) {
+        for (uint8_t i = 0; i < zone->depth; i++) {
+            xprintf("  ");
+        }
+        xprintf("%s %lu %lu %lu %lu %lu %u%%\n", zone->name, (unsigned long)zone->calls, (unsigned long)(zone->calls ? zone->min : 0), (unsigned long)profiler_zone_mean(zone), (unsigned long)profiler_zone_percentile(zone, 99), (unsigned long)zone->max, self_percentage(zone));
+    }
+}
+
+//------------------------------------
+// Raw HID
+//
+
+static void write_uint32(uint8_t *data, uint32_t value) {
+    // Big endian, matching VIA
+    data[0] = (value >> 24) & 0xFF;
+    data[1] = (value >> 16) & 0xFF;
+    data[2] = (value >> 8) & 0xFF;
+    data[3] = value & 0xFF;
+}
+
+bool profiler_raw_hid_receive(uint8_t *data, uint8_t length) {
+    if (length < 32 || data[0] != PROFILER_RAW_HID_COMMAND_ID) {
+        return false;
+    }
+
+    uint8_t               *command_data = &data[2];
+    const profiler_zone_t *zone         = profiler_get_zone(command_data[0]);
+    switch (data[1]) {
+        case PROFILER_RAW_HID_GET_COUNT:
+            command_data[0] = zone_count;
+            break;
+        case PROFILER_RAW_HID_GET_STATS:
+            if (!zone) {
+                data[0] = 0xFF;
+                break;
+            }
+            command_data[1] = zone->depth;
+            command_data[2] = zone->parent ? zone_index(zone->parent) : UINT8_MAX;
+            write_uint32(&command_data[3], zone->calls);
+            write_uint32(&command_data[7], zone->calls ? zone->min : 0);
+            write_uint32(&command_data[11], profiler_zone_mean(zone));
+            write_uint32(&command_data[15], profiler_zone_percentile(zone, 99));
+            write_uint32(&command_data[19], zone->max);
+            write_uint32(&command_data[23], zone->calls ? (uint32_t)(zone->self / zone->calls) : 0);
+            break;
+        case PROFILER_RAW_HID_GET_NAME: {
+            if (!zone) {
+                data[0] = 0xFF;
+                break;
+            }
+            // Names longer than a packet are read in chunks, starting at the requested offset
+            uint8_t offset   = command_data[1];
+            uint8_t name_len = strlen(zone->name);
+            memset(&command_data[2], 0, length - 4);
+            if (offset < name_len) {
+                uint8_t chunk = name_len - offset;
+                memcpy(&command_data[2], zone->name + offset, chunk < length - 4 ? chunk : length - 4);
+            }
+            break;
+        }
+        case PROFILER_RAW_HID_RESET:
+            profiler_reset();
+            break;
+        default:
+            data[0] = 0xFF;
+            break;
+    }
+    return true;
+}
+
+//------------------------------------
+// Periodic reporting
+//
+
+void profiler_task(void) {
+#if defined(CONSOLE_ENABLE) && PROFILER_PRINT_INTERVAL > 0
+    static uint32_t last_print = 0;
+    if (timer_elapsed32(last_print) >= PROFILER_PRINT_INTERVAL) {
+        last_print = timer_read32();
+        profiler_print();
+    }
+#endif
+}
@@ -0,0 +1,160 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+    Hierarchical profiler, enabled with `PROFILER_ENABLE = yes` in rules.mk.
+
+    Every task run by keyboard_task() and quantum_task() is instrumented automatically. Additional zones can be added
+    around any code, and nest within whichever zone is active at the time:
+
+        #include "profiler.h"
+
+        PROFILE_ZONE("my_feature", {
+            my_feature_task();
+        });
+
+        if (PROFILE_EXPR("my_check", my_check())) {
+            ...
+        }
+
+    Each zone records call count, min/mean/max and an approximate p99 of its duration in timestamp ticks, as well as the
+    time spent outside of nested zones. Results are printed over console every PROFILER_PRINT_INTERVAL milliseconds, and
+    can be queried over raw HID through profiler_raw_hid_receive().
+
+    When the profiler is disabled, the macros compile down to the wrapped code, and no platform headers are pulled in.
+*/
+
+#ifdef PROFILER_ENABLE
+
+#    include "profiler_timestamp.h"
+
+//------------------------------------
+// Zones
+//
+
+#    ifndef PROFILER_HISTOGRAM_BUCKETS
+#        define PROFILER_HISTOGRAM_BUCKETS 32
+#    endif
+
+// Accumulated durations. AVR timestamps tick slowly enough for 32 bits to cover hours, and 64 bit arithmetic is costly
+// there.
+#    if defined(__AVR__)
+typedef uint32_t profiler_total_t;
+#    else
+typedef uint64_t profiler_total_t;
+#    endif
+
+/**
+ * @struct Statistics for a single named zone.
+ * @brief Zones are statically allocated by the PROFILE_* macros, and registered the first time they are entered.
+ */
+typedef struct profiler_zone_t {
+    const char             *name;
+    struct profiler_zone_t *next;   // next registered zone
+    struct profiler_zone_t *parent; // enclosing zone the first time this one was entered
+    uint8_t                 depth;
+    bool                    registered;
+    uint32_t                calls;
+    uint32_t                min;
+    uint32_t                max;
+    profiler_total_t        total;
+    profiler_total_t        self; // total excluding nested zones
+    uint16_t                histogram[PROFILER_HISTOGRAM_BUCKETS];
+} profiler_zone_t;
+
+/**
+ * Marks the start of a zone, nested within the currently active zone if any.
+ */
+void profiler_zone_begin(profiler_zone_t *zone);
+
+/**
+ * Marks the end of a zone, which must be the most recently started one.
+ */
+void profiler_zone_end(profiler_zone_t *zone);
+
+#    define PROFILE_ZONE(zone_name, ...)                                \
+        do {                                                            \
+            static profiler_zone_t profiler_zone_ = {.name = zone_name}; \
+            profiler_zone_begin(&profiler_zone_);                       \
+            __VA_ARGS__;                                                \
+            profiler_zone_end(&profiler_zone_);                         \
+        } while (0)
+
+#    define PROFILE_EXPR(zone_name, expr)                               \
+        ({                                                              \
+            static profiler_zone_t profiler_zone_ = {.name = zone_name}; \
+            profiler_zone_begin(&profiler_zone_);                       \
+            __typeof__(expr) profiler_result_ = (expr);                 \
+            profiler_zone_end(&profiler_zone_);                         \
+            profiler_result_;                                           \
+        })
+
+//------------------------------------
+// Results
+//
+
+/**
+ * @return the number of registered zones
+ */
+uint8_t profiler_zone_count(void);
+
+/**
+ * @param index[in] the registration index of the zone, zones are registered the first time they are entered
+ * @return the zone, or NULL if out of range
+ */
+const profiler_zone_t *profiler_get_zone(uint8_t index);
+
+/**
+ * @param name[in] the name of the zone
+ * @return the first registered zone with the given name, or NULL if none was entered yet
+ */
+const profiler_zone_t *profiler_find_zone(const char *name);
+
+/**
+ * @return the mean duration of the zone
+ */
+uint32_t profiler_zone_mean(const profiler_zone_t *zone);
+
+/**
+ * @return the duration under which the given percentage of calls completed, bounded by the zone's maximum
+ */
+uint32_t profiler_zone_percentile(const profiler_zone_t *zone, uint8_t percentile);
+
+/**
+ * Clears the statistics of every zone, keeping them registered.
+ */
+void profiler_reset(void);
+
+/**
+ * Prints a summary of every zone over console.
+ */
+void profiler_print(void);
+
+/**
+ * Handles a profiler raw HID request in place, returning true if the packet was one.
+ * The response should be sent back with raw_hid_send() by the caller.
+ */
+bool profiler_raw_hid_receive(uint8_t *data, uint8_t length);
+
+/**
+ * Periodic printing of results, invoked from keyboard_task().
+ */
+void profiler_task(void);
+
+#else
+
+#    define PROFILE_ZONE(zone_name, ...) \
+        do {                             \
+            __VA_ARGS__;                 \
+        } while (0)
+
+#    define PROFILE_EXPR(zone_name, expr) (expr)
+
+#endif // PROFILER_ENABLE
+
+#define PROFILE_TASK(task) PROFILE_ZONE(#task, task())
+#define PROFILE_TASK_RESULT(task) PROFILE_EXPR(#task, task())
@@ -0,0 +1,50 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+
+/*
+    Cheapest high resolution timestamp available on each platform, in ticks of an unspecified length. Used by the
+    profiler, and by anything else measuring short durations without pulling in the rest of it.
+*/
+
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#    if PORT_SUPPORTS_RT == TRUE
+// CPU cycles
+#        define PROFILER_TIMESTAMP() ((uint32_t)chSysGetRealtimeCounterX())
+#    else
+// System ticks, for cores without a cycle counter
+#        define PROFILER_TIMESTAMP() ((uint32_t)chVTGetSystemTimeX())
+#    endif
+#elif defined(PROTOCOL_ARM_ATSAM)
+#    include "samd51j18a.h"
+// CPU cycles
+static inline uint32_t profiler_timestamp(void) {
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    return DWT->CYCCNT;
+}
+#    define PROFILER_TIMESTAMP() profiler_timestamp()
+#elif defined(__AVR__)
+#    include "timer.h"
+#    include "timer_avr.h"
+// Timer0 ticks, TIMER_PRESCALER cycles each
+static inline uint32_t profiler_timestamp(void) {
+    uint32_t ms;
+    uint8_t  raw;
+    do {
+        ms  = timer_read32();
+        raw = TIMER_RAW;
+    } while (ms != timer_read32());
+    return ms * TIMER_RAW_TOP + raw;
+}
+#    define PROFILER_TIMESTAMP() profiler_timestamp()
+#else
+#    include "timer.h"
+// Milliseconds, for host-side builds
+#    define PROFILER_TIMESTAMP() timer_read32()
+#endif
@@ -136,10 +136,12 @@ __attribute__((weak)) void unregister_code16(uint16_t code) {
  */
 __attribute__((weak)) void tap_code16_delay(uint16_t code, uint16_t delay) {
     register_code16(code);
+    report_scheduler_flush();
     for (uint16_t i = delay; i > 0; i--) {
         wait_ms(1);
     }
     unregister_code16(code);
+    report_scheduler_flush();
 }
 
 /** \brief Tap a keycode with the default delay.
@@ -178,6 +180,7 @@ __attribute__((weak)) void post_process_record_user(uint16_t keycode, keyrecord_
 
 void shutdown_quantum(bool jump_to_bootloader) {
     clear_keyboard();
+    report_scheduler_flush();
 #if defined(MIDI_ENABLE) && defined(MIDI_BASIC)
     process_midi_all_notes_off();
 #endif
@@ -198,6 +201,9 @@ void shutdown_quantum(bool jump_to_bootloader) {
 #ifdef HAPTIC_ENABLE
     haptic_shutdown();
 #endif
+#if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_MIRROR)
+    dynamic_keymap_flush();
+#endif
 }
 
 void reset_keyboard(void) {
@@ -510,6 +516,7 @@ __attribute__((weak)) bool shutdown_kb(bool jump_to_bootloader) {
 }
 
 void suspend_power_down_quantum(void) {
+    report_scheduler_flush();
     suspend_power_down_kb();
 #ifndef NO_SUSPEND_POWER_DOWN
 // Turn off backlight
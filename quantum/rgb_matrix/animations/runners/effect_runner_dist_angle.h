@@ -0,0 +1,20 @@
+#pragma once
+
+typedef HSV (*dist_angle_f)(HSV hsv, uint8_t dist, uint8_t angle, uint8_t time);
+
+bool effect_runner_dist_angle(effect_params_t* params, dist_angle_f effect_func) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    hsv_batch_t batch = {0};
+    uint8_t     time  = scale16by8(g_rgb_timer, rgb_matrix_config.speed / 2);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        int16_t dx    = led_geometry_dx(i);
+        int16_t dy    = led_geometry_dy(i);
+        uint8_t dist  = led_geometry_dist(i, dx, dy);
+        uint8_t angle = led_geometry_angle(i, dx, dy);
+        hsv_batch_set(&batch, i, effect_func(rgb_matrix_config.hsv, dist, angle, time));
+    }
+    hsv_batch_flush(&batch);
+    return rgb_matrix_check_finished_leds(led_max);
+}
@@ -3,27 +3,94 @@
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 
 typedef HSV (*reactive_splash_f)(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
+// Returns the distance from a hit beyond which the effect leaves LEDs untouched
+typedef uint8_t (*reactive_splash_reach_f)(uint16_t tick);
+
+// The hits reaching each LED are kept as a bitmask, so larger hit buffers fall back to visiting every LED
+#    if defined(RGB_MATRIX_LED_SPATIAL_INDEX) && LED_HITS_TO_REMEMBER <= 32
+#        define RGB_MATRIX_REACTIVE_SPLASH_HIT_MASK
+#        if LED_HITS_TO_REMEMBER <= 8
+typedef uint8_t reactive_splash_hits_t;
+#        elif LED_HITS_TO_REMEMBER <= 16
+typedef uint16_t reactive_splash_hits_t;
+#        else
+typedef uint32_t reactive_splash_hits_t;
+#        endif
+_Static_assert(LED_HITS_TO_REMEMBER <= sizeof(reactive_splash_hits_t) * 8, "Every hit needs a bit of reactive_splash_hits_t");
+
+// Hits within reach of each LED for the current frame, one bit per hit counting from the oldest
+static reactive_splash_hits_t reactive_splash_hits[RGB_MATRIX_LED_COUNT];
+#    endif
+
+static inline uint16_t reactive_splash_tick(uint8_t slot) {
+    return scale16by8(last_hit_age(&g_last_hit_tracker, slot, g_rgb_timer), qadd8(rgb_matrix_config.speed, 1));
+}
+
+static inline HSV reactive_splash_apply(HSV hsv, uint8_t i, uint8_t j, reactive_splash_f effect_func) {
+    uint8_t slot = last_hit_slot(&g_last_hit_tracker, j);
+    int16_t dx   = g_led_config.point[i].x - g_last_hit_tracker.x[slot];
+    int16_t dy   = g_led_config.point[i].y - g_last_hit_tracker.y[slot];
+    uint8_t dist = sqrt16(dx * dx + dy * dy);
+    return effect_func(hsv, dx, dy, dist, reactive_splash_tick(slot));
+}
 
 bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
-    uint8_t count = g_last_hit_tracker.count;
+    uint8_t     count = g_last_hit_tracker.count;
+    hsv_batch_t batch = {0};
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
         HSV hsv = rgb_matrix_config.hsv;
         hsv.v   = 0;
         for (uint8_t j = start; j < count; j++) {
-            int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
-            int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
-            uint8_t  dist = sqrt16(dx * dx + dy * dy);
-            uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
-            hsv           = effect_func(hsv, dx, dy, dist, tick);
+            hsv = reactive_splash_apply(hsv, i, j, effect_func);
+        }
+        hsv.v = scale8(hsv.v, rgb_matrix_config.hsv.v);
+        hsv_batch_set(&batch, i, hsv);
+    }
+    hsv_batch_flush(&batch);
+    return rgb_matrix_check_finished_leds(led_max);
+}
+
+// Same as effect_runner_reactive_splash(), for effects which leave LEDs beyond the reach of a hit untouched
+bool effect_runner_reactive_splash_reach(uint8_t start, effect_params_t* params, reactive_splash_f effect_func, reactive_splash_reach_f reach_func) {
+#    ifdef RGB_MATRIX_REACTIVE_SPLASH_HIT_MASK
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    // The hits only change between frames, so find the LEDs they reach once per frame
+    if (params->iter == 0) {
+        memset(reactive_splash_hits, 0, sizeof(reactive_splash_hits));
+        for (uint8_t j = start; j < g_last_hit_tracker.count; j++) {
+            uint8_t         slot = last_hit_slot(&g_last_hit_tracker, j);
+            led_grid_iter_t iter;
+            uint8_t         led;
+            led_grid_iter_init(&iter, g_last_hit_tracker.x[slot], g_last_hit_tracker.y[slot], reach_func(reactive_splash_tick(slot)));
+            while (led_grid_iter_next(&iter, &led)) {
+                reactive_splash_hits[led] |= (reactive_splash_hits_t)1 << j;
+            }
+        }
+    }
+
+    hsv_batch_t batch = {0};
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        HSV hsv = rgb_matrix_config.hsv;
+        hsv.v   = 0;
+        reactive_splash_hits_t hits = reactive_splash_hits[i];
+        for (uint8_t j = 0; hits; j++, hits >>= 1) {
+            if (hits & 1) {
+                hsv = reactive_splash_apply(hsv, i, j, effect_func);
+            }
         }
-        hsv.v   = scale8(hsv.v, rgb_matrix_config.hsv.v);
-        RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
-        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+        hsv.v = scale8(hsv.v, rgb_matrix_config.hsv.v);
+        hsv_batch_set(&batch, i, hsv);
     }
+    hsv_batch_flush(&batch);
     return rgb_matrix_check_finished_leds(led_max);
+#    else
+    return effect_runner_reactive_splash(start, params, effect_func);
+#    endif
 }
 
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -18,15 +18,20 @@ HSV SOLID_SPLASH_math(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t ti
     return hsv;
 }
 
+uint8_t SOLID_SPLASH_reach(uint16_t tick) {
+    // the ring grows with time, and has faded out after passing the furthest LED
+    return tick < UINT8_MAX ? tick : (tick < 2 * UINT8_MAX ? UINT8_MAX : 0);
+}
+
 #            ifdef ENABLE_RGB_MATRIX_SOLID_SPLASH
 bool SOLID_SPLASH(effect_params_t* params) {
-    return effect_runner_reactive_splash(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_SPLASH_math);
+    return effect_runner_reactive_splash_reach(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_SPLASH_math, &SOLID_SPLASH_reach);
 }
 #            endif
 
 #            ifdef ENABLE_RGB_MATRIX_SOLID_MULTISPLASH
 bool SOLID_MULTISPLASH(effect_params_t* params) {
-    return effect_runner_reactive_splash(0, params, &SOLID_SPLASH_math);
+    return effect_runner_reactive_splash_reach(0, params, &SOLID_SPLASH_math, &SOLID_SPLASH_reach);
 }
 #            endif
 
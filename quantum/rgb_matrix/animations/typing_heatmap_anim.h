@@ -16,10 +16,44 @@ RGB_MATRIX_EFFECT(TYPING_HEATMAP)
 #        ifndef RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT
 #            define RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT 16
 #        endif
+#        ifndef RGB_MATRIX_TYPING_HEATMAP_SLIM
+// Spreads the heat of a key press to the key at the given position
+static void typing_heatmap_spread(uint8_t pressed_led, uint8_t row, uint8_t col) {
+#            define LED_DISTANCE(led_a, led_b) sqrt16(((int16_t)(led_a.x - led_b.x) * (int16_t)(led_a.x - led_b.x)) + ((int16_t)(led_a.y - led_b.y) * (int16_t)(led_a.y - led_b.y)))
+    uint8_t distance = LED_DISTANCE(g_led_config.point[pressed_led], g_led_config.point[g_led_config.matrix_co[row][col]]);
+#            undef LED_DISTANCE
+    if (distance <= RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
+        uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
+        if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
+            amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
+        }
+        g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], amount);
+    }
+}
+#        endif
+
 void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
 #        ifdef RGB_MATRIX_TYPING_HEATMAP_SLIM
     // Limit effect to pressed keys
     g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
+#        elif defined(RGB_MATRIX_LED_SPATIAL_INDEX)
+    uint8_t pressed_led = g_led_config.matrix_co[row][col];
+    if (pressed_led == NO_LED) { // skip as pressed key doesn't have an led position
+        return;
+    }
+    g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
+
+    // Only visit the keys close enough to be within the spread
+    led_grid_iter_t iter;
+    uint8_t         led;
+    led_grid_iter_init(&iter, g_led_config.point[pressed_led].x, g_led_config.point[pressed_led].y, RGB_MATRIX_TYPING_HEATMAP_SPREAD);
+    while (led_grid_iter_next(&iter, &led)) {
+        keypos_t key = led_grid_key[led];
+        if (key.row == UINT8_MAX || (key.row == row && key.col == col)) { // skip as target led doesn't have a key, or is the pressed key
+            continue;
+        }
+        typing_heatmap_spread(pressed_led, key.row, key.col);
+    }
 #        else
     if (g_led_config.matrix_co[row][col] == NO_LED) { // skip as pressed key doesn't have an led position
         return;
@@ -32,16 +66,7 @@ void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
             if (i_row == row && i_col == col) {
                 g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
             } else {
-#            define LED_DISTANCE(led_a, led_b) sqrt16(((int16_t)(led_a.x - led_b.x) * (int16_t)(led_a.x - led_b.x)) + ((int16_t)(led_a.y - led_b.y) * (int16_t)(led_a.y - led_b.y)))
-                uint8_t distance = LED_DISTANCE(g_led_config.point[g_led_config.matrix_co[row][col]], g_led_config.point[g_led_config.matrix_co[i_row][i_col]]);
-#            undef LED_DISTANCE
-                if (distance <= RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
-                    uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
-                    if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
-                        amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
-                    }
-                    g_rgb_frame_buffer[i_row][i_col] = qadd8(g_rgb_frame_buffer[i_row][i_col], amount);
-                }
+                typing_heatmap_spread(g_led_config.matrix_co[row][col], i_row, i_col);
             }
         }
     }
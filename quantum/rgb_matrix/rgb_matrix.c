@@ -39,6 +39,168 @@ __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
     return hsv_to_rgb(hsv);
 }
 
+// LED geometry, relative to the center of the matrix
+#ifdef RGB_MATRIX_LED_GEOMETRY_CACHE
+static led_geometry_t led_geometry[RGB_MATRIX_LED_COUNT];
+#endif // RGB_MATRIX_LED_GEOMETRY_CACHE
+
+// LEDs bucketed by position, so that effects can visit the LEDs near a point without going through the whole board
+#ifdef RGB_MATRIX_LED_SPATIAL_INDEX
+#    define LED_GRID_SIZE (UINT8_MAX / RGB_MATRIX_LED_SPATIAL_INDEX_CELL_SIZE + 1)
+static uint8_t led_grid_start[LED_GRID_SIZE * LED_GRID_SIZE + 1]; // first entry of each cell in led_grid, followed by the LED count
+static uint8_t led_grid[RGB_MATRIX_LED_COUNT];                     // LED indices, ordered by cell
+#    if defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS)
+static keypos_t led_grid_key[RGB_MATRIX_LED_COUNT]; // key of each LED, for effects working on g_rgb_frame_buffer
+#    endif
+
+static inline uint16_t led_grid_cell(uint8_t col, uint8_t row) {
+    return row * LED_GRID_SIZE + col;
+}
+
+static inline uint16_t led_grid_cell_at(uint8_t x, uint8_t y) {
+    return led_grid_cell(x / RGB_MATRIX_LED_SPATIAL_INDEX_CELL_SIZE, y / RGB_MATRIX_LED_SPATIAL_INDEX_CELL_SIZE);
+}
+
+typedef struct {
+    uint8_t col_min, col_max, row_max; // cells to visit
+    uint8_t col, row;                  // next cell
+    uint8_t pos, end;                  // next entry in led_grid, and end of the current cell
+} led_grid_iter_t;
+
+// Visits the LEDs of all cells overlapping the square of the given reach around a point, which includes every LED within that distance
+static void led_grid_iter_init(led_grid_iter_t *iter, uint8_t x, uint8_t y, uint8_t reach) {
+    iter->col_min = qsub8(x, reach) / RGB_MATRIX_LED_SPATIAL_INDEX_CELL_SIZE;
+    iter->col_max = qadd8(x, reach) / RGB_MATRIX_LED_SPATIAL_INDEX_CELL_SIZE;
+    iter->row     = qsub8(y, reach) / RGB_MATRIX_LED_SPATIAL_INDEX_CELL_SIZE;
+    iter->row_max = qadd8(y, reach) / RGB_MATRIX_LED_SPATIAL_INDEX_CELL_SIZE;
+    iter->col     = iter->col_min;
+    iter->pos     = 0;
+    iter->end     = 0;
+}
+
+static bool led_grid_iter_next(led_grid_iter_t *iter, uint8_t *led) {
+    while (iter->pos == iter->end) {
+        if (iter->row > iter->row_max) {
+            return false;
+        }
+        uint16_t cell = led_grid_cell(iter->col, iter->row);
+        iter->pos     = led_grid_start[cell];
+        iter->end     = led_grid_start[cell + 1];
+        if (++iter->col > iter->col_max) {
+            iter->col = iter->col_min;
+            iter->row++;
+        }
+    }
+    *led = led_grid[iter->pos++];
+    return true;
+}
+#endif // RGB_MATRIX_LED_SPATIAL_INDEX
+
+void rgb_matrix_update_led_geometry(void) {
+#ifdef RGB_MATRIX_LED_GEOMETRY_CACHE
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        int16_t dx            = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy            = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        led_geometry[i].dx    = dx;
+        led_geometry[i].dy    = dy;
+        led_geometry[i].dist  = sqrt16(dx * dx + dy * dy);
+        led_geometry[i].angle = atan2_8(dy, dx);
+    }
+#endif // RGB_MATRIX_LED_GEOMETRY_CACHE
+
+#ifdef RGB_MATRIX_LED_SPATIAL_INDEX
+    // Counting sort of the LEDs by cell
+    memset(led_grid_start, 0, sizeof(led_grid_start));
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        led_grid_start[led_grid_cell_at(g_led_config.point[i].x, g_led_config.point[i].y) + 1]++;
+    }
+    for (uint16_t cell = 1; cell < ARRAY_SIZE(led_grid_start); cell++) {
+        led_grid_start[cell] += led_grid_start[cell - 1];
+    }
+    // Placing each LED moves the start of its cell along, ending up at the start of the next one
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        led_grid[led_grid_start[led_grid_cell_at(g_led_config.point[i].x, g_led_config.point[i].y)]++] = i;
+    }
+    memmove(&led_grid_start[1], &led_grid_start[0], sizeof(led_grid_start) - 1);
+    led_grid_start[0] = 0;
+
+#    if defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS)
+    memset(led_grid_key, UINT8_MAX, sizeof(led_grid_key));
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (g_led_config.matrix_co[row][col] != NO_LED) {
+                led_grid_key[g_led_config.matrix_co[row][col]] = MAKE_KEYPOS(row, col);
+            }
+        }
+    }
+#    endif
+#endif // RGB_MATRIX_LED_SPATIAL_INDEX
+}
+
+static inline int16_t led_geometry_dx(uint8_t i) {
+#ifdef RGB_MATRIX_LED_GEOMETRY_CACHE
+    return led_geometry[i].dx;
+#else
+    return g_led_config.point[i].x - k_rgb_matrix_center.x;
+#endif
+}
+
+static inline int16_t led_geometry_dy(uint8_t i) {
+#ifdef RGB_MATRIX_LED_GEOMETRY_CACHE
+    return led_geometry[i].dy;
+#else
+    return g_led_config.point[i].y - k_rgb_matrix_center.y;
+#endif
+}
+
+static inline uint8_t led_geometry_dist(uint8_t i, int16_t dx, int16_t dy) {
+#ifdef RGB_MATRIX_LED_GEOMETRY_CACHE
+    return led_geometry[i].dist;
+#else
+    return sqrt16(dx * dx + dy * dy);
+#endif
+}
+
+static inline uint8_t led_geometry_angle(uint8_t i, int16_t dx, int16_t dy) {
+#ifdef RGB_MATRIX_LED_GEOMETRY_CACHE
+    return led_geometry[i].angle;
+#else
+    return atan2_8(dy, dx);
+#endif
+}
+
+// Colors set by the effect runners, converted to RGB in batches
+typedef struct {
+    uint8_t count;
+    bool    converted; // whether last_hsv holds a previous conversion
+    HSV     last_hsv;
+    RGB     last_rgb;
+    uint8_t index[RGB_MATRIX_HSV_BATCH_SIZE];
+    HSV     hsv[RGB_MATRIX_HSV_BATCH_SIZE];
+} hsv_batch_t;
+
+static void hsv_batch_flush(hsv_batch_t *batch) {
+    for (uint8_t n = 0; n < batch->count; n++) {
+        HSV hsv = batch->hsv[n];
+        // Neighbouring LEDs often share a color, so only convert on change
+        if (!batch->converted || hsv.h != batch->last_hsv.h || hsv.s != batch->last_hsv.s || hsv.v != batch->last_hsv.v) {
+            batch->last_hsv  = hsv;
+            batch->last_rgb  = rgb_matrix_hsv_to_rgb(hsv);
+            batch->converted = true;
+        }
+        rgb_matrix_set_color(batch->index[n], batch->last_rgb.r, batch->last_rgb.g, batch->last_rgb.b);
+    }
+    batch->count = 0;
+}
+
+static inline void hsv_batch_set(hsv_batch_t *batch, uint8_t index, HSV hsv) {
+    batch->index[batch->count] = index;
+    batch->hsv[batch->count]   = hsv;
+    if (++batch->count == RGB_MATRIX_HSV_BATCH_SIZE) {
+        hsv_batch_flush(batch);
+    }
+}
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
@@ -76,12 +238,22 @@ static uint8_t         rgb_last_enable   = UINT8_MAX;
 static uint8_t         rgb_last_effect   = UINT8_MAX;
 static effect_params_t rgb_effect_params = {0, LED_FLAG_ALL, false};
 static rgb_task_states rgb_task_state    = SYNCING;
+#ifdef RGB_MATRIX_LED_FLUSH_IDLE_LIMIT
+static uint16_t     rgb_flush_interval = RGB_MATRIX_LED_FLUSH_LIMIT;
+static uint32_t     rgb_frame_hash;      // fingerprint of the colors set while rendering the current frame
+static uint32_t     rgb_last_frame_hash; // fingerprint of the previous frame
+static rgb_config_t rgb_last_config;     // config at the start of the current frame
+#endif // RGB_MATRIX_LED_FLUSH_IDLE_LIMIT
 
 // double buffers
 static uint32_t rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 static last_hit_t last_hit_buffer;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+#ifdef RGB_MATRIX_DOUBLE_BUFFER
+static RGB rgb_back_buffer[RGB_MATRIX_LED_COUNT];  // frame being rendered
+static RGB rgb_front_buffer[RGB_MATRIX_LED_COUNT]; // frame last passed on to the driver
+#endif // RGB_MATRIX_DOUBLE_BUFFER
 
 // split rgb matrix
 #if defined(RGB_MATRIX_SPLIT)
@@ -140,23 +312,59 @@ uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
 }
 
 void rgb_matrix_update_pwm_buffers(void) {
+#ifdef RGB_MATRIX_DOUBLE_BUFFER
+    // Pass the finished frame on to the driver, only for the LEDs which changed
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        if (memcmp(&rgb_back_buffer[i], &rgb_front_buffer[i], sizeof(RGB)) != 0) {
+            rgb_front_buffer[i] = rgb_back_buffer[i];
+            rgb_matrix_driver.set_color(i, rgb_back_buffer[i].r, rgb_back_buffer[i].g, rgb_back_buffer[i].b);
+        }
+    }
+#endif // RGB_MATRIX_DOUBLE_BUFFER
     rgb_matrix_driver.flush();
 }
 
+#ifdef RGB_MATRIX_LED_FLUSH_IDLE_LIMIT
+static inline void rgb_frame_hash_add(uint8_t index, uint8_t red, uint8_t green, uint8_t blue) {
+    // FNV-1a over whole words, order matters so that moving colors change the fingerprint
+    rgb_frame_hash = (rgb_frame_hash ^ ((uint32_t)index << 24 | (uint32_t)red << 16 | (uint32_t)green << 8 | blue)) * 16777619UL;
+}
+#endif // RGB_MATRIX_LED_FLUSH_IDLE_LIMIT
+
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_LED_FLUSH_IDLE_LIMIT
+    rgb_frame_hash_add(index, red, green, blue);
+#endif // RGB_MATRIX_LED_FLUSH_IDLE_LIMIT
+#ifdef RGB_MATRIX_DOUBLE_BUFFER
+    if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
+        rgb_back_buffer[index] = (RGB){.r = red, .g = green, .b = blue};
+    }
+#else
     rgb_matrix_driver.set_color(index, red, green, blue);
+#endif // RGB_MATRIX_DOUBLE_BUFFER
 }
 
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+#if defined(RGB_MATRIX_LED_FLUSH_IDLE_LIMIT) && !defined(RGB_MATRIX_SPLIT)
+    rgb_frame_hash_add(UINT8_MAX, red, green, blue);
+#endif
 #if defined(RGB_MATRIX_SPLIT)
     for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
         rgb_matrix_set_color(i, red, green, blue);
+#elif defined(RGB_MATRIX_DOUBLE_BUFFER)
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
+        rgb_back_buffer[i] = (RGB){.r = red, .g = green, .b = blue};
 #else
     rgb_matrix_driver.set_color_all(red, green, blue);
 #endif
 }
 
 void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
+#ifdef RGB_MATRIX_LED_FLUSH_IDLE_LIMIT
+    // reactive effects need to pick up key presses straight away
+    rgb_flush_interval = RGB_MATRIX_LED_FLUSH_LIMIT;
+#endif // RGB_MATRIX_LED_FLUSH_IDLE_LIMIT
+
 #ifndef RGB_MATRIX_SPLIT
     if (!is_keyboard_master()) return;
 #endif
@@ -174,21 +382,9 @@ void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
         led_count = rgb_matrix_map_row_column_to_led(row, col, led);
     }
 
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
-    }
-
+    // hits are timed from the last timer update, which their age in the next frame counts from
     for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
-        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
-        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
-        last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
+        last_hit_add(&last_hit_buffer, g_led_config.point[led[i]].x, g_led_config.point[led[i]].y, led[i], rgb_timer_buffer);
     }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
@@ -239,29 +435,54 @@ static bool rgb_matrix_none(effect_params_t *params) {
     return false;
 }
 
+typedef bool (*rgb_matrix_effect_f)(effect_params_t *params);
+
+// Effects indexed by mode, each rendering part of a frame and returning whether there is more to render
+static rgb_matrix_effect_f const rgb_matrix_effects[RGB_MATRIX_EFFECT_MAX] PROGMEM = {
+    [RGB_MATRIX_NONE] = rgb_matrix_none,
+
+// ---------------------------------------------
+// -----Begin rgb effect table macros-----------
+#define RGB_MATRIX_EFFECT(name, ...) [RGB_MATRIX_##name] = name,
+#include "rgb_matrix_effects.inc"
+#undef RGB_MATRIX_EFFECT
+
+#if defined(RGB_MATRIX_CUSTOM_KB) || defined(RGB_MATRIX_CUSTOM_USER)
+#    define RGB_MATRIX_EFFECT(name, ...) [RGB_MATRIX_CUSTOM_##name] = name,
+#    ifdef RGB_MATRIX_CUSTOM_KB
+#        include "rgb_matrix_kb.inc"
+#    endif
+#    ifdef RGB_MATRIX_CUSTOM_USER
+#        include "rgb_matrix_user.inc"
+#    endif
+#    undef RGB_MATRIX_EFFECT
+#endif
+    // -----End rgb effect table macros-------------
+    // ---------------------------------------------
+};
+
 static void rgb_task_timers(void) {
-#if defined(RGB_MATRIX_KEYREACTIVE_ENABLED)
-    uint32_t deltaTime = sync_timer_elapsed32(rgb_timer_buffer);
-#endif // defined(RGB_MATRIX_KEYREACTIVE_ENABLED)
     rgb_timer_buffer = sync_timer_read32();
 
-    // Update double buffer last hit timers
+    // Drop double buffer last hits which are too old for the effects to tell apart
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t count = last_hit_buffer.count;
-    for (uint8_t i = 0; i < count; ++i) {
-        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
-            last_hit_buffer.count--;
-            continue;
-        }
-        last_hit_buffer.tick[i] += deltaTime;
-    }
+    last_hit_expire(&last_hit_buffer, rgb_timer_buffer, UINT16_MAX);
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 }
 
-static void rgb_task_sync(void) {
+static void rgb_task_sync(uint8_t effect) {
     eeconfig_flush_rgb_matrix(false);
+#ifdef RGB_MATRIX_LED_FLUSH_IDLE_LIMIT
+    // stop backing off as soon as anything which affects the next frame changes
+    if (effect != rgb_last_effect || memcmp(&rgb_matrix_config, &rgb_last_config, sizeof(rgb_matrix_config)) != 0) {
+        rgb_flush_interval = RGB_MATRIX_LED_FLUSH_LIMIT;
+    }
+    // next task
+    if (sync_timer_elapsed32(g_rgb_timer) >= rgb_flush_interval) rgb_task_state = STARTING;
+#else
     // next task
     if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
+#endif // RGB_MATRIX_LED_FLUSH_IDLE_LIMIT
 }
 
 static void rgb_task_start(void) {
@@ -274,6 +495,11 @@ static void rgb_task_start(void) {
     g_last_hit_tracker = last_hit_buffer;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
+#ifdef RGB_MATRIX_LED_FLUSH_IDLE_LIMIT
+    rgb_frame_hash  = 2166136261UL;
+    rgb_last_config = rgb_matrix_config;
+#endif // RGB_MATRIX_LED_FLUSH_IDLE_LIMIT
+
     // next task
     rgb_task_state = RENDERING;
 }
@@ -288,42 +514,14 @@ static void rgb_task_render(uint8_t effect) {
 
     // each effect can opt to do calculations
     // and/or request PWM buffer updates.
-    switch (effect) {
-        case RGB_MATRIX_NONE:
-            rendering = rgb_matrix_none(&rgb_effect_params);
-            break;
-
-// ---------------------------------------------
-// -----Begin rgb effect switch case macros-----
-#define RGB_MATRIX_EFFECT(name, ...)          \
-    case RGB_MATRIX_##name:                   \
-        rendering = name(&rgb_effect_params); \
-        break;
-#include "rgb_matrix_effects.inc"
-#undef RGB_MATRIX_EFFECT
-
-#if defined(RGB_MATRIX_CUSTOM_KB) || defined(RGB_MATRIX_CUSTOM_USER)
-#    define RGB_MATRIX_EFFECT(name, ...)          \
-        case RGB_MATRIX_CUSTOM_##name:            \
-            rendering = name(&rgb_effect_params); \
-            break;
-#    ifdef RGB_MATRIX_CUSTOM_KB
-#        include "rgb_matrix_kb.inc"
-#    endif
-#    ifdef RGB_MATRIX_CUSTOM_USER
-#        include "rgb_matrix_user.inc"
-#    endif
-#    undef RGB_MATRIX_EFFECT
-#endif
-            // -----End rgb effect switch case macros-------
-            // ---------------------------------------------
-
+    if (effect < RGB_MATRIX_EFFECT_MAX) {
+        rgb_matrix_effect_f render = (rgb_matrix_effect_f)pgm_read_ptr(&rgb_matrix_effects[effect]);
+        rendering                  = render(&rgb_effect_params);
+    } else if (effect == UINT8_MAX) {
         // Factory default magic value
-        case UINT8_MAX: {
-            rgb_matrix_test();
-            rgb_task_state = FLUSHING;
-        }
-            return;
+        rgb_matrix_test();
+        rgb_task_state = FLUSHING;
+        return;
     }
 
     rgb_effect_params.iter++;
@@ -346,6 +544,16 @@ static void rgb_task_flush(uint8_t effect) {
     // update pwm buffers
     rgb_matrix_update_pwm_buffers();
 
+#ifdef RGB_MATRIX_LED_FLUSH_IDLE_LIMIT
+    // back off while frames stay the same, such as with static effects
+    if (rgb_frame_hash == rgb_last_frame_hash) {
+        rgb_flush_interval = MIN(rgb_flush_interval * 2, RGB_MATRIX_LED_FLUSH_IDLE_LIMIT);
+    } else {
+        rgb_flush_interval = RGB_MATRIX_LED_FLUSH_LIMIT;
+    }
+    rgb_last_frame_hash = rgb_frame_hash;
+#endif // RGB_MATRIX_LED_FLUSH_IDLE_LIMIT
+
     // next task
     rgb_task_state = SYNCING;
 }
@@ -372,15 +580,20 @@ void rgb_matrix_task(void) {
             if (effect) {
                 if (rgb_task_state == FLUSHING) { // ensure we only draw basic indicators once rendering is finished
                     rgb_matrix_indicators();
+#ifdef RGB_MATRIX_DOUBLE_BUFFER
+                    rgb_matrix_indicators_advanced(&rgb_effect_params);
+#endif // RGB_MATRIX_DOUBLE_BUFFER
                 }
+#ifndef RGB_MATRIX_DOUBLE_BUFFER
                 rgb_matrix_indicators_advanced(&rgb_effect_params);
+#endif // RGB_MATRIX_DOUBLE_BUFFER
             }
             break;
         case FLUSHING:
             rgb_task_flush(effect);
             break;
         case SYNCING:
-            rgb_task_sync();
+            rgb_task_sync(effect);
             break;
     }
 }
@@ -428,6 +641,18 @@ struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter) {
 }
 
 void rgb_matrix_indicators_advanced(effect_params_t *params) {
+#ifdef RGB_MATRIX_DOUBLE_BUFFER
+    // the whole frame is in the back buffer, so the advanced indicators are drawn once over all of this half's LEDs
+    struct rgb_matrix_limits_t limits = {.led_min_index = 0, .led_max_index = RGB_MATRIX_LED_COUNT};
+#    if defined(RGB_MATRIX_SPLIT)
+    if (is_keyboard_left()) {
+        limits.led_max_index = MIN(limits.led_max_index, k_rgb_matrix_split[0]);
+    } else {
+        limits.led_min_index = k_rgb_matrix_split[0];
+    }
+#    endif
+    rgb_matrix_indicators_advanced_kb(limits.led_min_index, limits.led_max_index);
+#else
     /* special handling is needed for "params->iter", since it's already been incremented.
      * Could move the invocations to rgb_task_render, but then it's missing a few checks
      * and not sure which would be better. Otherwise, this should be called from
@@ -435,6 +660,7 @@ void rgb_matrix_indicators_advanced(effect_params_t *params) {
      */
     RGB_MATRIX_USE_LIMITS_ITER(min, max, params->iter - 1);
     rgb_matrix_indicators_advanced_kb(min, max);
+#endif // RGB_MATRIX_DOUBLE_BUFFER
 }
 
 __attribute__((weak)) bool rgb_matrix_indicators_advanced_kb(uint8_t led_min, uint8_t led_max) {
@@ -447,17 +673,11 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
 
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
+    rgb_matrix_update_led_geometry();
 
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        g_last_hit_tracker.tick[i] = UINT16_MAX;
-    }
-
-    last_hit_buffer.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        last_hit_buffer.tick[i] = UINT16_MAX;
-    }
+    last_hit_buffer.count    = 0;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
     eeconfig_init_rgb_matrix();
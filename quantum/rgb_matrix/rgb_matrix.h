@@ -86,10 +86,28 @@
 #    define RGB_MATRIX_LED_FLUSH_LIMIT 16
 #endif
 
+#if defined(RGB_MATRIX_LED_GEOMETRY_CACHE) && !defined(RGB_MATRIX_LED_PROCESS_LIMIT)
+// With the geometry precomputed, a whole frame is cheap enough to render within a single task run
+#    define RGB_MATRIX_LED_PROCESS_LIMIT RGB_MATRIX_LED_COUNT
+#endif
+
 #ifndef RGB_MATRIX_LED_PROCESS_LIMIT
 #    define RGB_MATRIX_LED_PROCESS_LIMIT ((RGB_MATRIX_LED_COUNT + 4) / 5)
 #endif
 
+#ifndef RGB_MATRIX_HSV_BATCH_SIZE
+#    define RGB_MATRIX_HSV_BATCH_SIZE 16
+#endif
+
+#ifdef RGB_MATRIX_LED_SPATIAL_INDEX
+#    ifndef RGB_MATRIX_LED_SPATIAL_INDEX_CELL_SIZE
+#        define RGB_MATRIX_LED_SPATIAL_INDEX_CELL_SIZE 32
+#    endif
+#    if RGB_MATRIX_LED_COUNT > 255
+#        error "RGB_MATRIX_LED_SPATIAL_INDEX supports up to 255 LEDs"
+#    endif
+#endif
+
 struct rgb_matrix_limits_t {
     uint8_t led_min_index;
     uint8_t led_max_index;
@@ -164,6 +182,9 @@ bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max);
 
 void rgb_matrix_init(void);
 
+// Recomputes the geometry used by the effects, needed with RGB_MATRIX_LED_GEOMETRY_CACHE or RGB_MATRIX_LED_SPATIAL_INDEX after changing g_led_config at runtime
+void rgb_matrix_update_led_geometry(void);
+
 void rgb_matrix_reload_from_eeprom(void);
 
 void        rgb_matrix_set_suspend_state(bool state);
@@ -0,0 +1,68 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include "util.h"
+
+#if LED_HITS_TO_REMEMBER > UINT8_MAX
+#    error "LED_HITS_TO_REMEMBER must fit the hit count, at most 255"
+#endif
+
+/*
+    Ring buffer of the most recent key hits, oldest first.
+
+    Each hit stores the time it happened rather than its age, so that adding a hit only writes a single slot and
+    nothing needs updating as time goes on. Hits are looked up by their position from the oldest, which
+    last_hit_slot() turns into a slot of the arrays below.
+*/
+typedef struct PACKED {
+    uint8_t  count; // number of hits stored
+    uint8_t  head;  // slot of the oldest hit
+    uint8_t  x[LED_HITS_TO_REMEMBER];
+    uint8_t  y[LED_HITS_TO_REMEMBER];
+    uint8_t  index[LED_HITS_TO_REMEMBER];
+    uint32_t time[LED_HITS_TO_REMEMBER];
+} last_hit_t;
+
+/**
+ * @return the slot holding the nth oldest hit
+ */
+static inline uint8_t last_hit_slot(const last_hit_t *hits, uint8_t n) {
+    uint16_t slot = hits->head + n;
+    return slot < LED_HITS_TO_REMEMBER ? slot : slot - LED_HITS_TO_REMEMBER;
+}
+
+/**
+ * @return the age of the hit in the given slot at the given time, in milliseconds
+ */
+static inline uint32_t last_hit_age(const last_hit_t *hits, uint8_t slot, uint32_t now) {
+    return now - hits->time[slot];
+}
+
+/**
+ * Adds a hit, replacing the oldest one if the buffer is full.
+ */
+static inline void last_hit_add(last_hit_t *hits, uint8_t x, uint8_t y, uint8_t index, uint32_t time) {
+    uint8_t slot = last_hit_slot(hits, hits->count);
+    if (hits->count < LED_HITS_TO_REMEMBER) {
+        hits->count++;
+    } else {
+        hits->head = last_hit_slot(hits, 1);
+    }
+    hits->x[slot]     = x;
+    hits->y[slot]     = y;
+    hits->index[slot] = index;
+    hits->time[slot]  = time;
+}
+
+/**
+ * Drops the hits older than the given age, which only ever involves looking at the oldest ones.
+ */
+static inline void last_hit_expire(last_hit_t *hits, uint32_t now, uint32_t max_age) {
+    while (hits->count > 0 && last_hit_age(hits, hits->head, now) > max_age) {
+        hits->head = last_hit_slot(hits, 1);
+        hits->count--;
+    }
+}
@@ -31,13 +31,7 @@
 #endif // LED_HITS_TO_REMEMBER
 
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-typedef struct PACKED {
-    uint8_t  count;
-    uint8_t  x[LED_HITS_TO_REMEMBER];
-    uint8_t  y[LED_HITS_TO_REMEMBER];
-    uint8_t  index[LED_HITS_TO_REMEMBER];
-    uint16_t tick[LED_HITS_TO_REMEMBER];
-} last_hit_t;
+#    include "rgb_matrix_last_hit.h"
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
 typedef enum rgb_task_states { STARTING, RENDERING, FLUSHING, SYNCING } rgb_task_states;
@@ -55,6 +49,13 @@ typedef struct PACKED {
     uint8_t y;
 } led_point_t;
 
+typedef struct PACKED {
+    int16_t dx;    // offset from k_rgb_matrix_center
+    int16_t dy;
+    uint8_t dist;  // distance from k_rgb_matrix_center
+    uint8_t angle; // atan2_8(dy, dx)
+} led_geometry_t;
+
 #define HAS_FLAGS(bits, flags) ((bits & flags) == flags)
 #define HAS_ANY_FLAGS(bits, flags) ((bits & flags) != 0x00)
 
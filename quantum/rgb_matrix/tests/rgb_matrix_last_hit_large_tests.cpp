@@ -0,0 +1,24 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "rgb_matrix_last_hit.h"
+}
+
+/**
+ * This test verifies that hits are kept in order once the head is past half of a buffer of more than 128 hits.
+ */
+TEST(LastHitLarge, Full_WrapsAround) {
+    last_hit_t hits = {};
+    for (uint16_t id = 0; id < LED_HITS_TO_REMEMBER + 150; id++) {
+        last_hit_add(&hits, id, 0, 0, id);
+    }
+    ASSERT_EQ(hits.count, LED_HITS_TO_REMEMBER);
+    EXPECT_GT(hits.head, 128);
+    for (uint16_t n = 0; n < LED_HITS_TO_REMEMBER; n++) {
+        uint8_t slot = last_hit_slot(&hits, n);
+        ASSERT_LT(slot, LED_HITS_TO_REMEMBER);
+        EXPECT_EQ(hits.x[slot], (uint8_t)(n + 150)) << "Hit " << n << " out of order";
+    }
+}
@@ -0,0 +1,103 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "rgb_matrix_last_hit.h"
+}
+
+class LastHit : public ::testing::Test {
+   protected:
+    last_hit_t hits = {};
+
+    // Adds a hit whose fields are all derived from the given id, to tell them apart afterwards
+    void add(uint8_t id, uint32_t time) {
+        last_hit_add(&hits, id, id + 100, id + 200, time);
+    }
+
+    void expect_hits(std::vector<uint8_t> ids) {
+        ASSERT_EQ(hits.count, ids.size());
+        for (uint8_t n = 0; n < ids.size(); n++) {
+            uint8_t slot = last_hit_slot(&hits, n);
+            EXPECT_EQ(hits.x[slot], ids[n]) << "Hit " << (int)n << " out of order";
+            EXPECT_EQ(hits.y[slot], ids[n] + 100) << "Hit " << (int)n << " out of order";
+            EXPECT_EQ(hits.index[slot], ids[n] + 200) << "Hit " << (int)n << " out of order";
+        }
+    }
+};
+
+/**
+ * This test verifies that hits are kept oldest first until the buffer is full.
+ */
+TEST_F(LastHit, Add_KeepsOrder) {
+    add(1, 10);
+    add(2, 20);
+    add(3, 30);
+    expect_hits({1, 2, 3});
+}
+
+/**
+ * This test verifies that once full, each new hit replaces the oldest one, wrapping around the buffer repeatedly.
+ */
+TEST_F(LastHit, Full_ReplacesOldest) {
+    for (uint8_t id = 1; id <= LED_HITS_TO_REMEMBER; id++) {
+        add(id, id);
+    }
+    expect_hits({1, 2, 3, 4});
+
+    add(5, 5);
+    expect_hits({2, 3, 4, 5});
+
+    for (uint8_t id = 6; id <= 3 * LED_HITS_TO_REMEMBER + 1; id++) {
+        add(id, id);
+    }
+    expect_hits({10, 11, 12, 13});
+}
+
+/**
+ * This test verifies that ages are derived from the time of each hit, including across the timer wrapping around.
+ */
+TEST_F(LastHit, Age_FromTime) {
+    add(1, 100);
+    add(2, UINT32_MAX - 9);
+    EXPECT_EQ(last_hit_age(&hits, last_hit_slot(&hits, 0), 250), 150);
+    EXPECT_EQ(last_hit_age(&hits, last_hit_slot(&hits, 1), 10), 20) << "Age should carry on across the timer wrapping around";
+}
+
+/**
+ * This test verifies that expiring hits drops the oldest ones only, with the buffer wrapped around.
+ */
+TEST_F(LastHit, Expire_DropsOldest) {
+    for (uint8_t id = 1; id <= LED_HITS_TO_REMEMBER + 2; id++) {
+        add(id, id * 100);
+    }
+    expect_hits({3, 4, 5, 6});
+
+    last_hit_expire(&hits, 1000, 500);
+    expect_hits({5, 6});
+
+    // Hits exactly at the maximum age are kept
+    last_hit_expire(&hits, 1000, 400);
+    expect_hits({6});
+
+    last_hit_expire(&hits, 100000, UINT16_MAX);
+    expect_hits({});
+}
+
+/**
+ * This test verifies that the buffer keeps working after being emptied part way around.
+ */
+TEST_F(LastHit, Expire_ThenAdd) {
+    add(1, 0);
+    add(2, 0);
+    add(3, 0);
+    last_hit_expire(&hits, 1000, 0);
+    expect_hits({});
+
+    for (uint8_t id = 4; id <= 9; id++) {
+        add(id, 1000);
+    }
+    expect_hits({6, 7, 8, 9});
+    last_hit_expire(&hits, 1000, 0);
+    expect_hits({6, 7, 8, 9});
+}
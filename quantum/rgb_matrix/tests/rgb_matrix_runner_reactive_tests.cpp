@@ -0,0 +1,99 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "gtest/gtest.h"
+
+// rgb_matrix_types.h checks the size of rgb_config_t with the C spelling
+#define _Static_assert static_assert
+
+extern "C" {
+#include "rgb_matrix_types.h"
+#include "lib/lib8tion/lib8tion.h"
+}
+
+// Just enough of rgb_matrix.c for the runner to render all LEDs in a single pass
+#define RGB_MATRIX_USE_LIMITS(min, max) \
+    uint8_t min = 0;                    \
+    uint8_t max = RGB_MATRIX_LED_COUNT;
+#define RGB_MATRIX_TEST_LED_FLAGS() \
+    if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) continue
+
+typedef struct {
+    uint8_t count;
+} hsv_batch_t;
+
+static rgb_config_t rgb_matrix_config;
+static uint32_t     g_rgb_timer;
+static led_config_t g_led_config;
+static last_hit_t   g_last_hit_tracker;
+static uint16_t     last_offset;
+static uint16_t     rendered_offset[RGB_MATRIX_LED_COUNT];
+
+static inline void hsv_batch_set(hsv_batch_t *batch, uint8_t index, HSV hsv) {
+    rendered_offset[index] = last_offset;
+}
+
+static inline void hsv_batch_flush(hsv_batch_t *batch) {}
+
+static inline bool rgb_matrix_check_finished_leds(uint8_t led_idx) {
+    return false;
+}
+
+#include "effect_runner_reactive.h"
+
+// Records the offset the runner computed for the LED it is about to set
+static HSV record_offset(HSV hsv, uint16_t offset) {
+    last_offset = offset;
+    return hsv;
+}
+
+class RunnerReactive : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        g_last_hit_tracker      = {};
+        g_rgb_timer             = 100000;
+        rgb_matrix_config.speed = 127;
+        rgb_matrix_config.hsv   = {0, 0, 0};
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            g_led_config.flags[i] = LED_FLAG_KEYLIGHT;
+        }
+    }
+
+    void render() {
+        effect_params_t params = {0, LED_FLAG_ALL, false};
+        effect_runner_reactive(&params, record_offset);
+    }
+
+    uint16_t expected_offset(uint16_t tick) {
+        return scale16by8(tick, qadd8(rgb_matrix_config.speed, 1));
+    }
+
+    // Fills the buffer with hits 2ms apart, the newest one 2ms old, all made on LED 0 apart from the given one
+    void add_hits(uint8_t n_other, uint8_t other_index) {
+        for (uint16_t n = 0; n < LED_HITS_TO_REMEMBER; n++) {
+            last_hit_add(&g_last_hit_tracker, 0, 0, n == n_other ? other_index : 0, g_rgb_timer - 2 * (LED_HITS_TO_REMEMBER - n));
+        }
+        ASSERT_EQ(g_last_hit_tracker.count, LED_HITS_TO_REMEMBER);
+    }
+};
+
+/**
+ * This test verifies that the most recent hit of an LED is found when it sits past the first 128 hits of the buffer.
+ */
+TEST_F(RunnerReactive, Full_FindsMostRecentHitPastHalf) {
+    add_hits(LED_HITS_TO_REMEMBER - 1, 1);
+
+    render();
+    EXPECT_EQ(rendered_offset[0], expected_offset(4));
+    EXPECT_EQ(rendered_offset[1], expected_offset(2));
+    EXPECT_EQ(rendered_offset[2], expected_offset(65535 / qadd8(rgb_matrix_config.speed, 1)));
+}
+
+/**
+ * This test verifies that every hit is searched, down to the oldest one, in a full buffer.
+ */
+TEST_F(RunnerReactive, Full_FindsOldestHit) {
+    add_hits(0, 2);
+
+    render();
+    EXPECT_EQ(rendered_offset[2], expected_offset(2 * LED_HITS_TO_REMEMBER));
+}
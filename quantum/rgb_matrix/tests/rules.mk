@@ -0,0 +1,18 @@
+rgb_matrix_last_hit_DEFS := -DLED_HITS_TO_REMEMBER=4
+rgb_matrix_last_hit_SRC := \
+	$(QUANTUM_PATH)/rgb_matrix/tests/rgb_matrix_last_hit_tests.cpp
+rgb_matrix_last_hit_INC := \
+	$(QUANTUM_PATH)/rgb_matrix
+
+rgb_matrix_last_hit_large_DEFS := -DLED_HITS_TO_REMEMBER=200
+rgb_matrix_last_hit_large_SRC := \
+	$(QUANTUM_PATH)/rgb_matrix/tests/rgb_matrix_last_hit_large_tests.cpp
+rgb_matrix_last_hit_large_INC := \
+	$(QUANTUM_PATH)/rgb_matrix
+
+rgb_matrix_runner_reactive_DEFS := -DLED_HITS_TO_REMEMBER=200 -DRGB_MATRIX_KEYPRESSES -DRGB_MATRIX_LED_COUNT=4 -DMATRIX_ROWS=1 -DMATRIX_COLS=4
+rgb_matrix_runner_reactive_SRC := \
+	$(QUANTUM_PATH)/rgb_matrix/tests/rgb_matrix_runner_reactive_tests.cpp
+rgb_matrix_runner_reactive_INC := \
+	$(QUANTUM_PATH)/rgb_matrix \
+	$(QUANTUM_PATH)/rgb_matrix/animations/runners
@@ -0,0 +1,4 @@
+TEST_LIST += \
+	rgb_matrix_last_hit \
+	rgb_matrix_last_hit_large \
+	rgb_matrix_runner_reactive
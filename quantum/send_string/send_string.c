@@ -22,7 +22,10 @@
 #include "quantum_keycodes.h"
 #include "keycode.h"
 #include "action.h"
+#include "action_util.h"
+#include "host.h"
 #include "wait.h"
+#include "timer.h"
 
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
 #    include "audio.h"
@@ -151,6 +154,9 @@ void send_string(const char *string) {
 }
 
 void send_string_with_delay(const char *string, uint8_t interval) {
+#ifdef SEND_STRING_ASYNC_ENABLE
+    send_string_async_flush();
+#endif
     while (1) {
         char ascii_code = *string;
         if (!ascii_code) break;
@@ -204,6 +210,10 @@ void send_char_with_delay(char ascii_code, uint8_t interval) {
     }
 #endif
 
+#ifdef SEND_STRING_ASYNC_ENABLE
+    send_string_async_flush();
+#endif
+
     uint8_t keycode    = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
     bool    is_shifted = PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code);
     bool    is_altgred = PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code);
@@ -298,6 +308,9 @@ void send_string_P(const char *string) {
 }
 
 void send_string_with_delay_P(const char *string, uint8_t interval) {
+#    ifdef SEND_STRING_ASYNC_ENABLE
+    send_string_async_flush();
+#    endif
     while (1) {
         char ascii_code = pgm_read_byte(string);
         if (!ascii_code) break;
@@ -336,3 +349,223 @@ void send_string_with_delay_P(const char *string, uint8_t interval) {
     }
 }
 #endif
+
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    ifndef SEND_STRING_ASYNC_QUEUE_SIZE
+#        define SEND_STRING_ASYNC_QUEUE_SIZE 16
+#    endif
+
+// The most keystrokes a single character of the string turns into: shift, AltGr, the key itself and the space after a dead key, each pressed and released
+#    define SEND_STRING_ASYNC_MAX_CHAR_OPS 8
+
+#    if SEND_STRING_ASYNC_QUEUE_SIZE < SEND_STRING_ASYNC_MAX_CHAR_OPS || SEND_STRING_ASYNC_QUEUE_SIZE > 128 || (SEND_STRING_ASYNC_QUEUE_SIZE & (SEND_STRING_ASYNC_QUEUE_SIZE - 1)) != 0
+#        error "SEND_STRING_ASYNC_QUEUE_SIZE must be a power of two from 8 to 128"
+#    endif
+
+typedef struct {
+    uint8_t  keycode;
+    bool     pressed;
+    uint16_t delay; // time to wait after sending, in milliseconds
+} send_string_async_op_t;
+
+/*
+    The queued string is turned into key presses and releases a few characters at a time, as room frees up in the
+    queue, so that strings of any length can be queued without holding them all in RAM at once.
+*/
+static send_string_async_op_t async_queue[SEND_STRING_ASYNC_QUEUE_SIZE];
+static uint8_t                async_head     = 0; // index of the next keystroke to send
+static uint8_t                async_count    = 0;
+static const char            *async_string   = NULL; // the rest of the string still to be read, if any
+static bool                   async_progmem  = false;
+static uint8_t                async_interval = 0;
+static uint32_t               async_last     = 0; // when the last keystroke was sent
+static uint16_t               async_delay    = 0; // time to wait after the last keystroke was sent
+
+__attribute__((weak)) bool send_string_async_ready(void) {
+#    ifdef REPORT_SCHEDULER_ENABLE
+    // Keystrokes are only worth handing over once the scheduler has room, or a full queue would turn them away
+    if (report_scheduler_depth() > 0) {
+        return false;
+    }
+#    endif
+    return host_keyboard_ready();
+}
+
+static void async_push(uint8_t keycode, bool pressed, uint16_t delay) {
+    send_string_async_op_t *op = &async_queue[(async_head + async_count) & (SEND_STRING_ASYNC_QUEUE_SIZE - 1)];
+
+    op->keycode = keycode;
+    op->pressed = pressed;
+    op->delay   = delay;
+    async_count++;
+}
+
+static void async_push_delay(uint16_t delay) {
+    // Waits are folded into the keystroke before them, or into the one already sent if there is none left
+    if (async_count > 0) {
+        async_queue[(async_head + async_count - 1) & (SEND_STRING_ASYNC_QUEUE_SIZE - 1)].delay += delay;
+    } else if (timer_elapsed32(async_last) < async_delay) {
+        async_delay += delay;
+    } else {
+        async_last  = timer_read32();
+        async_delay = delay;
+    }
+}
+
+// Same keystrokes as tap_code()
+static void async_push_tap(uint8_t keycode, uint16_t delay) {
+    async_push(keycode, true, keycode == KC_CAPS_LOCK ? TAP_HOLD_CAPS_DELAY : TAP_CODE_DELAY);
+    async_push(keycode, false, delay);
+}
+
+// Same keystrokes as send_char_with_delay()
+static void async_push_char(char ascii_code, uint8_t interval) {
+#    if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+    if (ascii_code == '\a') { // BEL
+        PLAY_SONG(bell_song);
+        return;
+    }
+#    endif
+
+    uint8_t keycode    = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+    bool    is_shifted = PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code);
+    bool    is_altgred = PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code);
+    bool    is_dead    = PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code);
+
+    if (is_shifted) {
+        async_push(KC_LEFT_SHIFT, true, interval);
+    }
+    if (is_altgred) {
+        async_push(KC_RIGHT_ALT, true, interval);
+    }
+    async_push(keycode, true, interval);
+    async_push(keycode, false, interval);
+    if (is_altgred) {
+        async_push(KC_RIGHT_ALT, false, interval);
+    }
+    if (is_shifted) {
+        async_push(KC_LEFT_SHIFT, false, interval);
+    }
+    if (is_dead) {
+        async_push_tap(KC_SPACE, interval);
+    }
+}
+
+static char async_peek(void) {
+    return async_progmem ? pgm_read_byte(async_string) : *async_string;
+}
+
+// Lets go of the string as soon as its last character has been read, so that the next one can be queued straight away
+static char async_read(void) {
+    if (!async_string) {
+        return 0;
+    }
+
+    char ascii_code = async_peek();
+    async_string++;
+    if (!async_peek()) {
+        async_string = NULL;
+    }
+    return ascii_code;
+}
+
+// Same parsing as send_string_with_delay(), carried on for as long as there is room in the queue
+static void async_fill(void) {
+    while (async_string && async_count <= SEND_STRING_ASYNC_QUEUE_SIZE - SEND_STRING_ASYNC_MAX_CHAR_OPS) {
+        char ascii_code = async_read();
+        if (ascii_code != SS_QMK_PREFIX) {
+            async_push_char(ascii_code, async_interval);
+            continue;
+        }
+
+        ascii_code = async_read();
+        if (ascii_code == SS_TAP_CODE || ascii_code == SS_DOWN_CODE || ascii_code == SS_UP_CODE) {
+            uint8_t keycode = async_read();
+            if (!keycode) break;
+            if (ascii_code == SS_TAP_CODE) {
+                async_push_tap(keycode, async_interval);
+            } else {
+                async_push(keycode, ascii_code == SS_DOWN_CODE, async_interval);
+            }
+        } else if (ascii_code == SS_DELAY_CODE) {
+            uint16_t ms      = 0;
+            char     keycode = async_read();
+
+            while (isdigit(keycode)) {
+                ms *= 10;
+                ms += keycode - '0';
+                keycode = async_read();
+            }
+            async_push_delay(ms + async_interval);
+        } else if (ascii_code) {
+            async_push_delay(async_interval);
+        }
+    }
+}
+
+static bool async_start(const char *string, uint8_t interval, bool progmem) {
+    if (async_string) {
+        return false;
+    }
+
+    async_string   = string;
+    async_progmem  = progmem;
+    async_interval = interval;
+    if (!async_peek()) {
+        async_string = NULL;
+    }
+    async_fill();
+    return true;
+}
+
+bool send_string_async(const char *string) {
+    return send_string_async_with_delay(string, TAP_CODE_DELAY);
+}
+
+bool send_string_async_with_delay(const char *string, uint8_t interval) {
+    return async_start(string, interval, false);
+}
+
+#    if defined(__AVR__)
+bool send_string_async_P(const char *string) {
+    return send_string_async_with_delay_P(string, TAP_CODE_DELAY);
+}
+
+bool send_string_async_with_delay_P(const char *string, uint8_t interval) {
+    return async_start(string, interval, true);
+}
+#    endif
+
+bool send_string_async_busy(void) {
+    return async_count > 0 || async_string;
+}
+
+void send_string_async_task(void) {
+    if (async_count == 0 || timer_elapsed32(async_last) < async_delay || !send_string_async_ready()) {
+        return;
+    }
+
+    send_string_async_op_t *op = &async_queue[async_head];
+    if (op->pressed) {
+        register_code(op->keycode);
+    } else {
+        unregister_code(op->keycode);
+    }
+    async_last  = timer_read32();
+    async_delay = op->delay;
+    async_head  = (async_head + 1) & (SEND_STRING_ASYNC_QUEUE_SIZE - 1);
+    async_count--;
+    async_fill();
+}
+
+void send_string_async_flush(void) {
+    while (true) {
+        uint32_t elapsed = timer_elapsed32(async_last);
+        if (elapsed < async_delay) {
+            wait_ms(async_delay - elapsed);
+        }
+        if (!send_string_async_busy()) break;
+        send_string_async_task();
+    }
+}
+#endif
@@ -24,6 +24,7 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #include "progmem.h"
 #include "send_string_keycodes.h"
@@ -161,4 +162,98 @@ void send_string_with_delay_P(const char *string, uint8_t interval);
  */
 #define SEND_STRING_DELAY(string, interval) send_string_with_delay_P(PSTR(string), interval)
 
+
+#if defined(SEND_STRING_ASYNC_ENABLE) || defined(__DOXYGEN__)
+/**
+ * \brief Queue a string of ASCII characters to be typed out in the background.
+ *
+ * This function simply calls `send_string_async_with_delay(string, TAP_CODE_DELAY)`.
+ *
+ * \param string The string to type out. It is read as it is being typed, so it must stay valid until `send_string_async_busy()` returns false.
+ *
+ * \return false if the string could not be queued, because the previous one is still being read.
+ */
+bool send_string_async(const char *string);
+
+/**
+ * \brief Queue a string of ASCII characters to be typed out in the background, with a delay between each character.
+ *
+ * The keystrokes are sent by `send_string_async_task()`, one report at a time, rather than by waiting in between them.
+ *
+ * \param string The string to type out. It is read as it is being typed, so it must stay valid until `send_string_async_busy()` returns false.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ *
+ * \return false if the string could not be queued, because the previous one is still being read.
+ */
+bool send_string_async_with_delay(const char *string, uint8_t interval);
+
+#    if defined(__AVR__) || defined(__DOXYGEN__)
+/**
+ * \brief Queue a PROGMEM string of ASCII characters to be typed out in the background.
+ *
+ * On ARM devices, this function is simply an alias for send_string_async_with_delay(string, 0).
+ *
+ * \param string The string to type out.
+ *
+ * \return false if the string could not be queued, because the previous one is still being read.
+ */
+bool send_string_async_P(const char *string);
+
+/**
+ * \brief Queue a PROGMEM string of ASCII characters to be typed out in the background, with a delay between each character.
+ *
+ * On ARM devices, this function is simply an alias for send_string_async_with_delay(string, interval).
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ *
+ * \return false if the string could not be queued, because the previous one is still being read.
+ */
+bool send_string_async_with_delay_P(const char *string, uint8_t interval);
+#    else
+#        define send_string_async_P(string) send_string_async_with_delay(string, 0)
+#        define send_string_async_with_delay_P(string, interval) send_string_async_with_delay(string, interval)
+#    endif
+
+/**
+ * \brief Check whether any queued keystrokes have yet to be sent.
+ */
+bool send_string_async_busy(void);
+
+/**
+ * \brief Send all queued keystrokes right away, waiting in between them as needed.
+ *
+ * The blocking functions above call this first, so that their keystrokes never get mixed up with queued ones.
+ */
+void send_string_async_flush(void);
+
+/**
+ * \brief Send the next queued keystroke, once its delay has passed and the host is ready for it.
+ *
+ * This is called from the keyboard task, and sends at most one report per call.
+ */
+void send_string_async_task(void);
+
+/**
+ * \brief Check whether the host is ready for the next keyboard report.
+ *
+ * The default implementation returns `host_keyboard_ready()`, so that keystrokes are held back until the previous report has been sent, on protocols which can tell.
+ */
+bool send_string_async_ready(void);
+
+/**
+ * \brief Shortcut macro for send_string_async_with_delay_P(PSTR(string), 0).
+ *
+ * On ARM devices, this define evaluates to send_string_async_with_delay(string, 0).
+ */
+#    define SEND_STRING_ASYNC(string) send_string_async_with_delay_P(PSTR(string), 0)
+
+/**
+ * \brief Shortcut macro for send_string_async_with_delay_P(PSTR(string), interval).
+ *
+ * On ARM devices, this define evaluates to send_string_async_with_delay(string, interval).
+ */
+#    define SEND_STRING_ASYNC_DELAY(string, interval) send_string_async_with_delay_P(PSTR(string), interval)
+#endif
+
 /** \} */
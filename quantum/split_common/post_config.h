@@ -8,3 +8,8 @@
 #        define F_SCL 100000UL // SCL frequency
 #    endif
 #endif
+
+#if defined(SPLIT_TRANSPORT_ASYNC) && !defined(SPLIT_TRANSPORT_BATCHED)
+// Asynchronous exchanges are built on top of the batched transport.
+#    define SPLIT_TRANSPORT_BATCHED
+#endif
@@ -0,0 +1,22 @@
+split_transport_async_DEFS := \
+	-DMATRIX_ROWS=4 \
+	-DMATRIX_COLS=8 \
+	-DNO_DEBUG \
+	-DSPLIT_KEYBOARD \
+	-DSPLIT_TRANSPORT_ASYNC \
+	-DSPLIT_TRANSPORT_ASYNC_TIMEOUT=20 \
+	-DSPLIT_TRANSPORT_BATCHED \
+	-DSPLIT_TRANSPORT_STATS \
+	-DSPLIT_LED_STATE_ENABLE \
+	-DDISABLE_SYNC_TIMER
+split_transport_async_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(QUANTUM_PATH)/split_common/transactions.c \
+	$(QUANTUM_PATH)/split_common/transport.c \
+	$(QUANTUM_PATH)/split_common/tests/serial_loopback.c \
+	$(QUANTUM_PATH)/split_common/tests/split_transport_async.cpp
+split_transport_async_INC := \
+	$(QUANTUM_PATH)/split_common \
+	$(QUANTUM_PATH)/split_common/tests \
+	$(DRIVER_PATH)
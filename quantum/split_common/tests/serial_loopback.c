@@ -0,0 +1,111 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "serial_loopback.h"
+#include "serial.h"
+#include "transactions.h"
+#include "transport.h"
+
+static split_shared_memory_t    target_shmem;
+static uint8_t                  in_flight_data[sizeof(split_shared_memory_t)];
+static int8_t                   in_flight_id       = -1;
+static transport_async_status_t in_flight_status   = TRANSPORT_ASYNC_IDLE;
+static bool                     modified_in_flight = false;
+static uint8_t                  fail_count         = 0;
+static uint32_t                 transaction_count  = 0;
+
+static void swap_shmem(void) {
+    split_shared_memory_t temp;
+    memcpy(&temp, split_shmem, sizeof(temp));
+    memcpy(split_shmem, &target_shmem, sizeof(temp));
+    memcpy(&target_shmem, &temp, sizeof(temp));
+}
+
+static bool react(int index) {
+    if (fail_count > 0) {
+        fail_count--;
+        return false;
+    }
+
+    split_transaction_desc_t *trans = &split_transaction_table[index];
+    memcpy((uint8_t *)&target_shmem + trans->initiator2target_offset, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+    if (trans->slave_callback) {
+        swap_shmem();
+        trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+        swap_shmem();
+    }
+    memcpy(split_trans_target2initiator_buffer(trans), (uint8_t *)&target_shmem + trans->target2initiator_offset, trans->target2initiator_buffer_size);
+    transaction_count++;
+    return true;
+}
+
+void soft_serial_initiator_init(void) {}
+
+void soft_serial_target_init(void) {}
+
+bool soft_serial_transaction(int index) {
+    return react(index);
+}
+
+bool soft_serial_transaction_begin(int index) {
+    if (in_flight_id >= 0) {
+        return false;
+    }
+
+    split_transaction_desc_t *trans = &split_transaction_table[index];
+    memcpy(in_flight_data, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+    in_flight_id     = index;
+    in_flight_status = TRANSPORT_ASYNC_BUSY;
+    return true;
+}
+
+transport_async_status_t soft_serial_transaction_poll(void) {
+    return in_flight_status;
+}
+
+void loopback_reset(void) {
+    modified_in_flight = false;
+    fail_count         = 0;
+    transaction_count  = 0;
+    split_transport_reset_stats();
+}
+
+void loopback_fail_next(uint8_t count) {
+    fail_count = count;
+}
+
+bool loopback_in_flight(void) {
+    return in_flight_id >= 0;
+}
+
+void loopback_complete(bool success) {
+    if (in_flight_id < 0) {
+        return;
+    }
+
+    split_transaction_desc_t *trans = &split_transaction_table[in_flight_id];
+    if (memcmp(in_flight_data, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size) != 0) {
+        modified_in_flight = true;
+    }
+    in_flight_status = success && react(in_flight_id) ? TRANSPORT_ASYNC_SUCCESS : TRANSPORT_ASYNC_FAILED;
+    in_flight_id     = -1;
+}
+
+uint32_t loopback_transaction_count(void) {
+    return transaction_count;
+}
+
+uint32_t loopback_stale_scans(void) {
+    return split_transport_stats.stale_scans;
+}
+
+bool loopback_modified_in_flight(void) {
+    return modified_in_flight;
+}
+
+void loopback_slave_scan(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    swap_shmem();
+    transactions_slave(master_matrix, slave_matrix);
+    swap_shmem();
+}
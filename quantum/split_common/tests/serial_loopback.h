@@ -0,0 +1,55 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "matrix.h"
+
+/*
+    Loopback serial driver, connecting the master to a slave within the same process.
+
+    The slave keeps a shared memory of its own, which is swapped in whenever the slave side runs, so that both halves
+    use the real transaction handlers. Transactions started in the background stay in flight until completed by
+    loopback_complete(), standing in for the driver's thread picking up the slave's reply.
+*/
+
+/**
+ * Resets the counters, including the transport's, and pending failures, leaving any transaction in flight.
+ */
+void loopback_reset(void);
+
+/**
+ * Fails the given number of transactions, without them reaching the slave.
+ */
+void loopback_fail_next(uint8_t count);
+
+/**
+ * @return whether a transaction started in the background is still in flight
+ */
+bool loopback_in_flight(void);
+
+/**
+ * Completes the transaction in flight, handing it to the slave if successful.
+ */
+void loopback_complete(bool success);
+
+/**
+ * @return the number of transactions which reached the slave
+ */
+uint32_t loopback_transaction_count(void);
+
+/**
+ * @return the number of scans which reused the slave's data from an earlier exchange
+ */
+uint32_t loopback_stale_scans(void);
+
+/**
+ * @return whether the master changed the data of a transaction while it was in flight
+ */
+bool loopback_modified_in_flight(void);
+
+/**
+ * Runs a scan of the slave half.
+ */
+void loopback_slave_scan(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
@@ -0,0 +1,160 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "serial_loopback.h"
+
+bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
+void advance_time(uint32_t ms);
+}
+
+#define ROWS_PER_HAND (MATRIX_ROWS / 2)
+
+static uint8_t master_leds;
+static uint8_t slave_leds;
+
+extern "C" {
+uint8_t host_keyboard_leds(void) {
+    return master_leds;
+}
+
+void set_split_host_keyboard_leds(uint8_t led_state) {
+    slave_leds = led_state;
+}
+
+bool is_transport_connected(void) {
+    return true;
+}
+}
+
+class SplitTransportAsync : public ::testing::Test {
+   protected:
+    matrix_row_t master_matrix[ROWS_PER_HAND]   = {0}; // the master's own rows
+    matrix_row_t received_matrix[ROWS_PER_HAND] = {0}; // the slave's rows, as seen by the master
+    matrix_row_t slave_matrix[ROWS_PER_HAND]    = {0}; // the slave's own rows
+    matrix_row_t unused_matrix[ROWS_PER_HAND]   = {0};
+
+    void SetUp() override {
+        master_leds = 0;
+        slave_leds  = 0;
+
+        // Bring both halves in sync, which leaves an exchange in flight just like any other scan does
+        loopback_complete(true);
+        for (int i = 0; i < 4; ++i) {
+            scan();
+        }
+        loopback_reset();
+    }
+
+    // Runs a scan of both halves, completing the exchange started by the master in the background if requested
+    bool scan(bool complete = true) {
+        loopback_slave_scan(unused_matrix, slave_matrix);
+        bool okay = transactions_master(master_matrix, received_matrix);
+        if (complete) {
+            loopback_complete(true);
+        }
+        advance_time(1);
+        return okay;
+    }
+};
+
+/**
+ * This test verifies that the slave's matrix reaches the master with exactly one scan of latency.
+ */
+TEST_F(SplitTransportAsync, SlaveMatrix_OneScanLatency) {
+    slave_matrix[0] = 0x5A;
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(received_matrix[0], 0) << "Master should see the result of the previous exchange";
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(received_matrix[0], 0x5A) << "Master should see the slave's matrix one scan later";
+}
+
+/**
+ * This test verifies that scans carry on with the last received data while an exchange is in flight.
+ */
+TEST_F(SplitTransportAsync, InFlight_DoesNotBlock) {
+    slave_matrix[0] = 0x01;
+    EXPECT_TRUE(scan());
+    EXPECT_TRUE(scan(false));
+    EXPECT_EQ(received_matrix[0], 0x01);
+
+    slave_matrix[0] = 0x02;
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(scan(false)) << "Scan " << i << " should succeed within the timeout";
+        EXPECT_EQ(received_matrix[0], 0x01) << "Scan " << i << " should reuse the last received data";
+    }
+    EXPECT_EQ(loopback_transaction_count(), 1) << "No further exchange should start while one is in flight";
+    EXPECT_EQ(loopback_stale_scans(), 5);
+
+    // The slave replies with its state at the time the exchange reaches it
+    loopback_complete(true);
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(received_matrix[0], 0x02);
+    EXPECT_EQ(loopback_stale_scans(), 5);
+}
+
+/**
+ * This test verifies that writes reach the slave, including those made while an exchange is in flight.
+ */
+TEST_F(SplitTransportAsync, Writes_ReachSlave) {
+    master_leds = 0x05;
+    EXPECT_TRUE(scan());
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(slave_leds, 0x05);
+
+    EXPECT_TRUE(scan(false));
+    master_leds = 0x07;
+    EXPECT_TRUE(scan(false));
+    EXPECT_TRUE(scan(false));
+    EXPECT_EQ(slave_leds, 0x05) << "Slave should not see writes made while an exchange is in flight";
+
+    loopback_complete(true);
+    EXPECT_TRUE(scan());
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(slave_leds, 0x07);
+}
+
+/**
+ * This test verifies that writes lost with a failed exchange are sent again with the next one.
+ */
+TEST_F(SplitTransportAsync, FailedExchange_WritesRequeued) {
+    loopback_complete(true);
+    master_leds = 0x03;
+    EXPECT_TRUE(scan(false));
+    loopback_complete(false);
+
+    EXPECT_FALSE(scan()) << "Failed exchange should be reported";
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(slave_leds, 0x03) << "Write should be sent again without waiting for a forced sync";
+}
+
+/**
+ * This test verifies that an exchange which takes too long fails every scan until it completes.
+ */
+TEST_F(SplitTransportAsync, SlowExchange_TimesOut) {
+    EXPECT_TRUE(scan(false));
+    advance_time(SPLIT_TRANSPORT_ASYNC_TIMEOUT);
+    EXPECT_FALSE(scan(false));
+    EXPECT_FALSE(scan(false));
+
+    loopback_complete(true);
+    EXPECT_TRUE(scan());
+    EXPECT_TRUE(scan());
+}
+
+/**
+ * This test verifies that the frame in flight is left alone by the master, however many writes it makes in the meantime.
+ */
+TEST_F(SplitTransportAsync, FrameInFlight_NotModified) {
+    for (int i = 0; i < 20; ++i) {
+        master_leds = i;
+        EXPECT_TRUE(scan(i % 4 == 0));
+    }
+    loopback_complete(true);
+    EXPECT_FALSE(loopback_modified_in_flight());
+
+    EXPECT_TRUE(scan());
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(slave_leds, 19);
+}
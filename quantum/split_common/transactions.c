@@ -24,6 +24,7 @@
 #include "host.h"
 #include "action_util.h"
 #include "sync_timer.h"
+#include "util.h"
 #include "wait.h"
 #include "transactions.h"
 #include "transport.h"
@@ -84,8 +85,16 @@
 #define trans_initiator2target_cb(cb) \
     { 0, 0, 0, 0, cb }
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
-#define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
+#ifdef SPLIT_TRANSPORT_BATCHED
+// Writes and reads go through the batch, which falls back to individual transactions outside of transactions_master()
+static bool batch_write(int8_t id, const void *data, uint16_t length);
+static bool batch_read(int8_t id, void *data, uint16_t length);
+#    define transport_write(id, data, length) batch_write(id, data, length)
+#    define transport_read(id, data, length) batch_read(id, data, length)
+#else
+#    define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
+#    define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
+#endif // SPLIT_TRANSPORT_BATCHED
 #define transport_exec(id) transport_execute_transaction(id, NULL, 0, NULL, 0)
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -914,6 +923,324 @@ static void detected_os_handlers_slave(matrix_row_t master_matrix[], matrix_row_
 
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+////////////////////////////////////////////////////
+// Batched transport
+
+#ifdef SPLIT_TRANSPORT_BATCHED
+
+/*
+ * Within transactions_master(), writes are not sent right away but appended to a frame as segments of
+ * [transaction id, offset, length, data...], covering only the bytes which differ from what was last sent. The frame
+ * is sent in a single exchange, which also returns the slave's current matrix and checksums so that the reads that
+ * follow need no round trip of their own unless the slave's data has changed.
+ */
+
+#    define BATCH_SEGMENT_HEADER_SIZE 3
+
+// Target to initiator data returned with every exchange, in order, as long as it fits
+static const int8_t batch_prefetch_ids[] = {
+    GET_SLAVE_MATRIX_CHECKSUM,
+    GET_SLAVE_MATRIX_DATA,
+#    ifdef ENCODER_ENABLE
+    GET_ENCODERS_CHECKSUM,
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    GET_POINTING_CHECKSUM,
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+};
+
+static struct {
+    bool     active;
+    bool     prefetch_due;
+    uint8_t  length;     // bytes of segments within frame, after the length byte
+    uint32_t pending;    // transactions with segments in the current frame
+    uint32_t prefetched; // transactions whose target to initiator data can be read without a round trip
+    uint32_t received;   // transactions whose target to initiator data was received with the last exchange
+    uint32_t resync;     // transactions which must be sent in full, as the slave may have missed an earlier segment
+    uint32_t requeue;    // transactions which must be sent again from the shared memory, as their segment was lost
+    uint8_t  frame[SPLIT_TRANSPORT_BATCH_SIZE];
+} batch = {.resync = UINT32_MAX};
+
+static uint8_t batch_status_length(void) {
+    uint8_t length = 1;
+    for (uint8_t i = 0; i < ARRAY_SIZE(batch_prefetch_ids); ++i) {
+        uint8_t size = split_transaction_table[batch_prefetch_ids[i]].target2initiator_buffer_size;
+        if (length + size + 1 > SPLIT_TRANSPORT_BATCH_SIZE) {
+            break;
+        }
+        length += size;
+    }
+    return length;
+}
+
+static void batch_append(int8_t id, const uint8_t *source, uint8_t start, uint8_t end) {
+    uint8_t *segment = &batch.frame[batch.length + 1];
+    segment[0]       = id;
+    segment[1]       = start;
+    segment[2]       = end - start;
+    memcpy(&segment[BATCH_SEGMENT_HEADER_SIZE], &source[start], end - start);
+    batch.length += BATCH_SEGMENT_HEADER_SIZE + end - start;
+    batch.frame[0] = batch.length;
+    batch.pending |= (1UL << id);
+    batch.requeue &= ~(1UL << id);
+}
+
+static void batch_reset(void) {
+    batch.pending  = 0;
+    batch.length   = 0;
+    batch.frame[0] = 0;
+}
+
+static uint8_t batch_seal(void) {
+    batch.frame[batch.length + 1] = crc8(batch.frame, batch.length + 1);
+    return batch.frame[batch.length + 1];
+}
+
+static bool batch_receive(const uint8_t *status, uint8_t crc) {
+    uint8_t status_length = batch_status_length();
+    if (status[0] != crc || status[status_length] != crc8(status, status_length)) {
+        return false;
+    }
+
+    // Populate the shared memory just like the individual reads would have
+    const uint8_t *data = &status[1];
+    batch.received      = 0;
+    for (uint8_t i = 0; i < ARRAY_SIZE(batch_prefetch_ids) && data < &status[status_length]; ++i) {
+        split_transaction_desc_t *trans = &split_transaction_table[batch_prefetch_ids[i]];
+        memcpy(split_trans_target2initiator_buffer(trans), data, trans->target2initiator_buffer_size);
+        data += trans->target2initiator_buffer_size;
+        batch.received |= (1UL << batch_prefetch_ids[i]);
+    }
+    batch.prefetched   = batch.received;
+    batch.prefetch_due = false;
+    return true;
+}
+
+#    ifndef SPLIT_TRANSPORT_ASYNC
+static bool batch_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    if (!batch.pending && !batch.prefetch_due) {
+        return true;
+    }
+
+    uint8_t crc = batch_seal();
+    uint8_t status[SPLIT_TRANSPORT_BATCH_SIZE];
+    if (!transport_execute_transaction(EXCHANGE_BATCH, batch.frame, batch.length + 2, status, batch_status_length() + 1)) {
+        return false;
+    }
+    if (!batch_receive(status, crc)) {
+        return false;
+    }
+
+    batch.resync &= ~batch.pending;
+    batch_reset();
+    return true;
+}
+#    endif // SPLIT_TRANSPORT_ASYNC
+
+static void batch_handlers_slave(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    const uint8_t *frame  = (const uint8_t *)initiator2target_buffer;
+    uint8_t       *status = (uint8_t *)target2initiator_buffer;
+    uint8_t        end    = frame[0] + 1;
+
+    // Acknowledge the frame with its checksum, or anything but if it was not applied
+    uint8_t crc = crc8(frame, end < initiator2target_buffer_size ? end : initiator2target_buffer_size);
+    if (end < initiator2target_buffer_size && frame[end] == crc) {
+        for (uint8_t i = 1; i + BATCH_SEGMENT_HEADER_SIZE <= end;) {
+            int8_t  id     = frame[i];
+            uint8_t offset = frame[i + 1];
+            uint8_t length = frame[i + 2];
+            if (id < 0 || id >= NUM_TOTAL_TRANSACTIONS || offset + length > split_transaction_table[id].initiator2target_buffer_size || i + BATCH_SEGMENT_HEADER_SIZE + length > end) {
+                break;
+            }
+            memcpy(split_trans_initiator2target_buffer(&split_transaction_table[id]) + offset, &frame[i + BATCH_SEGMENT_HEADER_SIZE], length);
+            i += BATCH_SEGMENT_HEADER_SIZE + length;
+        }
+        status[0] = crc;
+    } else {
+        status[0] = ~crc;
+    }
+
+    uint8_t status_length = batch_status_length();
+    uint8_t length        = 1;
+    for (uint8_t i = 0; i < ARRAY_SIZE(batch_prefetch_ids) && length < status_length; ++i) {
+        split_transaction_desc_t *trans = &split_transaction_table[batch_prefetch_ids[i]];
+        memcpy(&status[length], split_trans_target2initiator_buffer(trans), trans->target2initiator_buffer_size);
+        length += trans->target2initiator_buffer_size;
+    }
+    status[status_length] = crc8(status, status_length);
+}
+
+static bool batch_write(int8_t id, const void *data, uint16_t length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (!batch.active || trans->slave_callback) {
+        return transport_execute_transaction(id, data, length, NULL, 0);
+    }
+
+    const uint8_t *source = (const uint8_t *)data;
+    uint8_t       *shadow = split_trans_initiator2target_buffer(trans);
+    uint8_t        size   = trans->initiator2target_buffer_size < length ? trans->initiator2target_buffer_size : length;
+    uint8_t        start  = 0;
+    uint8_t        end    = size;
+    if (!(batch.resync & (1UL << id))) {
+        // Only send what changed since the last write, anything else is already on the slave
+        while (start < end && source[start] == shadow[start]) {
+            ++start;
+        }
+        while (end > start && source[end - 1] == shadow[end - 1]) {
+            --end;
+        }
+        if (start == end) {
+            // Forced sync of unchanged data, send it in full in case the slave lost it
+            start = 0;
+            end   = size;
+        }
+    }
+
+    uint8_t segment_size = BATCH_SEGMENT_HEADER_SIZE + end - start;
+    if (segment_size + 2 > SPLIT_TRANSPORT_BATCH_SIZE) {
+        return transport_execute_transaction(id, data, length, NULL, 0);
+    }
+    if (batch.length + segment_size + 2 > SPLIT_TRANSPORT_BATCH_SIZE) {
+#    ifdef SPLIT_TRANSPORT_ASYNC
+        // The line may be busy with the previous frame, so send this one in full with the next frame instead
+        memcpy(shadow, source, size);
+        batch.requeue |= (1UL << id);
+        batch.resync |= (1UL << id);
+        return true;
+#    else
+        if (!transaction_handler_master(NULL, NULL, "batch", &batch_handlers_master)) {
+            return false;
+        }
+#    endif // SPLIT_TRANSPORT_ASYNC
+    }
+
+    memcpy(shadow, source, size);
+    batch_append(id, source, start, end);
+    SPLIT_TRANSPORT_STATS_INC(batched_writes);
+    return true;
+}
+
+// Appends the transactions whose segments were lost, from what was last written to the shared memory
+static void batch_requeue(void) {
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS && batch.requeue; ++id) {
+        if (!(batch.requeue & (1UL << id))) {
+            continue;
+        }
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        if (batch.length + BATCH_SEGMENT_HEADER_SIZE + trans->initiator2target_buffer_size + 2 > SPLIT_TRANSPORT_BATCH_SIZE) {
+            break;
+        }
+        batch_append(id, split_trans_initiator2target_buffer(trans), 0, trans->initiator2target_buffer_size);
+    }
+}
+
+static bool batch_read(int8_t id, void *data, uint16_t length) {
+    if (!(batch.prefetched & (1UL << id))) {
+        return transport_execute_transaction(id, NULL, 0, data, length);
+    }
+
+    // Already received with the last exchange
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    memcpy(data, split_trans_target2initiator_buffer(trans), trans->target2initiator_buffer_size < length ? trans->target2initiator_buffer_size : length);
+    batch.prefetched &= ~(1UL << id);
+    SPLIT_TRANSPORT_STATS_INC(prefetched_reads);
+    return true;
+}
+
+static void batch_begin(void) {
+    batch.active       = true;
+    batch.prefetch_due = true;
+    batch.prefetched   = 0;
+    if (!is_transport_connected()) {
+        // The slave may have restarted in the meantime
+        batch.resync = UINT32_MAX;
+    }
+}
+
+static void batch_end(void) {
+#    ifndef SPLIT_TRANSPORT_ASYNC
+    // Anything still pending was never acknowledged, so resend it in full next time
+    batch.resync |= batch.pending;
+    batch_reset();
+#    endif // SPLIT_TRANSPORT_ASYNC
+    batch.prefetched = 0;
+    batch.active     = false;
+}
+
+#    ifdef SPLIT_TRANSPORT_ASYNC
+
+/*
+ * Every scan collects the result of the exchange started by the previous one, then starts the next exchange with the
+ * writes of this scan, so that the round trip overlaps with everything else the master does in between.
+ *
+ * The slave's data is therefore one scan old. While an exchange is still in flight, the data received with the last
+ * completed exchange is used again, and writes keep collecting in the frame for the next exchange. An exchange that
+ * takes longer than SPLIT_TRANSPORT_ASYNC_TIMEOUT milliseconds fails each scan until it completes, counting towards
+ * SPLIT_MAX_CONNECTION_ERRORS. Segments of a failed exchange are sent again in full with the next one.
+ */
+static struct {
+    bool     in_flight;
+    uint8_t  crc;     // checksum of the frame in flight
+    uint32_t pending; // transactions with segments in the frame in flight
+    uint32_t started;
+} async;
+
+// Returns whether the slave's data was received during this scan, okay is cleared on failure
+static bool batch_collect(bool *okay) {
+    if (!async.in_flight) {
+        return false;
+    }
+
+    uint8_t                  status[SPLIT_TRANSPORT_BATCH_SIZE];
+    bool                     fresh  = false;
+    transport_async_status_t result = transport_poll_transaction(status, batch_status_length() + 1);
+    if (result == TRANSPORT_ASYNC_BUSY) {
+        *okay = timer_elapsed32(async.started) < SPLIT_TRANSPORT_ASYNC_TIMEOUT;
+        return false;
+    }
+
+    async.in_flight = false;
+    if (result == TRANSPORT_ASYNC_SUCCESS && batch_receive(status, async.crc)) {
+        batch.resync &= ~async.pending;
+        fresh = true;
+    } else {
+        batch.resync |= async.pending;
+        batch.requeue |= async.pending;
+        *okay = false;
+    }
+    return fresh;
+}
+
+static void batch_start(void) {
+    if (async.in_flight) {
+        return;
+    }
+
+    uint8_t crc = batch_seal();
+    if (transport_begin_transaction(EXCHANGE_BATCH, batch.frame, batch.length + 2)) {
+        async.in_flight = true;
+        async.crc       = crc;
+        async.pending   = batch.pending;
+        async.started   = timer_read32();
+        batch_reset();
+    }
+}
+
+#    endif // SPLIT_TRANSPORT_ASYNC
+
+// clang-format off
+#    define TRANSACTIONS_BATCH_MASTER() TRANSACTION_HANDLER_MASTER(batch)
+#    define TRANSACTIONS_BATCH_REGISTRATIONS \
+    [EXCHANGE_BATCH] = { sizeof_member(split_shared_memory_t, batch.frame), offsetof(split_shared_memory_t, batch.frame), sizeof_member(split_shared_memory_t, batch.status), offsetof(split_shared_memory_t, batch.status), batch_handlers_slave },
+// clang-format on
+
+#else // SPLIT_TRANSPORT_BATCHED
+
+#    define TRANSACTIONS_BATCH_MASTER()
+#    define TRANSACTIONS_BATCH_REGISTRATIONS
+
+#endif // SPLIT_TRANSPORT_BATCHED
+
 ////////////////////////////////////////////////////
 
 split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
@@ -944,6 +1271,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_HAPTIC_REGISTRATIONS
     TRANSACTIONS_ACTIVITY_REGISTRATIONS
     TRANSACTIONS_DETECTED_OS_REGISTRATIONS
+    TRANSACTIONS_BATCH_REGISTRATIONS
 // clang-format on
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -954,7 +1282,86 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 };
 
+#if defined(SPLIT_TRANSPORT_ASYNC)
+
+static bool transactions_master_async(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    bool okay  = true;
+    bool fresh = batch_collect(&okay);
+    if (!fresh) {
+        // Serve the reads from the last exchange that did complete
+        batch.prefetched = batch.received;
+        SPLIT_TRANSPORT_STATS_INC(stale_scans);
+    }
+
+    batch_requeue();
+    TRANSACTIONS_MASTER_MATRIX_MASTER();
+    TRANSACTIONS_SYNC_TIMER_MASTER();
+    TRANSACTIONS_LAYER_STATE_MASTER();
+    TRANSACTIONS_LED_STATE_MASTER();
+    TRANSACTIONS_MODS_MASTER();
+    TRANSACTIONS_BACKLIGHT_MASTER();
+    TRANSACTIONS_RGBLIGHT_MASTER();
+    TRANSACTIONS_LED_MATRIX_MASTER();
+    TRANSACTIONS_RGB_MATRIX_MASTER();
+    TRANSACTIONS_WPM_MASTER();
+    TRANSACTIONS_OLED_MASTER();
+    TRANSACTIONS_ST7565_MASTER();
+    TRANSACTIONS_WATCHDOG_MASTER();
+    TRANSACTIONS_HAPTIC_MASTER();
+    TRANSACTIONS_ACTIVITY_MASTER();
+    TRANSACTIONS_DETECTED_OS_MASTER();
+    TRANSACTIONS_SLAVE_MATRIX_MASTER();
+    if (fresh) {
+        // Anything else would need a round trip of its own to catch up, so wait for fresh data
+        TRANSACTIONS_ENCODERS_MASTER();
+        TRANSACTIONS_POINTING_MASTER();
+    }
+    batch_start();
+    return okay;
+}
+
+#elif defined(SPLIT_TRANSPORT_BATCHED)
+
+static bool transactions_master_batched(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    // Writes first, so that they are sent together with the exchange that prefetches the slave's data for the reads
+    TRANSACTIONS_MASTER_MATRIX_MASTER();
+    TRANSACTIONS_SYNC_TIMER_MASTER();
+    TRANSACTIONS_LAYER_STATE_MASTER();
+    TRANSACTIONS_LED_STATE_MASTER();
+    TRANSACTIONS_MODS_MASTER();
+    TRANSACTIONS_BACKLIGHT_MASTER();
+    TRANSACTIONS_RGBLIGHT_MASTER();
+    TRANSACTIONS_LED_MATRIX_MASTER();
+    TRANSACTIONS_RGB_MATRIX_MASTER();
+    TRANSACTIONS_WPM_MASTER();
+    TRANSACTIONS_OLED_MASTER();
+    TRANSACTIONS_ST7565_MASTER();
+    TRANSACTIONS_WATCHDOG_MASTER();
+    TRANSACTIONS_HAPTIC_MASTER();
+    TRANSACTIONS_ACTIVITY_MASTER();
+    TRANSACTIONS_DETECTED_OS_MASTER();
+    TRANSACTIONS_BATCH_MASTER();
+    TRANSACTIONS_SLAVE_MATRIX_MASTER();
+    TRANSACTIONS_ENCODERS_MASTER();
+    TRANSACTIONS_POINTING_MASTER();
+    // Send anything written by the readers
+    TRANSACTIONS_BATCH_MASTER();
+    return true;
+}
+
+#endif // defined(SPLIT_TRANSPORT_ASYNC)
+
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#ifdef SPLIT_TRANSPORT_BATCHED
+    batch_begin();
+#    ifdef SPLIT_TRANSPORT_ASYNC
+    bool okay = transactions_master_async(master_matrix, slave_matrix);
+#    else
+    bool okay = transactions_master_batched(master_matrix, slave_matrix);
+#    endif // SPLIT_TRANSPORT_ASYNC
+    batch_end();
+    return okay;
+#else
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
     TRANSACTIONS_MASTER_MATRIX_MASTER();
     TRANSACTIONS_ENCODERS_MASTER();
@@ -975,6 +1382,7 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_ACTIVITY_MASTER();
     TRANSACTIONS_DETECTED_OS_MASTER();
     return true;
+#endif // SPLIT_TRANSPORT_BATCHED
 }
 
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
@@ -22,6 +22,16 @@
 #include "transaction_id_define.h"
 #include "atomic_util.h"
 
+#ifdef SPLIT_TRANSPORT_STATS
+#    include "profiler_timestamp.h"
+
+split_transport_stats_t split_transport_stats;
+
+void split_transport_reset_stats(void) {
+    memset(&split_transport_stats, 0, sizeof(split_transport_stats));
+}
+#endif // SPLIT_TRANSPORT_STATS
+
 #ifdef USE_I2C
 
 #    ifndef SLAVE_I2C_TIMEOUT
@@ -62,22 +72,26 @@ i2c_status_t transport_trigger_callback(int8_t id) {
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
     i2c_status_t              status;
     split_transaction_desc_t *trans = &split_transaction_table[id];
+    SPLIT_TRANSPORT_STATS_INC(transactions);
     if (initiator2target_length > 0) {
         size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
         memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
         if ((status = i2c_write_register(SLAVE_I2C_ADDRESS, trans->initiator2target_offset, split_trans_initiator2target_buffer(trans), len, SLAVE_I2C_TIMEOUT)) < 0) {
+            SPLIT_TRANSPORT_STATS_INC(failures);
             return false;
         }
     }
 
     // If we need to execute a callback on the slave, do so
     if ((status = transport_trigger_callback(id)) < 0) {
+        SPLIT_TRANSPORT_STATS_INC(failures);
         return false;
     }
 
     if (target2initiator_length > 0) {
         size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
         if ((status = i2c_read_register(SLAVE_I2C_ADDRESS, trans->target2initiator_offset, split_trans_target2initiator_buffer(trans), len, SLAVE_I2C_TIMEOUT)) < 0) {
+            SPLIT_TRANSPORT_STATS_INC(failures);
             return false;
         }
         memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
@@ -86,6 +100,29 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
     return true;
 }
 
+#    ifdef SPLIT_TRANSPORT_ASYNC
+// I2C transactions are driven by the master alone, so they complete before transport_async_begin() returns
+static transport_async_status_t i2c_async_status = TRANSPORT_ASYNC_IDLE;
+
+static bool transport_async_begin(int8_t id, uint16_t initiator2target_length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    bool                      okay  = true;
+    if (initiator2target_length > 0) {
+        okay = i2c_write_register(SLAVE_I2C_ADDRESS, trans->initiator2target_offset, split_trans_initiator2target_buffer(trans), initiator2target_length, SLAVE_I2C_TIMEOUT) >= 0;
+    }
+    okay = okay && transport_trigger_callback(id) >= 0;
+    if (okay && trans->target2initiator_buffer_size > 0) {
+        okay = i2c_read_register(SLAVE_I2C_ADDRESS, trans->target2initiator_offset, split_trans_target2initiator_buffer(trans), trans->target2initiator_buffer_size, SLAVE_I2C_TIMEOUT) >= 0;
+    }
+    i2c_async_status = okay ? TRANSPORT_ASYNC_SUCCESS : TRANSPORT_ASYNC_FAILED;
+    return true;
+}
+
+static transport_async_status_t transport_async_poll(void) {
+    return i2c_async_status;
+}
+#    endif // SPLIT_TRANSPORT_ASYNC
+
 #else // USE_I2C
 
 #    include "serial.h"
@@ -102,12 +139,14 @@ void transport_slave_init(void) {
 
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
     split_transaction_desc_t *trans = &split_transaction_table[id];
+    SPLIT_TRANSPORT_STATS_INC(transactions);
     if (initiator2target_length > 0) {
         size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
         memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
     }
 
     if (!soft_serial_transaction(id)) {
+        SPLIT_TRANSPORT_STATS_INC(failures);
         return false;
     }
 
@@ -119,10 +158,84 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
     return true;
 }
 
+#    ifdef SPLIT_TRANSPORT_ASYNC
+// Drivers without a background thread of their own complete the transaction right away
+static transport_async_status_t serial_async_status = TRANSPORT_ASYNC_IDLE;
+
+__attribute__((weak)) bool soft_serial_transaction_begin(int index) {
+    serial_async_status = soft_serial_transaction(index) ? TRANSPORT_ASYNC_SUCCESS : TRANSPORT_ASYNC_FAILED;
+    return true;
+}
+
+__attribute__((weak)) transport_async_status_t soft_serial_transaction_poll(void) {
+    return serial_async_status;
+}
+
+static bool transport_async_begin(int8_t id, uint16_t initiator2target_length) {
+    return soft_serial_transaction_begin(id);
+}
+
+static transport_async_status_t transport_async_poll(void) {
+    return soft_serial_transaction_poll();
+}
+#    endif // SPLIT_TRANSPORT_ASYNC
+
 #endif // USE_I2C
 
+#ifdef SPLIT_TRANSPORT_ASYNC
+static int8_t async_id = -1;
+
+bool transport_begin_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length) {
+    if (async_id >= 0) {
+        return false;
+    }
+
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    size_t                    len   = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+    if (len > 0) {
+        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+    }
+
+    SPLIT_TRANSPORT_STATS_INC(transactions);
+    if (!transport_async_begin(id, len)) {
+        return false;
+    }
+    async_id = id;
+    return true;
+}
+
+transport_async_status_t transport_poll_transaction(void *target2initiator_buf, uint16_t target2initiator_length) {
+    if (async_id < 0) {
+        return TRANSPORT_ASYNC_IDLE;
+    }
+
+    transport_async_status_t status = transport_async_poll();
+    if (status == TRANSPORT_ASYNC_BUSY) {
+        return status;
+    }
+
+    split_transaction_desc_t *trans = &split_transaction_table[async_id];
+    if (status == TRANSPORT_ASYNC_SUCCESS && target2initiator_length > 0) {
+        size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+        memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+    } else if (status != TRANSPORT_ASYNC_SUCCESS) {
+        SPLIT_TRANSPORT_STATS_INC(failures);
+    }
+    async_id = -1;
+    return status;
+}
+#endif // SPLIT_TRANSPORT_ASYNC
+
 bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#ifdef SPLIT_TRANSPORT_STATS
+    uint32_t start = PROFILER_TIMESTAMP();
+    bool     okay  = transactions_master(master_matrix, slave_matrix);
+    split_transport_stats.sync_time += PROFILER_TIMESTAMP() - start;
+    split_transport_stats.scans++;
+    return okay;
+#else
     return transactions_master(master_matrix, slave_matrix);
+#endif // SPLIT_TRANSPORT_STATS
 }
 
 void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
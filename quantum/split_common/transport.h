@@ -31,6 +31,13 @@
 #    define RPC_S2M_BUFFER_SIZE 32
 #endif // RPC_S2M_BUFFER_SIZE
 
+#ifdef SPLIT_TRANSPORT_BATCHED
+#    ifndef SPLIT_TRANSPORT_BATCH_SIZE
+#        define SPLIT_TRANSPORT_BATCH_SIZE 32
+#    endif // SPLIT_TRANSPORT_BATCH_SIZE
+_Static_assert(SPLIT_TRANSPORT_BATCH_SIZE >= 8 && SPLIT_TRANSPORT_BATCH_SIZE <= 255, "SPLIT_TRANSPORT_BATCH_SIZE must be between 8 and 255");
+#endif // SPLIT_TRANSPORT_BATCHED
+
 void transport_master_init(void);
 void transport_slave_init(void);
 
@@ -40,6 +47,53 @@ void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
 
+#ifdef SPLIT_TRANSPORT_ASYNC
+#    ifndef SPLIT_TRANSPORT_ASYNC_TIMEOUT
+#        define SPLIT_TRANSPORT_ASYNC_TIMEOUT 20
+#    endif // SPLIT_TRANSPORT_ASYNC_TIMEOUT
+
+typedef enum {
+    TRANSPORT_ASYNC_IDLE,    // no transaction was started, or its result was already collected
+    TRANSPORT_ASYNC_BUSY,    // transaction still in flight
+    TRANSPORT_ASYNC_SUCCESS, // transaction complete, target to initiator data is available
+    TRANSPORT_ASYNC_FAILED,  // transaction complete, but failed
+} transport_async_status_t;
+
+/**
+ * Starts a transaction without waiting for its completion. The initiator to target data is copied before returning,
+ * only one transaction can be in flight at a time.
+ *
+ * @return false if a transaction is already in flight
+ */
+bool transport_begin_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length);
+
+/**
+ * Checks on the transaction started by transport_begin_transaction(), copying out the target to initiator data once it
+ * succeeded. A completed transaction's status is only reported once, after which the status is back to idle.
+ */
+transport_async_status_t transport_poll_transaction(void *target2initiator_buf, uint16_t target2initiator_length);
+#endif // SPLIT_TRANSPORT_ASYNC
+
+#ifdef SPLIT_TRANSPORT_STATS
+typedef struct _split_transport_stats_t {
+    uint32_t scans;            // calls to transport_master()
+    uint32_t sync_time;        // time spent within transport_master(), in PROFILER_TIMESTAMP() ticks
+    uint32_t transactions;     // round trips to the slave
+    uint32_t failures;         // round trips which failed
+    uint32_t batched_writes;   // writes sent as part of a batch rather than on their own
+    uint32_t prefetched_reads; // reads served from the batch response rather than on their own
+    uint32_t stale_scans;      // scans which had to reuse the slave's data from an earlier exchange
+} split_transport_stats_t;
+
+extern split_transport_stats_t split_transport_stats;
+
+void split_transport_reset_stats(void);
+
+#    define SPLIT_TRANSPORT_STATS_INC(field) split_transport_stats.field++
+#else
+#    define SPLIT_TRANSPORT_STATS_INC(field)
+#endif // SPLIT_TRANSPORT_STATS
+
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #endif // ENCODER_ENABLE
@@ -147,6 +201,13 @@ typedef struct _rpc_sync_info_t {
 #    include "os_detection.h"
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+#ifdef SPLIT_TRANSPORT_BATCHED
+typedef struct _split_batch_sync_t {
+    uint8_t frame[SPLIT_TRANSPORT_BATCH_SIZE];  // master to slave: length, segments, checksum
+    uint8_t status[SPLIT_TRANSPORT_BATCH_SIZE]; // slave to master: frame acknowledgement, prefetched data, checksum
+} split_batch_sync_t;
+#endif // SPLIT_TRANSPORT_BATCHED
+
 typedef struct _split_shared_memory_t {
 #ifdef USE_I2C
     int8_t transaction_id;
@@ -231,6 +292,10 @@ typedef struct _split_shared_memory_t {
 #if defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
     os_variant_t detected_os;
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
+
+#ifdef SPLIT_TRANSPORT_BATCHED
+    split_batch_sync_t batch;
+#endif // SPLIT_TRANSPORT_BATCHED
 } split_shared_memory_t;
 
 extern split_shared_memory_t *const split_shmem;
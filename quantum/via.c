@@ -57,6 +57,10 @@
 #    include "led_matrix.h"
 #endif
 
+#if defined(PROFILER_ENABLE)
+#    include "profiler.h"
+#endif
+
 // Can be called in an overriding via_init_kb() to test if keyboard level code usage of
 // EEPROM is invalid and use/save defaults.
 bool via_eeprom_is_valid(void) {
@@ -112,6 +116,10 @@ void eeconfig_init_via(void) {
     dynamic_keymap_reset();
     // This resets the macros in EEPROM to nothing.
     dynamic_keymap_macro_reset();
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    // Make sure the keymaps are in EEPROM before marking it valid
+    dynamic_keymap_flush();
+#endif
     // Save the magic number last, in case saving was interrupted
     via_eeprom_set_valid(true);
 }
@@ -120,12 +128,12 @@ void eeconfig_init_via(void) {
 // variable, between 1 and 4 bytes.
 uint32_t via_get_layout_options(void) {
     uint32_t value = 0;
+    uint8_t  buffer[VIA_EEPROM_LAYOUT_OPTIONS_SIZE];
+    eeprom_read_block(buffer, (void *)(VIA_EEPROM_LAYOUT_OPTIONS_ADDR), VIA_EEPROM_LAYOUT_OPTIONS_SIZE);
     // Start at the most significant byte
-    void *source = (void *)(VIA_EEPROM_LAYOUT_OPTIONS_ADDR);
     for (uint8_t i = 0; i < VIA_EEPROM_LAYOUT_OPTIONS_SIZE; i++) {
         value = value << 8;
-        value |= eeprom_read_byte(source);
-        source++;
+        value |= buffer[i];
     }
     return value;
 }
@@ -134,13 +142,13 @@ __attribute__((weak)) void via_set_layout_options_kb(uint32_t value) {}
 
 void via_set_layout_options(uint32_t value) {
     via_set_layout_options_kb(value);
+    uint8_t buffer[VIA_EEPROM_LAYOUT_OPTIONS_SIZE];
     // Start at the least significant byte
-    void *target = (void *)(VIA_EEPROM_LAYOUT_OPTIONS_ADDR + VIA_EEPROM_LAYOUT_OPTIONS_SIZE - 1);
-    for (uint8_t i = 0; i < VIA_EEPROM_LAYOUT_OPTIONS_SIZE; i++) {
-        eeprom_update_byte(target, value & 0xFF);
-        value = value >> 8;
-        target--;
+    for (int8_t i = VIA_EEPROM_LAYOUT_OPTIONS_SIZE - 1; i >= 0; i--) {
+        buffer[i] = value & 0xFF;
+        value     = value >> 8;
     }
+    eeprom_update_block(buffer, (void *)(VIA_EEPROM_LAYOUT_OPTIONS_ADDR), VIA_EEPROM_LAYOUT_OPTIONS_SIZE);
 }
 
 #if defined(AUDIO_ENABLE)
@@ -286,6 +294,13 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
         return;
     }
 
+#ifdef PROFILER_ENABLE
+    if (profiler_raw_hid_receive(data, length)) {
+        raw_hid_send(data, length);
+        return;
+    }
+#endif
+
     switch (*command_id) {
         case id_get_protocol_version: {
             command_data[0] = VIA_PROTOCOL_VERSION >> 8;
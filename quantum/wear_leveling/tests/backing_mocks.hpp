@@ -94,6 +94,7 @@ class MockBackingStore {
     std::uint64_t backing_init_invoke_count;
     std::uint64_t backing_unlock_invoke_count;
     std::uint64_t backing_erase_invoke_count;
+    std::uint64_t backing_erase_range_invoke_count;
     std::uint64_t backing_write_invoke_count;
     std::uint64_t backing_lock_invoke_count;
 
@@ -101,6 +102,8 @@ class MockBackingStore {
     std::function<bool(std::uint64_t)> init_success_callback;
     // Whether erase should succeed
     std::function<bool(std::uint64_t)> erase_success_callback;
+    // Whether range erases should succeed
+    std::function<bool(std::uint64_t, std::uint32_t)> erase_range_success_callback;
     // Whether unlocks should succeed
     std::function<bool(std::uint64_t)> unlock_success_callback;
     // Whether writes should succeed
@@ -141,6 +144,9 @@ class MockBackingStore {
     std::uint64_t erase_invoke_count() const {
         return backing_erase_invoke_count;
     }
+    std::uint64_t erase_range_invoke_count() const {
+        return backing_erase_range_invoke_count;
+    }
     std::uint64_t write_invoke_count() const {
         return backing_write_invoke_count;
     }
@@ -159,6 +165,7 @@ class MockBackingStore {
     bool init();
     bool unlock();
     bool erase();
+    bool erase_range(std::uint32_t address, std::uint32_t length);
     bool write(std::uint32_t address, backing_store_int_t value);
     bool lock();
     bool read(std::uint32_t address, backing_store_int_t& value) const;
@@ -170,6 +177,9 @@ class MockBackingStore {
     void set_erase_callback(std::function<bool(std::uint64_t)> callback) {
         erase_success_callback = callback;
     }
+    void set_erase_range_callback(std::function<bool(std::uint64_t, std::uint32_t)> callback) {
+        erase_range_success_callback = callback;
+    }
     void set_unlock_callback(std::function<bool(std::uint64_t)> callback) {
         unlock_success_callback = callback;
     }
@@ -0,0 +1,209 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+// Number of steps required for a complete consolidation, with no writes in between
+#define CONSOLIDATION_STEPS ((WEAR_LEVELING_BACKING_SIZE / 2) / WEAR_LEVELING_CONSOLIDATE_ERASE_SIZE + WEAR_LEVELING_LOGICAL_SIZE / WEAR_LEVELING_CONSOLIDATE_COPY_SIZE + 1)
+
+class WearLevelingIncremental : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+        verify_data.fill(0);
+        counter = 0;
+    }
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> verify_data;
+    std::uint8_t                                         counter;
+
+    wear_leveling_status_t test_write(const uint32_t address, const void* value, size_t length) {
+        memcpy(&verify_data[address], value, length);
+        return wear_leveling_write(address, value, length);
+    }
+
+    // Writes a new value to a single byte, consuming one 2-byte log entry
+    wear_leveling_status_t write_next(void) {
+        uint8_t value = ++counter;
+        return test_write(counter % WEAR_LEVELING_LOGICAL_SIZE, &value, sizeof(value));
+    }
+
+    // Fills the write log until background consolidation starts
+    void fill_to_threshold(void) {
+        const int entries = ((WEAR_LEVELING_BACKING_SIZE / 2) - WEAR_LEVELING_LOGICAL_SIZE - 16 - WEAR_LEVELING_CONSOLIDATE_THRESHOLD) / BACKING_STORE_WRITE_SIZE;
+        for (int i = 0; i < entries; ++i) {
+            EXPECT_EQ(write_next(), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+        }
+    }
+
+    void verify(void) {
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+        EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+        for (int i = 0; i < WEAR_LEVELING_LOGICAL_SIZE; ++i) {
+            EXPECT_EQ(readback[i], verify_data[i]) << "Invalid readback at offset " << i;
+        }
+    }
+
+    // Simulates a power loss, followed by a restart
+    void reinit_and_verify(void) {
+        EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Init returned incorrect status";
+        verify();
+    }
+};
+
+/**
+ * This test verifies that a clean backing store is consolidated into a valid bank on init, so that the write log survives a restart.
+ */
+TEST_F(WearLevelingIncremental, CleanStore_WritesSurviveRestart) {
+    EXPECT_GT(MockBackingStore::Instance().erase_range_invoke_count(), 0) << "Spare bank should have been erased";
+    EXPECT_EQ(MockBackingStore::Instance().erase_invoke_count(), 0) << "Backing store should not be erased in full";
+
+    EXPECT_EQ(write_next(), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    reinit_and_verify();
+}
+
+/**
+ * This test verifies that nothing happens until the write log reaches the threshold, and that consolidation then completes after a fixed number of steps.
+ */
+TEST_F(WearLevelingIncremental, Threshold_StartsConsolidation) {
+    auto& inst = MockBackingStore::Instance();
+    EXPECT_EQ(write_next(), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+
+    uint64_t write_count = inst.write_invoke_count();
+    EXPECT_EQ(wear_leveling_consolidate_step(), WEAR_LEVELING_SUCCESS) << "Idle step returned incorrect status";
+    EXPECT_EQ(inst.write_invoke_count(), write_count) << "Idle step should not write";
+
+    fill_to_threshold();
+    for (int i = 0; i < CONSOLIDATION_STEPS - 1; ++i) {
+        EXPECT_EQ(wear_leveling_consolidate_step(), WEAR_LEVELING_SUCCESS) << "Step " << i << " returned incorrect status";
+    }
+    EXPECT_EQ(wear_leveling_consolidate_step(), WEAR_LEVELING_CONSOLIDATED) << "Final step returned incorrect status";
+    EXPECT_TRUE(inst.is_locked()) << "Backing store should be locked after each step";
+    reinit_and_verify();
+}
+
+/**
+ * This test verifies that a power loss after any number of consolidation steps leaves the data intact.
+ */
+TEST_F(WearLevelingIncremental, InterruptedConsolidation_DataIntact) {
+    for (int steps = 0; steps <= CONSOLIDATION_STEPS; ++steps) {
+        SetUp();
+        fill_to_threshold();
+        for (int i = 0; i < steps; ++i) {
+            EXPECT_NE(wear_leveling_consolidate_step(), WEAR_LEVELING_FAILED) << "Step returned incorrect status";
+        }
+        reinit_and_verify();
+
+        // Further writes must survive as well, whichever bank ended up live
+        EXPECT_NE(write_next(), WEAR_LEVELING_FAILED) << "Write returned incorrect status";
+        reinit_and_verify();
+    }
+}
+
+/**
+ * This test verifies that writes between consolidation steps are carried over into the new bank, including writes to data which was already copied.
+ */
+TEST_F(WearLevelingIncremental, WritesDuringConsolidation_Preserved) {
+    for (int interrupt = 0; interrupt <= CONSOLIDATION_STEPS; ++interrupt) {
+        SetUp();
+        fill_to_threshold();
+
+        wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+        for (int i = 0; status != WEAR_LEVELING_CONSOLIDATED; ++i) {
+            if (i == interrupt) {
+                // Power loss part-way through
+                break;
+            }
+            EXPECT_NE(write_next(), WEAR_LEVELING_FAILED) << "Write returned incorrect status";
+            status = wear_leveling_consolidate_step();
+            EXPECT_NE(status, WEAR_LEVELING_FAILED) << "Step returned incorrect status";
+        }
+        verify();
+        reinit_and_verify();
+    }
+}
+
+/**
+ * This test verifies that consolidation completes in-line if the write log fills up without any steps being performed.
+ */
+TEST_F(WearLevelingIncremental, LogFull_ConsolidatesInline) {
+    auto& inst = MockBackingStore::Instance();
+
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    for (int i = 0; i < WEAR_LEVELING_BACKING_SIZE && status == WEAR_LEVELING_SUCCESS; ++i) {
+        status = write_next();
+    }
+    EXPECT_EQ(status, WEAR_LEVELING_CONSOLIDATED) << "Write log should have been consolidated";
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Backing store should not be erased in full";
+    reinit_and_verify();
+
+    // Keep going for a few rounds, alternating banks
+    for (int round = 0; round < 4; ++round) {
+        status = WEAR_LEVELING_SUCCESS;
+        for (int i = 0; i < WEAR_LEVELING_BACKING_SIZE && status == WEAR_LEVELING_SUCCESS; ++i) {
+            status = write_next();
+        }
+        EXPECT_EQ(status, WEAR_LEVELING_CONSOLIDATED) << "Write log should have been consolidated";
+        reinit_and_verify();
+    }
+}
+
+/**
+ * This test verifies that the housekeeping task completes consolidation within its budget when time does not advance.
+ */
+TEST_F(WearLevelingIncremental, Task_CompletesConsolidation) {
+    fill_to_threshold();
+    wear_leveling_task();
+
+    // Consolidation is complete, so any further steps are no-ops
+    auto&    inst        = MockBackingStore::Instance();
+    uint64_t erase_count = inst.erase_range_invoke_count();
+    EXPECT_EQ(wear_leveling_consolidate_step(), WEAR_LEVELING_SUCCESS) << "Idle step returned incorrect status";
+    EXPECT_EQ(inst.erase_range_invoke_count(), erase_count) << "Idle step should not erase";
+    reinit_and_verify();
+}
+
+/**
+ * This test verifies that a failed erase of the spare bank abandons consolidation without affecting the live data, and that a later attempt succeeds.
+ */
+TEST_F(WearLevelingIncremental, EraseFailure_LiveBankIntact) {
+    auto& inst = MockBackingStore::Instance();
+    fill_to_threshold();
+
+    inst.set_erase_range_callback([](std::uint64_t, std::uint32_t) { return false; });
+    EXPECT_EQ(wear_leveling_consolidate_step(), WEAR_LEVELING_FAILED) << "Step returned incorrect status";
+    reinit_and_verify();
+
+    inst.set_erase_range_callback([](std::uint64_t, std::uint32_t) { return true; });
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    for (int i = 0; i < WEAR_LEVELING_BACKING_SIZE && status == WEAR_LEVELING_SUCCESS; ++i) {
+        status = write_next();
+    }
+    EXPECT_EQ(status, WEAR_LEVELING_CONSOLIDATED) << "Write log should have been consolidated";
+    reinit_and_verify();
+}
+
+/**
+ * This test verifies that a failure to write the new bank's sequence number keeps the previous bank live.
+ */
+TEST_F(WearLevelingIncremental, CommitFailure_LiveBankIntact) {
+    auto& inst = MockBackingStore::Instance();
+    fill_to_threshold();
+
+    // The clean store was consolidated into bank 1, so bank 0 is the spare
+    const uint32_t sequence_address = WEAR_LEVELING_LOGICAL_SIZE + 8;
+    inst.set_write_callback([=](std::uint64_t, std::uint32_t address) { return address != sequence_address; });
+
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    for (int i = 0; i < CONSOLIDATION_STEPS && status == WEAR_LEVELING_SUCCESS; ++i) {
+        status = wear_leveling_consolidate_step();
+    }
+    EXPECT_EQ(status, WEAR_LEVELING_FAILED) << "Commit should have failed";
+
+    // Writes keep going to the previous bank
+    EXPECT_EQ(write_next(), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    reinit_and_verify();
+}
@@ -4,6 +4,9 @@
 #include "fnv.h"
 #include "wear_leveling.h"
 #include "wear_leveling_internal.h"
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+#    include "timer.h"
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 
 /*
     This wear leveling algorithm is adapted from algorithms from previous
@@ -153,7 +156,53 @@
         ║  │Address >> 1 ║
         ║  └── Value: 1  ║
         ╚════════════════╝
-        0 <= Address <= 0x3FFE (16382) */
+        0 <= Address <= 0x3FFE (16382)
+
+    Incremental consolidation:
+
+        With WEAR_LEVELING_INCREMENTAL_CONSOLIDATION defined, the backing
+        store is split into two banks, each laid out as above, with a sequence
+        number following the FNV1a_64 of the consolidated data. The bank with
+        a matching checksum and the highest sequence number is the live one.
+
+        Once the live write log runs low on space, consolidation into the
+        other bank is performed in small steps by wear_leveling_task(),
+        interleaved with regular writes which keep going to the live log:
+            * The spare bank is erased, WEAR_LEVELING_CONSOLIDATE_ERASE_SIZE
+                bytes at a time.
+            * The cache is copied into the spare bank's consolidated area,
+                WEAR_LEVELING_CONSOLIDATE_COPY_SIZE bytes at a time.
+            * The checksum of the copied data is written, any data modified
+                after being copied is appended to the spare bank's write log,
+                and finally the new sequence number is written, making the
+                spare bank the live one.
+
+        The live bank is never modified during consolidation, so a power loss
+        at any point leaves the previous bank intact. If the live write log
+        fills up before consolidation completes, the remaining steps are
+        performed in-line. */
+
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+#    define WEAR_LEVELING_BANK_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    define WEAR_LEVELING_HEADER_SIZE 16 // FNV1a_64 of the consolidated area, followed by the bank sequence number
+#else
+#    define WEAR_LEVELING_BANK_SIZE (WEAR_LEVELING_BACKING_SIZE)
+#    define WEAR_LEVELING_HEADER_SIZE 8 // FNV1a_64 of the consolidated area
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
+#define WEAR_LEVELING_LOG_START(base) ((base) + (WEAR_LEVELING_LOGICAL_SIZE) + (WEAR_LEVELING_HEADER_SIZE))
+
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+/**
+ * Incremental consolidation progress.
+ */
+typedef enum consolidation_state_t {
+    CONSOLIDATION_IDLE,
+    CONSOLIDATION_ERASE,
+    CONSOLIDATION_COPY,
+    CONSOLIDATION_COMMIT,
+} consolidation_state_t;
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 
 /**
  * Storage area for the wear-leveling cache.
@@ -162,8 +211,26 @@ static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) uint8_t cache[(WEAR_LEVELING_LOGICAL_SIZE)];
     uint32_t                                                       write_address;
     bool                                                           unlocked;
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    uint8_t               bank;     // bank holding the live consolidated data and write log
+    uint32_t              sequence; // sequence number of the live bank
+    consolidation_state_t consolidation_state;
+    uint32_t              consolidation_progress; // offset within the spare bank or the logical data, depending on state
+    uint64_t              consolidation_checksum; // FNV1a_64 of the logical data copied so far
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 } wear_leveling;
 
+/**
+ * Offset of the live bank within the backing store.
+ */
+static inline uint32_t wear_leveling_bank_base(void) {
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    return wear_leveling.bank * (WEAR_LEVELING_BANK_SIZE);
+#else
+    return 0;
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+}
+
 /**
  * Locking helper: status
  */
@@ -202,18 +269,61 @@ static inline backing_store_lock_status_t wear_leveling_lock(void) {
  */
 static void wear_leveling_clear_cache(void) {
     memset(wear_leveling.cache, 0, (WEAR_LEVELING_LOGICAL_SIZE));
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 is due to the FNV1a_64 of the consolidated buffer
+    wear_leveling.write_address = WEAR_LEVELING_LOG_START(wear_leveling_bank_base());
 }
 
 /**
- * Reads the consolidated data from the backing store into the cache.
+ * Reads a 64-bit header entry, such as the FNV1a_64 of the consolidated data, from the backing store.
+ */
+static bool wear_leveling_read_entry(uint32_t address, write_log_entry_t *entry) {
+#if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_read_bulk(address, entry->raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_read_bulk(address, entry->raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_read(address, &entry->raw64);
+#endif
+}
+
+/**
+ * Writes a 64-bit header entry, such as the FNV1a_64 of the consolidated data, to the backing store.
+ */
+static bool wear_leveling_write_entry(uint32_t address, write_log_entry_t *entry) {
+#if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_write_bulk(address, entry->raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_write_bulk(address, entry->raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_write(address, entry->raw64);
+#endif
+}
+
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+/**
+ * Bank sequence numbers are stored alongside their complement, so that erased or partially written values are rejected.
+ */
+static inline uint64_t wear_leveling_encode_sequence(uint32_t sequence) {
+    return ((uint64_t)(~sequence) << 32) | sequence;
+}
+
+static inline bool wear_leveling_decode_sequence(uint64_t raw, uint32_t *sequence) {
+    *sequence = (uint32_t)raw;
+    return (uint32_t)(raw >> 32) == (uint32_t)(~*sequence);
+}
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
+/**
+ * Reads the consolidated data of the bank at the supplied offset from the backing store into the cache.
  * Does not consider the write log.
+ *
+ * @param valid[out] whether the consolidated data matched its checksum (and sequence number, if using banks)
  */
-static wear_leveling_status_t wear_leveling_read_consolidated(void) {
+static wear_leveling_status_t wear_leveling_read_consolidated(uint32_t base, bool *valid) {
     wl_dprintf("Reading consolidated data\n");
 
+    *valid                        = false;
     wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
-    if (!backing_store_read_bulk(0, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
+    if (!backing_store_read_bulk(base, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
         wl_dprintf("Failed to read from backing store\n");
         status = WEAR_LEVELING_FAILED;
     }
@@ -223,16 +333,21 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
         uint64_t          expected = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
         write_log_entry_t entry;
         wl_dprintf("Reading checksum\n");
-#if BACKING_STORE_WRITE_SIZE == 2
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4);
-#elif BACKING_STORE_WRITE_SIZE == 4
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2);
-#elif BACKING_STORE_WRITE_SIZE == 8
-        backing_store_read((WEAR_LEVELING_LOGICAL_SIZE) + 0, &entry.raw64);
-#endif
+        wear_leveling_read_entry(base + (WEAR_LEVELING_LOGICAL_SIZE), &entry);
+        *valid = (entry.raw64 == expected);
+
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+        // The sequence number is written last, a bank without one was not completely consolidated
+        if (*valid) {
+            wl_dprintf("Reading sequence number\n");
+            wear_leveling_read_entry(base + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &entry);
+            *valid = wear_leveling_decode_sequence(entry.raw64, &wear_leveling.sequence);
+        }
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
         // If we have a mismatch, clear the cache but do not flag a failure,
         // which will cater for the completely clean MCU case.
-        if (entry.raw64 == expected) {
+        if (*valid) {
             wl_dprintf("Checksum matches, consolidated data is correct\n");
         } else {
             wl_dprintf("Checksum mismatch, clearing cache\n");
@@ -249,16 +364,17 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
 }
 
 /**
- * Writes the current cache to consolidated data at the beginning of the backing store.
+ * Writes the current cache to consolidated data at the beginning of the live bank.
  * Does not clear the write log.
  * Pre-condition: this is just after an erase, so we can write directly without reading.
  */
 static wear_leveling_status_t wear_leveling_write_consolidated(void) {
     wl_dprintf("Writing consolidated data\n");
 
+    uint32_t                    base        = wear_leveling_bank_base();
     backing_store_lock_status_t lock_status = wear_leveling_unlock();
     wear_leveling_status_t      status      = WEAR_LEVELING_CONSOLIDATED;
-    if (!backing_store_write_bulk(0, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
+    if (!backing_store_write_bulk(base, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
         wl_dprintf("Failed to write to backing store\n");
         status = WEAR_LEVELING_FAILED;
     }
@@ -268,32 +384,223 @@ static wear_leveling_status_t wear_leveling_write_consolidated(void) {
         write_log_entry_t entry;
         entry.raw64 = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
         wl_dprintf("Writing checksum\n");
-        do {
-#if BACKING_STORE_WRITE_SIZE == 2
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4)) {
-                status = WEAR_LEVELING_FAILED;
+        if (!wear_leveling_write_entry(base + (WEAR_LEVELING_LOGICAL_SIZE), &entry)) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    if (status != WEAR_LEVELING_FAILED) {
+        write_log_entry_t entry;
+        entry.raw64 = wear_leveling_encode_sequence(wear_leveling.sequence);
+        wl_dprintf("Writing sequence number\n");
+        if (!wear_leveling_write_entry(base + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &entry)) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
+    if (lock_status == STATUS_SUCCESS) {
+        wear_leveling_lock();
+    }
+    return status;
+}
+
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const void *value, size_t length);
+
+/**
+ * Compares the consolidated data of the spare bank against the cache, either appending each differing run of bytes to
+ * the write log, or accumulating an upper bound of the write log space required to do so.
+ */
+static wear_leveling_status_t wear_leveling_diff_spare(uint32_t base, bool apply, uint32_t *usage) {
+    backing_store_int_t buffer[(WEAR_LEVELING_CONSOLIDATE_COPY_SIZE) / (BACKING_STORE_WRITE_SIZE)];
+    const uint8_t      *data = (const uint8_t *)buffer;
+    for (uint32_t offset = 0; offset < (WEAR_LEVELING_LOGICAL_SIZE); offset += (WEAR_LEVELING_CONSOLIDATE_COPY_SIZE)) {
+        uint32_t length = (WEAR_LEVELING_LOGICAL_SIZE) - offset;
+        if (length > (WEAR_LEVELING_CONSOLIDATE_COPY_SIZE)) {
+            length = (WEAR_LEVELING_CONSOLIDATE_COPY_SIZE);
+        }
+        if (!backing_store_read_bulk(base + offset, buffer, length / (BACKING_STORE_WRITE_SIZE))) {
+            wl_dprintf("Failed to read from backing store\n");
+            return WEAR_LEVELING_FAILED;
+        }
+
+        uint32_t i = 0;
+        while (i < length) {
+            if (data[i] == wear_leveling.cache[offset + i]) {
+                ++i;
+                continue;
+            }
+            uint32_t start = i;
+            while (i < length && data[i] != wear_leveling.cache[offset + i]) {
+                ++i;
+            }
+            if (apply) {
+                if (wear_leveling_write_raw(offset + start, &wear_leveling.cache[offset + start], i - start) != WEAR_LEVELING_SUCCESS) {
+                    return WEAR_LEVELING_FAILED;
+                }
+            } else {
+                // Worst case is two bytes of log per byte of data, plus one partially-filled entry
+                *usage += (i - start) * 2 + 8;
+            }
+        }
+    }
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Performs the next step of an incremental consolidation into the spare bank.
+ * The live bank is left untouched until the spare bank's sequence number is written, so a power loss part-way through
+ * leaves the previous consolidated data and write log intact.
+ */
+static wear_leveling_status_t wear_leveling_consolidate_step_unlocked(void) {
+    const uint32_t    base  = (wear_leveling.bank ^ 1) * (WEAR_LEVELING_BANK_SIZE);
+    write_log_entry_t entry = {0};
+    switch (wear_leveling.consolidation_state) {
+        case CONSOLIDATION_IDLE:
+            return WEAR_LEVELING_SUCCESS;
+
+        case CONSOLIDATION_ERASE:
+            wl_dprintf("Erasing spare bank at offset %d\n", (int)wear_leveling.consolidation_progress);
+            if (!backing_store_erase_range(base + wear_leveling.consolidation_progress, (WEAR_LEVELING_CONSOLIDATE_ERASE_SIZE))) {
+                wl_dprintf("Failed to erase backing store\n");
                 break;
             }
-#elif BACKING_STORE_WRITE_SIZE == 4
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2)) {
-                status = WEAR_LEVELING_FAILED;
+            wear_leveling.consolidation_progress += (WEAR_LEVELING_CONSOLIDATE_ERASE_SIZE);
+            if (wear_leveling.consolidation_progress >= (WEAR_LEVELING_BANK_SIZE)) {
+                wear_leveling.consolidation_state    = CONSOLIDATION_COPY;
+                wear_leveling.consolidation_progress = 0;
+                wear_leveling.consolidation_checksum = FNV1A_64_INIT;
+            }
+            return WEAR_LEVELING_SUCCESS;
+
+        case CONSOLIDATION_COPY: {
+            uint32_t offset = wear_leveling.consolidation_progress;
+            uint32_t length = (WEAR_LEVELING_LOGICAL_SIZE) - offset;
+            if (length > (WEAR_LEVELING_CONSOLIDATE_COPY_SIZE)) {
+                length = (WEAR_LEVELING_CONSOLIDATE_COPY_SIZE);
+            }
+            wl_dprintf("Copying consolidated data at offset %d\n", (int)offset);
+            if (!backing_store_write_bulk(base + offset, (backing_store_int_t *)&wear_leveling.cache[offset], length / (BACKING_STORE_WRITE_SIZE))) {
+                wl_dprintf("Failed to write to backing store\n");
                 break;
             }
-#elif BACKING_STORE_WRITE_SIZE == 8
-            if (!backing_store_write((WEAR_LEVELING_LOGICAL_SIZE), entry.raw64)) {
-                status = WEAR_LEVELING_FAILED;
+            // The checksum covers what was copied, any later modifications to the cache are caught up on commit
+            wear_leveling.consolidation_checksum = fnv_64a_buf(&wear_leveling.cache[offset], length, wear_leveling.consolidation_checksum);
+            wear_leveling.consolidation_progress += length;
+            if (wear_leveling.consolidation_progress >= (WEAR_LEVELING_LOGICAL_SIZE)) {
+                wear_leveling.consolidation_state = CONSOLIDATION_COMMIT;
+            }
+            return WEAR_LEVELING_SUCCESS;
+        }
+
+        case CONSOLIDATION_COMMIT: {
+            wl_dprintf("Writing checksum\n");
+            entry.raw64 = wear_leveling.consolidation_checksum;
+            if (!wear_leveling_write_entry(base + (WEAR_LEVELING_LOGICAL_SIZE), &entry)) {
                 break;
             }
-#endif
-        } while (0);
+
+            // Writes which occurred after their data was copied need to go into the spare bank's write log. If they
+            // don't fit, start over with the current cache.
+            uint32_t usage = 0;
+            if (wear_leveling_diff_spare(base, false, &usage) != WEAR_LEVELING_SUCCESS) {
+                break;
+            }
+            if (usage >= (WEAR_LEVELING_BANK_SIZE) - (WEAR_LEVELING_LOGICAL_SIZE) - (WEAR_LEVELING_HEADER_SIZE)) {
+                wl_dprintf("Too many modifications during consolidation, restarting\n");
+                wear_leveling.consolidation_state    = CONSOLIDATION_ERASE;
+                wear_leveling.consolidation_progress = 0;
+                return WEAR_LEVELING_SUCCESS;
+            }
+
+            const uint8_t  previous_bank          = wear_leveling.bank;
+            const uint32_t previous_write_address = wear_leveling.write_address;
+            wear_leveling.bank ^= 1;
+            wear_leveling.write_address = WEAR_LEVELING_LOG_START(base);
+
+            bool ok = (wear_leveling_diff_spare(base, true, NULL) == WEAR_LEVELING_SUCCESS);
+
+            // Writing the sequence number makes the spare bank the live one
+            if (ok) {
+                wl_dprintf("Writing sequence number\n");
+                entry.raw64 = wear_leveling_encode_sequence(wear_leveling.sequence + 1);
+                ok          = wear_leveling_write_entry(base + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &entry);
+            }
+            if (!ok) {
+                wear_leveling.bank          = previous_bank;
+                wear_leveling.write_address = previous_write_address;
+                break;
+            }
+            wear_leveling.sequence++;
+            wear_leveling.consolidation_state = CONSOLIDATION_IDLE;
+            return WEAR_LEVELING_CONSOLIDATED;
+        }
     }
 
-    if (lock_status == STATUS_SUCCESS) {
+    // Failures abandon the consolidation, which will be restarted from scratch the next time it is required
+    wear_leveling.consolidation_state = CONSOLIDATION_IDLE;
+    return WEAR_LEVELING_FAILED;
+}
+
+/**
+ * Performs the next step of an incremental consolidation, if one is in progress.
+ */
+wear_leveling_status_t wear_leveling_consolidate_step(void) {
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
         wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wear_leveling_status_t status = wear_leveling_consolidate_step_unlocked();
+
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
     }
     return status;
 }
 
+/**
+ * Performs incremental consolidation steps, until complete or the time budget is exhausted.
+ */
+void wear_leveling_task(void) {
+    if (wear_leveling.consolidation_state == CONSOLIDATION_IDLE) {
+        return;
+    }
+
+    uint32_t start = timer_read32();
+    do {
+        if (wear_leveling_consolidate_step() != WEAR_LEVELING_SUCCESS) {
+            break;
+        }
+    } while (wear_leveling.consolidation_state != CONSOLIDATION_IDLE && timer_elapsed32(start) < (WEAR_LEVELING_CONSOLIDATE_BUDGET_MS));
+}
+
+/**
+ * Forces a write of the current cache.
+ * Completes any in-progress consolidation into the spare bank in-line, starting a new one if required.
+ */
+static wear_leveling_status_t wear_leveling_consolidate_force(void) {
+    if (wear_leveling.consolidation_state == CONSOLIDATION_IDLE) {
+        wear_leveling.consolidation_state    = CONSOLIDATION_ERASE;
+        wear_leveling.consolidation_progress = 0;
+    }
+
+    wear_leveling_status_t status;
+    do {
+        status = wear_leveling_consolidate_step();
+    } while (status == WEAR_LEVELING_SUCCESS);
+
+    if (status == WEAR_LEVELING_FAILED) {
+        wl_dprintf("Failed to consolidate\n");
+    }
+    return status;
+}
+#else  // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 /**
  * Forces a write of the current cache.
  * Erases the backing store, including the write log.
@@ -316,10 +623,11 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
     }
 
     // Next write of the log occurs after the consolidated values at the start of the backing store.
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+    wear_leveling.write_address = WEAR_LEVELING_LOG_START(0);
 
     return status;
 }
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 
 /**
  * Potential write of the current cache to the backing store.
@@ -329,10 +637,20 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
  * @return true if consolidation occurred
  */
 static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
-    if (wear_leveling.write_address >= (WEAR_LEVELING_BACKING_SIZE)) {
+    const uint32_t end = wear_leveling_bank_base() + (WEAR_LEVELING_BANK_SIZE);
+    if (wear_leveling.write_address >= end) {
         return wear_leveling_consolidate_force();
     }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    // Start consolidating in the background before the log runs out of space
+    if (wear_leveling.consolidation_state == CONSOLIDATION_IDLE && end - wear_leveling.write_address <= (WEAR_LEVELING_CONSOLIDATE_THRESHOLD)) {
+        wl_dprintf("Starting incremental consolidation\n");
+        wear_leveling.consolidation_state    = CONSOLIDATION_ERASE;
+        wear_leveling.consolidation_progress = 0;
+    }
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
     return WEAR_LEVELING_SUCCESS;
 }
 
@@ -477,8 +795,9 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 
     wear_leveling_status_t status          = WEAR_LEVELING_SUCCESS;
     bool                   cancel_playback = false;
-    uint32_t               address         = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
-    while (!cancel_playback && address < (WEAR_LEVELING_BACKING_SIZE)) {
+    uint32_t               address         = WEAR_LEVELING_LOG_START(wear_leveling_bank_base());
+    uint32_t               end             = wear_leveling_bank_base() + (WEAR_LEVELING_BANK_SIZE);
+    while (!cancel_playback && address < end) {
         backing_store_int_t value;
         bool                ok = backing_store_read(address, &value);
         if (!ok) {
@@ -627,8 +946,47 @@ wear_leveling_status_t wear_leveling_init(void) {
         return WEAR_LEVELING_FAILED;
     }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    // Any consolidation in progress before a reset needs to start over, as the cache may not have matched
+    wear_leveling.consolidation_state = CONSOLIDATION_IDLE;
+
+    // Find the bank with valid consolidated data and the most recent sequence number
+    bool                   valid[2];
+    uint32_t               sequence[2];
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    for (uint8_t bank = 0; bank < 2 && status != WEAR_LEVELING_FAILED; ++bank) {
+        status         = wear_leveling_read_consolidated(bank * (WEAR_LEVELING_BANK_SIZE), &valid[bank]);
+        sequence[bank] = wear_leveling.sequence;
+    }
+    if (status == WEAR_LEVELING_FAILED) {
+        // If it failed, clear the cache and return with failure
+        wear_leveling.bank = 0;
+        wear_leveling_clear_cache();
+        return status;
+    }
+
+    if (!valid[0] && !valid[1]) {
+        // Clean MCU, or erased backing store -- consolidate the cleared cache so that the write log has a valid bank to live in
+        wl_dprintf("No valid bank found\n");
+        wear_leveling.bank     = 0;
+        wear_leveling.sequence = 0;
+        wear_leveling_clear_cache();
+        status = wear_leveling_consolidate_force();
+        if (status == WEAR_LEVELING_FAILED) {
+            wear_leveling_clear_cache();
+        }
+        return status;
+    }
+
+    // Sequence numbers are compared with wraparound
+    wear_leveling.bank = (!valid[0] || (valid[1] && (int32_t)(sequence[1] - sequence[0]) > 0)) ? 1 : 0;
+    wl_dprintf("Using bank %d\n", (int)wear_leveling.bank);
+    status = wear_leveling_read_consolidated(wear_leveling_bank_base(), &valid[wear_leveling.bank]);
+#else
     // Read the previous consolidated values, then replay the existing write log so that the cache has the "live" values
-    wear_leveling_status_t status = wear_leveling_read_consolidated();
+    bool                   valid;
+    wear_leveling_status_t status = wear_leveling_read_consolidated(0, &valid);
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
     if (status == WEAR_LEVELING_FAILED) {
         // If it failed, clear the cache and return with failure
         wear_leveling_clear_cache();
@@ -661,7 +1019,18 @@ wear_leveling_status_t wear_leveling_erase(void) {
 
     // Perform the erase
     bool ret = backing_store_erase();
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    // Write out a valid first bank, so that the write log is not discarded on the next init
+    wear_leveling.bank                = 0;
+    wear_leveling.sequence            = 1;
+    wear_leveling.consolidation_state = CONSOLIDATION_IDLE;
+    wear_leveling_clear_cache();
+    if (ret) {
+        ret = (wear_leveling_write_consolidated() != WEAR_LEVELING_FAILED);
+    }
+#else
     wear_leveling_clear_cache();
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 
     // Lock the backing store if we acquired the lock successfully
     if (lock_status == STATUS_SUCCESS) {
@@ -52,3 +52,20 @@ wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value,
  * @return Status of the request
  */
 wear_leveling_status_t wear_leveling_read(uint32_t address, void* value, size_t length);
+
+/**
+ * Performs the next step of an incremental consolidation, if one is in progress.
+ *
+ * Only available with WEAR_LEVELING_INCREMENTAL_CONSOLIDATION. Consolidation is started automatically once the write
+ * log runs low on space, and is otherwise completed in-line when the write log is full.
+ *
+ * @return Status of the request, WEAR_LEVELING_CONSOLIDATED once the consolidated data has been committed
+ */
+wear_leveling_status_t wear_leveling_consolidate_step(void);
+
+/**
+ * Performs incremental consolidation steps within WEAR_LEVELING_CONSOLIDATE_BUDGET_MS, invoked from housekeeping.
+ *
+ * Only available with WEAR_LEVELING_INCREMENTAL_CONSOLIDATION.
+ */
+void wear_leveling_task(void);
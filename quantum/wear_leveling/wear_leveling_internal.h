@@ -66,10 +66,35 @@ _Static_assert(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "
 _Static_assert(WEAR_LEVELING_LOGICAL_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Logical size must be a multiple of write size");
 _Static_assert(WEAR_LEVELING_BACKING_SIZE % WEAR_LEVELING_LOGICAL_SIZE == 0, "Backing size must be a multiple of logical size");
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+// Amount of the spare bank erased in each consolidation step, should be a multiple of the backing store's erase size.
+// Drivers default this to one sector or page, the whole bank is only used for drivers that do not know their erase size.
+#    ifndef WEAR_LEVELING_CONSOLIDATE_ERASE_SIZE
+#        define WEAR_LEVELING_CONSOLIDATE_ERASE_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    endif
+// Amount of logical data copied into the spare bank in each consolidation step
+#    ifndef WEAR_LEVELING_CONSOLIDATE_COPY_SIZE
+#        define WEAR_LEVELING_CONSOLIDATE_COPY_SIZE 64
+#    endif
+// Remaining write log space below which background consolidation is started
+#    ifndef WEAR_LEVELING_CONSOLIDATE_THRESHOLD
+#        define WEAR_LEVELING_CONSOLIDATE_THRESHOLD (((WEAR_LEVELING_BACKING_SIZE) / 2 - (WEAR_LEVELING_LOGICAL_SIZE) - 16) / 2)
+#    endif
+// Time spent on consolidation steps for each invocation of wear_leveling_task(), at least one step is always performed
+#    ifndef WEAR_LEVELING_CONSOLIDATE_BUDGET_MS
+#        define WEAR_LEVELING_CONSOLIDATE_BUDGET_MS 1
+#    endif
+
+_Static_assert(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 4), "Total backing size must be at least four times the size of the logical size for incremental consolidation");
+_Static_assert((WEAR_LEVELING_BACKING_SIZE / 2) % WEAR_LEVELING_CONSOLIDATE_ERASE_SIZE == 0, "Bank size must be a multiple of the consolidation erase size");
+_Static_assert(WEAR_LEVELING_CONSOLIDATE_COPY_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Consolidation copy size must be a multiple of write size");
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 // Backing Store API, to be implemented elsewhere by flash driver etc.
 bool backing_store_init(void);
 bool backing_store_unlock(void);
 bool backing_store_erase(void);
+bool backing_store_erase_range(uint32_t address, uint32_t length); // only required for WEAR_LEVELING_INCREMENTAL_CONSOLIDATION, address and length are aligned to WEAR_LEVELING_CONSOLIDATE_ERASE_SIZE
 bool backing_store_write(uint32_t address, backing_store_int_t value);
 bool backing_store_write_bulk(uint32_t address, backing_store_int_t* values, size_t item_count); // weak implementation already provided, optimized implementation can be implemented by driver
 bool backing_store_lock(void);
@@ -202,3 +202,41 @@ TEST_F(AutoCorrect, overture_should_not_autocorrect) {
 
     VERIFY_AND_CLEAR(driver);
 }
+
+// Test that typing "fales" still autocorrects once the buffer has wrapped around
+TEST_F(AutoCorrect, fales_after_long_word_autocorrect) {
+    TestDriver driver;
+    auto       key_f = KeymapKey(0, 0, 0, KC_F);
+    auto       key_a = KeymapKey(0, 1, 0, KC_A);
+    auto       key_l = KeymapKey(0, 2, 0, KC_L);
+    auto       key_s = KeymapKey(0, 3, 0, KC_S);
+    auto       key_i = KeymapKey(0, 4, 0, KC_I);
+    auto       key_y = KeymapKey(0, 5, 0, KC_Y);
+    auto       key_e = KeymapKey(0, 6, 0, KC_E);
+
+    set_keymap({key_f, key_a, key_l, key_s, key_i, key_y, key_e});
+
+    // Allow any number of empty reports.
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    { // Expect the following reports in this order.
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_F)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_L)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_S)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_I)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_F)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_Y)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_F)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_L)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_BACKSPACE)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_S)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+    }
+
+    TapKeys(key_f, key_a, key_l, key_s, key_i, key_f, key_y, key_f, key_a, key_l, key_e, key_s);
+
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,57 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "bench.hpp"
+#include "test_common.hpp"
+
+class ComboBench : public BenchFixture {};
+
+TEST_F(ComboBench, TypingThroughCombos) {
+    KeymapKey key_a(0, 0, 0, KC_A);
+    KeymapKey key_s(0, 1, 0, KC_S);
+    KeymapKey key_d(0, 2, 0, KC_D);
+    KeymapKey key_j(0, 3, 0, KC_J);
+    KeymapKey key_k(0, 4, 0, KC_K);
+    KeymapKey key_o(0, 5, 0, KC_O);
+    set_keymap({key_a, key_s, key_d, key_j, key_k, key_o});
+
+    /* Keys that are part of combos, but are typed one at a time. */
+    BenchResult result = replay({
+        bench_press(key_a, 80),
+        bench_release(key_a, 20),
+        bench_press(key_j, 80),
+        bench_release(key_j, 20),
+        bench_press(key_o, 20),
+        bench_release(key_o, 20),
+    });
+    EXPECT_GT(result.reports, 0);
+    EXPECT_EQ(result.allocations, 0);
+}
+
+TEST_F(ComboBench, ChordedCombos) {
+    KeymapKey key_a(0, 0, 0, KC_A);
+    KeymapKey key_s(0, 1, 0, KC_S);
+    KeymapKey key_d(0, 2, 0, KC_D);
+    KeymapKey key_j(0, 3, 0, KC_J);
+    KeymapKey key_k(0, 4, 0, KC_K);
+    set_keymap({key_a, key_s, key_d, key_j, key_k});
+
+    BenchResult result = replay({
+        bench_press(key_a, 5),
+        bench_press(key_s, 20),
+        bench_release(key_a, 1),
+        bench_release(key_s, 20),
+        bench_press(key_j, 5),
+        bench_press(key_k, 20),
+        bench_release(key_j, 1),
+        bench_release(key_k, 20),
+        bench_press(key_a, 5),
+        bench_press(key_s, 5),
+        bench_press(key_d, 20),
+        bench_release(key_a, 1),
+        bench_release(key_s, 1),
+        bench_release(key_d, 20),
+    });
+    EXPECT_GT(result.reports, 0);
+    EXPECT_EQ(result.allocations, 0);
+}
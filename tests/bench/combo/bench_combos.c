@@ -0,0 +1,45 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+/* A realistically sized set of two and three key combos over the home rows. */
+enum combos { c_as, c_sd, c_df, c_fg, c_jk, c_kl, c_qw, c_we, c_er, c_rt, c_zx, c_xc, c_cv, c_asd, c_jkl, c_wer };
+
+uint16_t const as_combo[]  = {KC_A, KC_S, COMBO_END};
+uint16_t const sd_combo[]  = {KC_S, KC_D, COMBO_END};
+uint16_t const df_combo[]  = {KC_D, KC_F, COMBO_END};
+uint16_t const fg_combo[]  = {KC_F, KC_G, COMBO_END};
+uint16_t const jk_combo[]  = {KC_J, KC_K, COMBO_END};
+uint16_t const kl_combo[]  = {KC_K, KC_L, COMBO_END};
+uint16_t const qw_combo[]  = {KC_Q, KC_W, COMBO_END};
+uint16_t const we_combo[]  = {KC_W, KC_E, COMBO_END};
+uint16_t const er_combo[]  = {KC_E, KC_R, COMBO_END};
+uint16_t const rt_combo[]  = {KC_R, KC_T, COMBO_END};
+uint16_t const zx_combo[]  = {KC_Z, KC_X, COMBO_END};
+uint16_t const xc_combo[]  = {KC_X, KC_C, COMBO_END};
+uint16_t const cv_combo[]  = {KC_C, KC_V, COMBO_END};
+uint16_t const asd_combo[] = {KC_A, KC_S, KC_D, COMBO_END};
+uint16_t const jkl_combo[] = {KC_J, KC_K, KC_L, COMBO_END};
+uint16_t const wer_combo[] = {KC_W, KC_E, KC_R, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    [c_as]  = COMBO(as_combo, KC_ESC),
+    [c_sd]  = COMBO(sd_combo, KC_TAB),
+    [c_df]  = COMBO(df_combo, KC_ENT),
+    [c_fg]  = COMBO(fg_combo, KC_BSPC),
+    [c_jk]  = COMBO(jk_combo, KC_LEFT),
+    [c_kl]  = COMBO(kl_combo, KC_RIGHT),
+    [c_qw]  = COMBO(qw_combo, KC_1),
+    [c_we]  = COMBO(we_combo, KC_2),
+    [c_er]  = COMBO(er_combo, KC_3),
+    [c_rt]  = COMBO(rt_combo, KC_4),
+    [c_zx]  = COMBO(zx_combo, KC_5),
+    [c_xc]  = COMBO(xc_combo, KC_6),
+    [c_cv]  = COMBO(cv_combo, KC_7),
+    [c_asd] = COMBO(asd_combo, KC_8),
+    [c_jkl] = COMBO(jkl_combo, KC_9),
+    [c_wer] = COMBO(wer_combo, KC_0),
+};
+// clang-format on
@@ -0,0 +1,47 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "bench.hpp"
+#include "test_common.hpp"
+
+class KeyOverrideBench : public BenchFixture {};
+
+TEST_F(KeyOverrideBench, TriggeredOverrides) {
+    KeymapKey key_shift(0, 0, 0, KC_LSFT);
+    KeymapKey key_bspc(0, 1, 0, KC_BSPC);
+    KeymapKey key_ctrl(0, 2, 0, KC_LCTL);
+    KeymapKey key_h(0, 3, 0, KC_H);
+    set_keymap({key_shift, key_bspc, key_ctrl, key_h});
+
+    BenchResult result = replay({
+        bench_press(key_shift, 10),
+        bench_press(key_bspc, 20),
+        bench_release(key_bspc, 10),
+        bench_release(key_shift, 10),
+        bench_press(key_ctrl, 10),
+        bench_press(key_h, 20),
+        bench_release(key_h, 10),
+        bench_release(key_ctrl, 10),
+    });
+    EXPECT_GT(result.reports, 0);
+    EXPECT_EQ(result.allocations, 0);
+}
+
+TEST_F(KeyOverrideBench, ShiftedTypingWithoutOverrides) {
+    KeymapKey key_shift(0, 0, 0, KC_LSFT);
+    KeymapKey key_a(0, 1, 0, KC_A);
+    KeymapKey key_s(0, 2, 0, KC_S);
+    set_keymap({key_shift, key_a, key_s});
+
+    /* Every key is checked against every override while a trigger modifier is held. */
+    BenchResult result = replay({
+        bench_press(key_shift, 10),
+        bench_press(key_a, 10),
+        bench_release(key_a, 10),
+        bench_press(key_s, 10),
+        bench_release(key_s, 10),
+        bench_release(key_shift, 10),
+    });
+    EXPECT_GT(result.reports, 0);
+    EXPECT_EQ(result.allocations, 0);
+}
@@ -0,0 +1,30 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+/* A typical set of overrides, most of which never trigger while typing. */
+const key_override_t shift_bspc_override  = ko_make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_DEL);
+const key_override_t shift_esc_override   = ko_make_basic(MOD_MASK_SHIFT, KC_ESC, KC_GRV);
+const key_override_t ctrl_h_override      = ko_make_basic(MOD_MASK_CTRL, KC_H, KC_LEFT);
+const key_override_t ctrl_j_override      = ko_make_basic(MOD_MASK_CTRL, KC_J, KC_DOWN);
+const key_override_t ctrl_k_override      = ko_make_basic(MOD_MASK_CTRL, KC_K, KC_UP);
+const key_override_t ctrl_l_override      = ko_make_basic(MOD_MASK_CTRL, KC_L, KC_RIGHT);
+const key_override_t shift_comma_override = ko_make_basic(MOD_MASK_SHIFT, KC_COMM, KC_SCLN);
+const key_override_t shift_dot_override   = ko_make_basic(MOD_MASK_SHIFT, KC_DOT, KC_COLN);
+
+// clang-format off
+const key_override_t *bench_key_overrides[] = {
+    &shift_bspc_override,
+    &shift_esc_override,
+    &ctrl_h_override,
+    &ctrl_j_override,
+    &ctrl_k_override,
+    &ctrl_l_override,
+    &shift_comma_override,
+    &shift_dot_override,
+    NULL
+};
+// clang-format on
+
+const key_override_t **key_overrides = bench_key_overrides;
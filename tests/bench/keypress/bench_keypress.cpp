@@ -0,0 +1,53 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "bench.hpp"
+#include "test_common.hpp"
+
+class KeypressBench : public BenchFixture {};
+
+TEST_F(KeypressBench, Typing) {
+    KeymapKey key_a(0, 0, 0, KC_A);
+    KeymapKey key_s(0, 1, 0, KC_S);
+    KeymapKey key_d(0, 2, 0, KC_D);
+    KeymapKey key_f(0, 3, 0, KC_F);
+    set_keymap({key_a, key_s, key_d, key_f});
+
+    /* Overlapping presses, as when typing quickly. */
+    BenchResult result = replay({
+        bench_press(key_a, 20),
+        bench_press(key_s, 10),
+        bench_release(key_a, 20),
+        bench_press(key_d, 10),
+        bench_release(key_s, 20),
+        bench_release(key_d, 10),
+        bench_press(key_f, 30),
+        bench_release(key_f, 30),
+    });
+    EXPECT_EQ(result.reports, result.events);
+    EXPECT_EQ(result.allocations, 0);
+}
+
+TEST_F(KeypressBench, ModTapAndLayerTap) {
+    KeymapKey key_mt(0, 0, 0, LSFT_T(KC_A));
+    KeymapKey key_lt(0, 1, 0, LT(1, KC_B));
+    KeymapKey key_c(0, 2, 0, KC_C);
+    KeymapKey key_c_layer(1, 2, 0, KC_X);
+    set_keymap({key_mt, key_lt, key_c, key_c_layer});
+
+    /* Taps within the tapping term, then holds past it. */
+    BenchResult result = replay({
+        bench_press(key_mt, 30),
+        bench_release(key_mt, 30),
+        bench_press(key_lt, TAPPING_TERM + 1),
+        bench_press(key_c, 20),
+        bench_release(key_c, 20),
+        bench_release(key_lt, 20),
+        bench_press(key_mt, TAPPING_TERM + 1),
+        bench_press(key_c, 20),
+        bench_release(key_c, 20),
+        bench_release(key_mt, 20),
+    });
+    EXPECT_GT(result.reports, 0);
+    EXPECT_EQ(result.allocations, 0);
+}
@@ -0,0 +1,50 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "bench.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "bench_tap_dances.h"
+}
+
+class TapDanceBench : public BenchFixture {};
+
+TEST_F(TapDanceBench, SingleAndDoubleTaps) {
+    KeymapKey key_td(0, 0, 0, TD(TD_ESC_CAPS));
+    KeymapKey key_a(0, 1, 0, KC_A);
+    set_keymap({key_td, key_a});
+
+    /* A single tap resolved by the tapping term, a double tap, then a tap interrupted by another key. */
+    BenchResult result = replay({
+        bench_press(key_td, 20),
+        bench_release(key_td, TAPPING_TERM + 1),
+        bench_press(key_td, 20),
+        bench_release(key_td, 20),
+        bench_press(key_td, 20),
+        bench_release(key_td, TAPPING_TERM + 1),
+        bench_press(key_td, 20),
+        bench_release(key_td, 20),
+        bench_press(key_a, 20),
+        bench_release(key_a, 20),
+    });
+    EXPECT_GT(result.reports, 0);
+    EXPECT_EQ(result.allocations, 0);
+}
+
+TEST_F(TapDanceBench, TypingWithTapDanceKeymap) {
+    KeymapKey key_td(0, 0, 0, TD(TD_LAYER));
+    KeymapKey key_a(0, 1, 0, KC_A);
+    KeymapKey key_s(0, 2, 0, KC_S);
+    set_keymap({key_td, key_a, key_s});
+
+    /* Plain keys still go through the tap dance processing. */
+    BenchResult result = replay({
+        bench_press(key_a, 10),
+        bench_press(key_s, 10),
+        bench_release(key_a, 10),
+        bench_release(key_s, 10),
+    });
+    EXPECT_EQ(result.reports, result.events);
+    EXPECT_EQ(result.allocations, 0);
+}
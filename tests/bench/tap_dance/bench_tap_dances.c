@@ -0,0 +1,12 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+#include "bench_tap_dances.h"
+
+// clang-format off
+tap_dance_action_t tap_dance_actions[] = {
+    [TD_ESC_CAPS] = ACTION_TAP_DANCE_DOUBLE(KC_ESC, KC_CAPS),
+    [TD_LAYER]    = ACTION_TAP_DANCE_LAYER_MOVE(KC_L, 1),
+};
+// clang-format on
@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+enum {
+    TD_ESC_CAPS,
+    TD_LAYER,
+};
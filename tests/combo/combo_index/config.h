@@ -0,0 +1,12 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define TAPPING_TERM 200
+
+#define COMBO_INDEX_SIZE 64
+// Small enough for the shared key combos to overflow it
+#define COMBO_DIRTY_LENGTH 4
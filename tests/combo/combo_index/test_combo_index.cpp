@@ -0,0 +1,103 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "quantum.h"
+#include "keycode.h"
+#include "test_common.h"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class ComboIndex : public TestFixture {};
+
+TEST_F(ComboIndex, two_key_combo_tapped) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_s(0, 1, 0, KC_S);
+    KeymapKey  key_d(0, 2, 0, KC_D);
+    set_keymap({key_a, key_s, key_d});
+
+    EXPECT_REPORT(driver, (KC_ESC));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_s});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, longer_overlapping_combo_wins) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_s(0, 1, 0, KC_S);
+    KeymapKey  key_d(0, 2, 0, KC_D);
+    set_keymap({key_a, key_s, key_d});
+
+    EXPECT_REPORT(driver, (KC_TAB));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_s, key_d});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, keys_outside_of_combos_are_not_delayed) {
+    TestDriver driver;
+    KeymapKey  key_x(0, 3, 0, KC_X);
+    set_keymap({key_x});
+
+    EXPECT_REPORT(driver, (KC_X));
+    key_x.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_x.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, combo_key_typed_alone_after_combo_term) {
+    TestDriver driver;
+    KeymapKey  key_j(0, 4, 0, KC_J);
+    KeymapKey  key_k(0, 5, 0, KC_K);
+    set_keymap({key_j, key_k});
+
+    EXPECT_REPORT(driver, (KC_J));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_j, COMBO_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_ENT));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_j, key_k});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, key_shared_by_more_combos_than_tracked) {
+    TestDriver driver;
+    KeymapKey  key_k(0, 5, 0, KC_K);
+    KeymapKey  key_1(0, 6, 0, KC_1);
+    KeymapKey  key_6(0, 7, 0, KC_6);
+    set_keymap({key_k, key_1, key_6});
+
+    /* Pressing K touches more combos than COMBO_DIRTY_LENGTH, which must all be reset afterwards. */
+    EXPECT_REPORT(driver, (KC_K));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_k, COMBO_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_F1));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_k, key_1});
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_F6));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_6, key_k});
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_1, COMBO_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,30 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+enum combos { as_esc, asd_tab, jk_ent, k1_1, k2_2, k3_3, k4_4, k5_5, k6_6 };
+
+uint16_t const as_combo[]  = {KC_A, KC_S, COMBO_END};
+uint16_t const asd_combo[] = {KC_A, KC_S, KC_D, COMBO_END};
+uint16_t const jk_combo[]  = {KC_J, KC_K, COMBO_END};
+uint16_t const k1_combo[]  = {KC_K, KC_1, COMBO_END};
+uint16_t const k2_combo[]  = {KC_K, KC_2, COMBO_END};
+uint16_t const k3_combo[]  = {KC_K, KC_3, COMBO_END};
+uint16_t const k4_combo[]  = {KC_K, KC_4, COMBO_END};
+uint16_t const k5_combo[]  = {KC_K, KC_5, COMBO_END};
+uint16_t const k6_combo[]  = {KC_6, KC_K, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    [as_esc]  = COMBO(as_combo, KC_ESC),
+    [asd_tab] = COMBO(asd_combo, KC_TAB),
+    [jk_ent]  = COMBO(jk_combo, KC_ENT),
+    [k1_1]    = COMBO(k1_combo, KC_F1),
+    [k2_2]    = COMBO(k2_combo, KC_F2),
+    [k3_3]    = COMBO(k3_combo, KC_F3),
+    [k4_4]    = COMBO(k4_combo, KC_F4),
+    [k5_5]    = COMBO(k5_combo, KC_F5),
+    [k6_6]    = COMBO(k6_combo, KC_F6),
+};
+// clang-format on
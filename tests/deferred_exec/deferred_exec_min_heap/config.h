@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define DEFERRED_EXEC_MIN_HEAP
+#define MAX_DEFERRED_EXECUTORS 200
@@ -0,0 +1,135 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "deferred_exec.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+namespace {
+
+struct fire_record {
+    uint32_t now;
+    uint32_t trigger_time;
+    int      id;
+};
+
+std::vector<fire_record> fired;
+deferred_token           other_token;
+
+uint32_t record_callback(uint32_t trigger_time, void *cb_arg) {
+    fired.push_back({timer_read32(), trigger_time, (int)(intptr_t)cb_arg});
+    return 0;
+}
+
+uint32_t cancel_other_callback(uint32_t trigger_time, void *cb_arg) {
+    record_callback(trigger_time, cb_arg);
+    cancel_deferred_exec(other_token);
+    return 0;
+}
+
+uint32_t requeue_self_callback(uint32_t trigger_time, void *cb_arg) {
+    record_callback(trigger_time, cb_arg);
+    cancel_deferred_exec(other_token);
+    if (fired.size() < 3) {
+        other_token = defer_exec(7, requeue_self_callback, cb_arg);
+    }
+    return 1; // ignored, the executor was replaced
+}
+
+class DeferredExecMinHeap : public TestFixture {
+   protected:
+    void SetUp() override {
+        fired.clear();
+        // The executor throttles against the last time it ran, so keep its clock monotonic across tests
+        set_time(clock);
+    }
+
+    void TearDown() override {
+        clock = timer_read32();
+    }
+
+    static uint32_t clock;
+
+    void run_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; ++i) {
+            advance_time(1);
+            deferred_exec_task();
+        }
+    }
+};
+
+uint32_t DeferredExecMinHeap::clock = 0;
+
+} // namespace
+
+TEST_F(DeferredExecMinHeap, HundredsOfExecutorsFireOnTimeInOrder) {
+    std::vector<deferred_token> tokens;
+    for (int i = 0; i < MAX_DEFERRED_EXECUTORS; ++i) {
+        // Spread delays out of insertion order, with some collisions
+        uint32_t       delay = 1 + (i * 37) % 150;
+        deferred_token token = defer_exec(delay, record_callback, (void *)(intptr_t)i);
+        EXPECT_NE(token, INVALID_DEFERRED_TOKEN);
+        tokens.push_back(token);
+    }
+    EXPECT_EQ(std::set<deferred_token>(tokens.begin(), tokens.end()).size(), MAX_DEFERRED_EXECUTORS);
+    EXPECT_EQ(defer_exec(10, record_callback, nullptr), INVALID_DEFERRED_TOKEN);
+
+    run_for(150);
+    ASSERT_EQ(fired.size(), MAX_DEFERRED_EXECUTORS);
+    for (size_t i = 0; i < fired.size(); ++i) {
+        EXPECT_EQ(fired[i].now, fired[i].trigger_time);
+        if (i > 0) {
+            EXPECT_LE(fired[i - 1].trigger_time, fired[i].trigger_time);
+        }
+    }
+
+    // Every slot has been released again
+    for (deferred_token token : tokens) {
+        EXPECT_FALSE(cancel_deferred_exec(token));
+    }
+}
+
+TEST_F(DeferredExecMinHeap, CancelAndExtendReorderQueue) {
+    deferred_token first  = defer_exec(10, record_callback, (void *)1);
+    deferred_token second = defer_exec(20, record_callback, (void *)2);
+    deferred_token third  = defer_exec(30, record_callback, (void *)3);
+
+    EXPECT_TRUE(extend_deferred_exec(first, 40));
+    EXPECT_TRUE(cancel_deferred_exec(second));
+    EXPECT_FALSE(cancel_deferred_exec(second));
+
+    run_for(40);
+    ASSERT_EQ(fired.size(), 2);
+    EXPECT_EQ(fired[0].id, 3);
+    EXPECT_EQ(fired[1].id, 1);
+    EXPECT_FALSE(cancel_deferred_exec(third));
+}
+
+TEST_F(DeferredExecMinHeap, CallbackCancelsExecutorDueInSameTask) {
+    defer_exec(10, cancel_other_callback, (void *)1);
+    other_token = defer_exec(10, record_callback, (void *)2);
+
+    run_for(20);
+    ASSERT_EQ(fired.size(), 1);
+    EXPECT_EQ(fired[0].id, 1);
+}
+
+TEST_F(DeferredExecMinHeap, CallbackReplacesItself) {
+    other_token = defer_exec(7, requeue_self_callback, (void *)1);
+
+    run_for(30);
+    ASSERT_EQ(fired.size(), 3);
+    EXPECT_EQ(fired[1].now - fired[0].now, 7);
+    EXPECT_EQ(fired[2].now - fired[1].now, 7);
+}
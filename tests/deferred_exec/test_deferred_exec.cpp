@@ -0,0 +1,144 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <set>
+#include <vector>
+
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "deferred_exec.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+namespace {
+
+std::vector<uint32_t> fired;
+
+uint32_t record_callback(uint32_t trigger_time, void *cb_arg) {
+    fired.push_back(trigger_time);
+    return (uint32_t)(uintptr_t)cb_arg;
+}
+
+class DeferredExec : public TestFixture {
+   protected:
+    void SetUp() override {
+        fired.clear();
+        // The executor throttles against the last time it ran, so keep its clock monotonic across tests
+        set_time(clock);
+    }
+
+    void TearDown() override {
+        clock = timer_read32();
+    }
+
+    static uint32_t clock;
+
+    void run_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; ++i) {
+            advance_time(1);
+            deferred_exec_task();
+        }
+    }
+};
+
+uint32_t DeferredExec::clock = 0;
+
+} // namespace
+
+TEST_F(DeferredExec, CallbackFiresAfterDelay) {
+    deferred_token token = defer_exec(10, record_callback, nullptr);
+    EXPECT_NE(token, INVALID_DEFERRED_TOKEN);
+
+    run_for(9);
+    EXPECT_TRUE(fired.empty());
+
+    run_for(1);
+    EXPECT_EQ(fired.size(), 1);
+
+    // One-shot executors free their token once they have run
+    EXPECT_FALSE(cancel_deferred_exec(token));
+}
+
+TEST_F(DeferredExec, RepeatingCallback) {
+    deferred_token token = defer_exec(5, record_callback, (void *)(uintptr_t)5);
+
+    run_for(20);
+    EXPECT_EQ(fired.size(), 4);
+
+    EXPECT_TRUE(cancel_deferred_exec(token));
+    run_for(20);
+    EXPECT_EQ(fired.size(), 4);
+}
+
+TEST_F(DeferredExec, ExtendPostponesCallback) {
+    deferred_token token = defer_exec(10, record_callback, nullptr);
+
+    run_for(5);
+    EXPECT_TRUE(extend_deferred_exec(token, 10));
+
+    run_for(9);
+    EXPECT_TRUE(fired.empty());
+
+    run_for(1);
+    EXPECT_EQ(fired.size(), 1);
+}
+
+TEST_F(DeferredExec, InvalidRequestsAreRejected) {
+    EXPECT_EQ(defer_exec(0, record_callback, nullptr), INVALID_DEFERRED_TOKEN);
+    EXPECT_EQ(defer_exec(10, nullptr, nullptr), INVALID_DEFERRED_TOKEN);
+    EXPECT_FALSE(extend_deferred_exec(INVALID_DEFERRED_TOKEN, 10));
+    EXPECT_FALSE(cancel_deferred_exec(INVALID_DEFERRED_TOKEN));
+
+    deferred_executor_t table[1];
+    EXPECT_EQ(defer_exec_advanced(table, 0, 10, record_callback, nullptr), INVALID_DEFERRED_TOKEN);
+    EXPECT_FALSE(extend_deferred_exec_advanced(table, 0, 1, 10));
+    EXPECT_FALSE(cancel_deferred_exec_advanced(table, 0, 1));
+}
+
+TEST_F(DeferredExec, TokensAreUniqueUntilTableIsFull) {
+    std::set<deferred_token> tokens;
+    for (int i = 0; i < MAX_DEFERRED_EXECUTORS; ++i) {
+        deferred_token token = defer_exec(10, record_callback, nullptr);
+        EXPECT_NE(token, INVALID_DEFERRED_TOKEN);
+        tokens.insert(token);
+    }
+    EXPECT_EQ(tokens.size(), MAX_DEFERRED_EXECUTORS);
+    EXPECT_EQ(defer_exec(10, record_callback, nullptr), INVALID_DEFERRED_TOKEN);
+
+    for (deferred_token token : tokens) {
+        EXPECT_TRUE(cancel_deferred_exec(token));
+    }
+}
+
+TEST_F(DeferredExec, StaleTokenDoesNotCancelNewExecutor) {
+    deferred_token stale = defer_exec(10, record_callback, nullptr);
+    EXPECT_TRUE(cancel_deferred_exec(stale));
+
+    deferred_token fresh = defer_exec(10, record_callback, nullptr);
+    EXPECT_NE(fresh, stale);
+    EXPECT_FALSE(cancel_deferred_exec(stale));
+
+    run_for(10);
+    EXPECT_EQ(fired.size(), 1);
+}
+
+TEST_F(DeferredExec, StaleTokenDoesNotMatchReusedSlotInLargeTable) {
+    static deferred_executor_t table[200] = {0};
+
+    // Keep reusing the first slot, every allocation must hand out a token the previous one does not match
+    deferred_token stale = defer_exec_advanced(table, 200, 10, record_callback, nullptr);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(cancel_deferred_exec_advanced(table, 200, stale));
+        deferred_token fresh = defer_exec_advanced(table, 200, 10, record_callback, nullptr);
+        EXPECT_NE(fresh, INVALID_DEFERRED_TOKEN);
+        EXPECT_NE(fresh, stale);
+        EXPECT_FALSE(cancel_deferred_exec_advanced(table, 200, stale));
+        stale = fresh;
+    }
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, 200, stale));
+}
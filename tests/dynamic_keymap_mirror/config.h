@@ -0,0 +1,13 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define TRANSIENT_EEPROM_SIZE 1024
+#define DYNAMIC_KEYMAP_LAYER_COUNT 1
+#define DYNAMIC_KEYMAP_RAM_MIRROR
+
+// Macro addresses are cast to pointers at runtime, which needs a pointer sized integer on the host
+#define DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR ((uintptr_t)(DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR))
@@ -0,0 +1,6 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+DYNAMIC_KEYMAP_ENABLE = yes
+# Erased by eeconfig, unlike the test harness EEPROM
+EEPROM_DRIVER = transient
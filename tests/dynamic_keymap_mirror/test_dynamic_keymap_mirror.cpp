@@ -0,0 +1,85 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "eeconfig.h"
+#include "eeprom.h"
+}
+
+class DynamicKeymapMirror : public TestFixture {
+   protected:
+    // Reads a keycode straight from EEPROM, bypassing the mirror
+    uint16_t eeprom_keycode(uint8_t layer, uint8_t row, uint8_t column) {
+        const uint8_t *address = (const uint8_t *)dynamic_keymap_key_to_eeprom_address(layer, row, column);
+        return (eeprom_read_byte(address) << 8) | eeprom_read_byte(address + 1);
+    }
+};
+
+TEST_F(DynamicKeymapMirror, SetKeycode_WrittenBackOnFlush) {
+    dynamic_keymap_reset();
+    dynamic_keymap_flush();
+
+    dynamic_keymap_set_keycode(0, 1, 2, KC_A);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 2), KC_A);
+    EXPECT_EQ(eeprom_keycode(0, 1, 2), KC_NO) << "Write back should wait for the delay";
+
+    dynamic_keymap_flush();
+    EXPECT_EQ(eeprom_keycode(0, 1, 2), KC_A);
+}
+
+TEST_F(DynamicKeymapMirror, ResetAfterErase_RewritesAll) {
+    dynamic_keymap_reset();
+    dynamic_keymap_flush();
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_NO);
+
+    // Erase the EEPROM behind the mirror's back, as eeconfig_init_quantum() does before resetting the keymap
+    uint8_t erased[MATRIX_ROWS * MATRIX_COLS * 2];
+    memset(erased, 0xFF, sizeof(erased));
+    for (uint8_t layer = 0; layer < dynamic_keymap_get_layer_count(); layer++) {
+        eeprom_update_block(erased, dynamic_keymap_key_to_eeprom_address(layer, 0, 0), sizeof(erased));
+    }
+
+    dynamic_keymap_reset();
+    dynamic_keymap_flush();
+    for (uint8_t layer = 0; layer < dynamic_keymap_get_layer_count(); layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+                EXPECT_EQ(eeprom_keycode(layer, row, column), KC_NO) << "Key " << (int)layer << "," << (int)row << "," << (int)column << " should be reset";
+            }
+        }
+    }
+}
+
+TEST_F(DynamicKeymapMirror, EeconfigInit_ReloadsErasedKeymap) {
+    dynamic_keymap_reset();
+    dynamic_keymap_set_keycode(0, 1, 2, KC_A);
+    dynamic_keymap_flush();
+    dynamic_keymap_set_keycode(0, 1, 3, KC_B);
+
+    // Erases the EEPROM, the pending write back must not restore what was there before
+    eeconfig_init_quantum();
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 2), KC_NO);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 3), KC_NO);
+
+    dynamic_keymap_flush();
+    EXPECT_EQ(eeprom_keycode(0, 1, 3), KC_NO);
+}
+
+TEST_F(DynamicKeymapMirror, EeconfigDisable_ReloadsErasedKeymap) {
+    dynamic_keymap_reset();
+    dynamic_keymap_set_keycode(0, 1, 2, KC_A);
+    dynamic_keymap_flush();
+    dynamic_keymap_set_keycode(0, 1, 3, KC_B);
+
+    eeconfig_disable();
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 2), KC_NO);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 3), KC_NO);
+
+    dynamic_keymap_flush();
+    EXPECT_EQ(eeprom_keycode(0, 1, 3), KC_NO);
+    eeconfig_init();
+}
@@ -0,0 +1,10 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Fewer entries than there are overrides, so that every lookup falls back to scanning key_overrides
+#define KEY_OVERRIDE_INDEX_SIZE 2
+#define KEY_OVERRIDE_REPEAT_DELAY 100
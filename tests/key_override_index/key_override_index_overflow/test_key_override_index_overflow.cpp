@@ -0,0 +1,91 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "quantum.h"
+#include "keycode.h"
+#include "test_common.h"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class KeyOverrideIndexOverflow : public TestFixture {};
+
+TEST_F(KeyOverrideIndexOverflow, trigger_pressed_with_mods) {
+    TestDriver driver;
+    KeymapKey  key_shift(0, 0, 0, KC_LSFT);
+    KeymapKey  key_bspc(0, 1, 0, KC_BSPC);
+    set_keymap({key_shift, key_bspc});
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_shift.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_DEL));
+    key_bspc.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_bspc.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverrideIndexOverflow, trigger_pressed_without_mods) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverrideIndexOverflow, first_matching_override_wins) {
+    TestDriver driver;
+    KeymapKey  key_ctrl(0, 0, 0, KC_LCTL);
+    KeymapKey  key_shift(0, 1, 0, KC_RSFT);
+    KeymapKey  key_a(0, 2, 0, KC_A);
+    set_keymap({key_ctrl, key_shift, key_a});
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+    EXPECT_REPORT(driver, (KC_F1)).Times(1);
+    EXPECT_REPORT(driver, (KC_F2)).Times(0);
+    key_ctrl.press();
+    key_shift.press();
+    run_one_scan_loop();
+    tap_key(key_a);
+    key_ctrl.release();
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverrideIndexOverflow, override_past_index_size) {
+    TestDriver driver;
+    KeymapKey  key_gui(0, 0, 0, KC_RGUI);
+    set_keymap({key_gui});
+
+    // The last override in the list, beyond what the index could have held
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+    EXPECT_REPORT(driver, (KC_F4)).Times(1);
+    key_gui.press();
+    idle_for(KEY_OVERRIDE_REPEAT_DELAY * 2);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+    key_gui.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,23 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+const key_override_t shift_bspc_override   = ko_make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_DEL);
+const key_override_t ctrl_shift_a_override = ko_make_basic(MOD_MASK_CS, KC_A, KC_F1);
+const key_override_t ctrl_a_override       = ko_make_basic(MOD_MASK_CTRL, KC_A, KC_F2);
+const key_override_t ctrl_b_override       = ko_make_basic(MOD_MASK_CTRL, KC_B, KC_F3);
+const key_override_t rgui_override         = ko_make_basic(MOD_BIT(KC_RGUI), KC_NO, KC_F4);
+
+// clang-format off
+const key_override_t *test_key_overrides[] = {
+    &shift_bspc_override,
+    &ctrl_shift_a_override,
+    &ctrl_a_override,
+    &ctrl_b_override,
+    &rgui_override,
+    NULL
+};
+// clang-format on
+
+const key_override_t **key_overrides = test_key_overrides;
@@ -0,0 +1,10 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Large enough to hold more than 64KiB of glyphs without evicting any
+#define QUANTUM_PAINTER_GLYPH_CACHE_SIZE (96 * 1024)
+#define QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES 1024
@@ -0,0 +1,127 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "qp.h"
+#include "qp_surface.h"
+#include "thintel15.qff.h"
+}
+
+#define SURFACE_WIDTH 64
+#define SURFACE_HEIGHT 16
+
+static uint8_t          framebuffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(SURFACE_WIDTH, SURFACE_HEIGHT, 16)];
+static painter_device_t surface;
+
+class GlyphCache : public TestFixture {
+   protected:
+    painter_font_handle_t font;
+
+    void SetUp() override {
+        if (!surface) {
+            surface = qp_make_rgb565_surface(SURFACE_WIDTH, SURFACE_HEIGHT, framebuffer);
+        }
+        ASSERT_NE(surface, nullptr);
+        ASSERT_TRUE(qp_init(surface, QP_ROTATION_0));
+        font = qp_load_font_mem(font_thintel15);
+        ASSERT_NE(font, nullptr);
+        qp_glyph_cache_clear();
+    }
+
+    void TearDown() override {
+        qp_close_font(font);
+    }
+
+    // Draws the string in the given foreground hue, each hue making distinct cache entries for the same code points
+    void draw(const char *str, uint8_t hue = 0) {
+        ASSERT_GT(qp_drawtext_recolor(surface, 0, 0, font, str, hue, 255, 255, 0, 0, 0), 0);
+    }
+
+    // Size of the native pixel data of the given glyph on the rgb565 surface
+    uint32_t glyph_bytes(const char *str) {
+        return (uint32_t)qp_textwidth(font, str) * font->line_height * 2;
+    }
+
+    painter_glyph_cache_stats_t stats() {
+        painter_glyph_cache_stats_t stats;
+        qp_glyph_cache_get_stats(&stats);
+        return stats;
+    }
+};
+
+TEST_F(GlyphCache, FirstDrawMisses) {
+    draw("A");
+
+    EXPECT_EQ(stats().misses, 1);
+    EXPECT_EQ(stats().hits, 0);
+    EXPECT_EQ(stats().entries, 1);
+    EXPECT_EQ(stats().bytes_used, glyph_bytes("A"));
+}
+
+TEST_F(GlyphCache, RedrawHitsWithSamePixels) {
+    draw("A");
+    uint8_t decoded[sizeof(framebuffer)];
+    memcpy(decoded, framebuffer, sizeof(framebuffer));
+
+    ASSERT_TRUE(qp_clear(surface));
+    draw("A");
+
+    EXPECT_EQ(stats().misses, 1);
+    EXPECT_EQ(stats().hits, 1);
+    EXPECT_EQ(stats().entries, 1);
+    EXPECT_EQ(memcmp(decoded, framebuffer, sizeof(framebuffer)), 0);
+}
+
+TEST_F(GlyphCache, OtherColorMisses) {
+    draw("A", 0);
+    draw("A", 85);
+
+    EXPECT_EQ(stats().misses, 2);
+    EXPECT_EQ(stats().hits, 0);
+    EXPECT_EQ(stats().entries, 2);
+}
+
+TEST_F(GlyphCache, BytesUsedCountsPast64KiB) {
+    uint32_t expected = 0;
+    char     str[2]   = {0};
+    for (uint8_t hue = 0; expected <= UINT16_MAX; hue++) {
+        for (str[0] = ' '; str[0] <= '~' && expected <= UINT16_MAX; str[0]++) {
+            expected += glyph_bytes(str);
+            draw(str, hue);
+        }
+    }
+
+    ASSERT_EQ(stats().evictions, 0);
+    EXPECT_EQ(stats().bytes_used, expected);
+}
+
+TEST_F(GlyphCache, FullCacheEvictsOldestGlyph) {
+    char    str[2] = {0};
+    uint8_t hue;
+    for (hue = 0; stats().evictions == 0; hue++) {
+        for (str[0] = ' '; str[0] <= '~'; str[0]++) {
+            draw(str, hue);
+            if (stats().evictions > 0) {
+                break;
+            }
+        }
+        if (stats().evictions > 0) {
+            break;
+        }
+    }
+
+    EXPECT_LE(stats().entries, QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES);
+    EXPECT_LE(stats().bytes_used, QUANTUM_PAINTER_GLYPH_CACHE_SIZE);
+
+    // The newest glyph is still cached, the very first one was evicted to make room for it
+    uint32_t misses = stats().misses;
+    draw(str, hue);
+    EXPECT_EQ(stats().misses, misses);
+    draw(" ", 0);
+    EXPECT_EQ(stats().misses, misses + 1);
+}
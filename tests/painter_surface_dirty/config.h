@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// One rgb565 and one mono1bpp surface
+#define SURFACE_NUM_DEVICES 2
@@ -0,0 +1,138 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "qp.h"
+#include "qp_surface.h"
+#include "qp_surface_internal.h"
+}
+
+#define SURFACE_WIDTH 128
+#define SURFACE_HEIGHT 128
+
+class SurfaceDirty : public TestFixture {
+   protected:
+    surface_dirty_data_t dirty;
+
+    void SetUp() override {
+        // Same state as a flushed surface
+        dirty   = {};
+        dirty.l = dirty.t = UINT16_MAX;
+    }
+
+    void update(uint16_t x, uint16_t y) {
+        qp_surface_update_dirty_regions(&dirty, x, y);
+    }
+
+    // Finds the region covering the given pixel
+    const surface_dirty_region_t *region_at(uint16_t x, uint16_t y) {
+        for (uint8_t i = 0; i < dirty.region_count; ++i) {
+            const surface_dirty_region_t *region = &dirty.regions[i];
+            if (region->l <= x && x <= region->r && region->t <= y && y <= region->b) {
+                return region;
+            }
+        }
+        return nullptr;
+    }
+
+    void expect_region(uint16_t l, uint16_t t, uint16_t r, uint16_t b) {
+        const surface_dirty_region_t *region = region_at(l, t);
+        ASSERT_NE(region, nullptr);
+        EXPECT_EQ(region->l, l);
+        EXPECT_EQ(region->t, t);
+        EXPECT_EQ(region->r, r);
+        EXPECT_EQ(region->b, b);
+    }
+};
+
+TEST_F(SurfaceDirty, AdjacentPixelsMergeIntoOneRegion) {
+    update(10, 10);
+    update(11, 10);
+    update(10, 11);
+    update(10 + SURFACE_DIRTY_MERGE_DISTANCE, 10);
+
+    EXPECT_EQ(dirty.region_count, 1);
+    expect_region(10, 10, 10 + SURFACE_DIRTY_MERGE_DISTANCE, 11);
+}
+
+TEST_F(SurfaceDirty, FarPixelsTrackSeparateRegions) {
+    update(0, 0);
+    update(1 + SURFACE_DIRTY_MERGE_DISTANCE, 0);
+    update(100, 100);
+
+    EXPECT_EQ(dirty.region_count, 3);
+    expect_region(0, 0, 0, 0);
+    expect_region(1 + SURFACE_DIRTY_MERGE_DISTANCE, 0, 1 + SURFACE_DIRTY_MERGE_DISTANCE, 0);
+    expect_region(100, 100, 100, 100);
+
+    // The bounding box still covers everything
+    EXPECT_TRUE(dirty.is_dirty);
+    EXPECT_EQ(dirty.l, 0);
+    EXPECT_EQ(dirty.t, 0);
+    EXPECT_EQ(dirty.r, 100);
+    EXPECT_EQ(dirty.b, 100);
+}
+
+TEST_F(SurfaceDirty, FullRegionsGrowTheCheapestOne) {
+    for (uint8_t i = 0; i < SURFACE_DIRTY_REGION_COUNT; ++i) {
+        update(i * 30, i * 30);
+    }
+    ASSERT_EQ(dirty.region_count, SURFACE_DIRTY_REGION_COUNT);
+
+    // Closest to the first region, but too far away to be merged into it
+    update(0, 20);
+
+    EXPECT_EQ(dirty.region_count, SURFACE_DIRTY_REGION_COUNT);
+    expect_region(0, 0, 0, 20);
+    for (uint8_t i = 1; i < SURFACE_DIRTY_REGION_COUNT; ++i) {
+        expect_region(i * 30, i * 30, i * 30, i * 30);
+    }
+}
+
+TEST_F(SurfaceDirty, GrownRegionCoalescesWithNeighbours) {
+    update(0, 0);
+    update(2 * SURFACE_DIRTY_MERGE_DISTANCE, 0);
+    update(0, 2 * SURFACE_DIRTY_MERGE_DISTANCE);
+    update(100, 100);
+    ASSERT_EQ(dirty.region_count, 4);
+
+    // Within reach of all three regions in the corner, which end up merged into one
+    update(SURFACE_DIRTY_MERGE_DISTANCE, SURFACE_DIRTY_MERGE_DISTANCE);
+
+    EXPECT_EQ(dirty.region_count, 2);
+    expect_region(0, 0, 2 * SURFACE_DIRTY_MERGE_DISTANCE, 2 * SURFACE_DIRTY_MERGE_DISTANCE);
+    expect_region(100, 100, 100, 100);
+}
+
+TEST_F(SurfaceDirty, OnlyRgb565SurfacesTrackRegions) {
+    static uint8_t   rgb565_buffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(SURFACE_WIDTH, SURFACE_HEIGHT, 16)];
+    static uint8_t   mono1bpp_buffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(SURFACE_WIDTH, SURFACE_HEIGHT, 1)];
+    painter_device_t rgb565   = qp_make_rgb565_surface(SURFACE_WIDTH, SURFACE_HEIGHT, rgb565_buffer);
+    painter_device_t mono1bpp = qp_make_mono1bpp_surface(SURFACE_WIDTH, SURFACE_HEIGHT, mono1bpp_buffer);
+    ASSERT_NE(rgb565, nullptr);
+    ASSERT_NE(mono1bpp, nullptr);
+
+    for (painter_device_t device : {rgb565, mono1bpp}) {
+        ASSERT_TRUE(qp_init(device, QP_ROTATION_0));
+        ASSERT_TRUE(qp_flush(device));
+        ASSERT_TRUE(qp_setpixel(device, 0, 0, 0, 0, 255));
+        ASSERT_TRUE(qp_setpixel(device, 100, 100, 0, 0, 255));
+    }
+
+    surface_dirty_data_t *rgb565_dirty   = &((surface_painter_device_t *)rgb565)->dirty;
+    surface_dirty_data_t *mono1bpp_dirty = &((surface_painter_device_t *)mono1bpp)->dirty;
+    EXPECT_EQ(rgb565_dirty->region_count, 2);
+    EXPECT_EQ(mono1bpp_dirty->region_count, 0);
+
+    // Both still keep the bounding box
+    for (surface_dirty_data_t *dirty : {rgb565_dirty, mono1bpp_dirty}) {
+        EXPECT_TRUE(dirty->is_dirty);
+        EXPECT_EQ(dirty->l, 0);
+        EXPECT_EQ(dirty->t, 0);
+        EXPECT_EQ(dirty->r, 100);
+        EXPECT_EQ(dirty->b, 100);
+    }
+}
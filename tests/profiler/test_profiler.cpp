@@ -0,0 +1,123 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "profiler.h"
+
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+
+class Profiler : public TestFixture {};
+
+static void busy_for(uint32_t ms) {
+    advance_time(ms);
+}
+
+TEST_F(Profiler, KeyboardTasksAreInstrumented) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+
+    const profiler_zone_t *matrix  = profiler_find_zone("matrix_task");
+    const profiler_zone_t *quantum = profiler_find_zone("quantum_task");
+    ASSERT_NE(matrix, nullptr);
+    ASSERT_NE(quantum, nullptr);
+    EXPECT_GT(matrix->calls, 0);
+    EXPECT_GT(quantum->calls, 0);
+}
+
+TEST_F(Profiler, ZoneStatistics) {
+    for (uint32_t i = 1; i <= 100; i++) {
+        PROFILE_ZONE("stats", busy_for(i));
+    }
+
+    const profiler_zone_t *zone = profiler_find_zone("stats");
+    ASSERT_NE(zone, nullptr);
+    EXPECT_EQ(zone->calls, 100);
+    EXPECT_EQ(zone->min, 1);
+    EXPECT_EQ(zone->max, 100);
+    EXPECT_EQ(profiler_zone_mean(zone), 50);
+    EXPECT_EQ(profiler_zone_percentile(zone, 99), 100);
+    EXPECT_EQ(profiler_zone_percentile(zone, 50), 63);
+
+    profiler_reset();
+    EXPECT_EQ(zone->calls, 0);
+    EXPECT_EQ(profiler_zone_percentile(zone, 99), 0);
+}
+
+TEST_F(Profiler, NestedZones) {
+    for (int i = 0; i < 10; i++) {
+        PROFILE_ZONE("outer", {
+            busy_for(2);
+            PROFILE_ZONE("inner", busy_for(3));
+        });
+    }
+
+    const profiler_zone_t *outer = profiler_find_zone("outer");
+    const profiler_zone_t *inner = profiler_find_zone("inner");
+    ASSERT_NE(outer, nullptr);
+    ASSERT_NE(inner, nullptr);
+    EXPECT_EQ(inner->parent, outer);
+    EXPECT_EQ(inner->depth, outer->depth + 1);
+    EXPECT_EQ(outer->total, 50);
+    EXPECT_EQ(outer->self, 20);
+    EXPECT_EQ(inner->total, 30);
+    EXPECT_EQ(inner->self, 30);
+}
+
+TEST_F(Profiler, ExpressionZonesReturnResult) {
+    EXPECT_EQ(PROFILE_EXPR("expr", 40 + 2), 42);
+    ASSERT_NE(profiler_find_zone("expr"), nullptr);
+    EXPECT_EQ(profiler_find_zone("expr")->calls, 1);
+}
+
+TEST_F(Profiler, RawHidQueries) {
+    PROFILE_ZONE("raw_hid_zone", busy_for(7));
+
+    uint8_t data[32] = {0xFE, 0x01};
+    EXPECT_TRUE(profiler_raw_hid_receive(data, sizeof(data)));
+    uint8_t count = data[2];
+    EXPECT_EQ(count, profiler_zone_count());
+
+    uint8_t index = 0;
+    while (index < count && profiler_get_zone(index) != profiler_find_zone("raw_hid_zone")) {
+        index++;
+    }
+    ASSERT_LT(index, count);
+
+    memset(data, 0, sizeof(data));
+    data[0] = 0xFE;
+    data[1] = 0x02;
+    data[2] = index;
+    EXPECT_TRUE(profiler_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(data[0], 0xFE);
+    EXPECT_EQ(data[8], 1);  // calls
+    EXPECT_EQ(data[12], 7); // min
+    EXPECT_EQ(data[24], 7); // max
+
+    memset(data, 0, sizeof(data));
+    data[0] = 0xFE;
+    data[1] = 0x03;
+    data[2] = index;
+    data[3] = 4;
+    EXPECT_TRUE(profiler_raw_hid_receive(data, sizeof(data)));
+    EXPECT_STREQ((const char *)&data[4], "hid_zone");
+
+    memset(data, 0, sizeof(data));
+    data[0] = 0xFE;
+    data[1] = 0x02;
+    data[2] = UINT8_MAX;
+    EXPECT_TRUE(profiler_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(data[0], 0xFF);
+
+    data[0] = 0x01;
+    EXPECT_FALSE(profiler_raw_hid_receive(data, sizeof(data)));
+}
@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define REPORT_SCHEDULER_ENABLE
+#define REPORT_SCHEDULER_QUEUE_SIZE 4
@@ -0,0 +1,248 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+extern "C" {
+void advance_time(uint32_t ms);
+}
+
+static bool host_ready = true;
+
+extern "C" bool host_keyboard_ready(void) {
+    return host_ready;
+}
+
+class ReportScheduler : public TestFixture {
+   public:
+    void SetUp() override {
+        host_ready = true;
+        // Let a polling interval pass since the reports of the previous test
+        advance_time(1);
+        report_scheduler_reset_stats();
+    }
+};
+
+/**
+ * This test verifies that changes made within one polling interval are spread over the following ones, in order.
+ */
+TEST_F(ReportScheduler, Burst_PacedInOrder) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    register_code(KC_LEFT_SHIFT);
+    register_code(KC_A);
+    unregister_code(KC_A);
+    unregister_code(KC_LEFT_SHIFT);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(report_scheduler_depth(), 3);
+
+    // Nothing more goes out until the next polling interval
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(report_scheduler_depth(), 0);
+    EXPECT_EQ(report_scheduler_stats.sent, 4);
+    EXPECT_EQ(report_scheduler_stats.merged, 0);
+    EXPECT_EQ(report_scheduler_stats.peak_depth, 3);
+}
+
+/**
+ * This test verifies that a modifier followed by a key press is merged into one report.
+ */
+TEST_F(ReportScheduler, ModifierThenKey_Merged) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_B));
+    register_code(KC_B);
+    register_code(KC_LEFT_SHIFT);
+    register_code(KC_A);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_B, KC_A));
+    idle_for(5);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(report_scheduler_stats.merged, 1);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    unregister_code(KC_B);
+    clear_keyboard();
+    idle_for(5);
+    VERIFY_AND_CLEAR(driver);
+}
+
+/**
+ * This test verifies that a key press followed by a modifier change is kept apart, as the modifier would otherwise apply to the key.
+ */
+TEST_F(ReportScheduler, KeyThenModifier_NotMerged) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_REPORT(driver, (KC_B, KC_A));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_B, KC_A));
+    register_code(KC_B);
+    register_code(KC_A);
+    register_code(KC_LEFT_SHIFT);
+    idle_for(5);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(report_scheduler_stats.merged, 0);
+
+    EXPECT_EMPTY_REPORT(driver);
+    clear_keyboard();
+    idle_for(5);
+    VERIFY_AND_CLEAR(driver);
+}
+
+/**
+ * This test verifies that only one key press goes into each report, so that the host sees them in order, while releases are folded in.
+ */
+TEST_F(ReportScheduler, Roll_PressesKeptInOrder) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    register_code(KC_A);
+    register_code(KC_B);
+    unregister_code(KC_A);
+    register_code(KC_C);
+    unregister_code(KC_B);
+    idle_for(5);
+    unregister_code(KC_C);
+    idle_for(5);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(report_scheduler_stats.merged, 2);
+}
+
+/**
+ * This test verifies that a key tapped within one polling interval still reaches the host.
+ */
+TEST_F(ReportScheduler, Tap_NotLost) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_code(KC_A);
+    tap_code(KC_A);
+    idle_for(5);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(report_scheduler_stats.merged, 0);
+}
+
+/**
+ * This test verifies that reports are held back while the host is busy, and that a full queue turns a report away until there is room, rather than blocking.
+ */
+TEST_F(ReportScheduler, HostBusy_HeldBack) {
+    TestDriver driver;
+    InSequence s;
+
+    host_ready = false;
+    EXPECT_NO_REPORT(driver);
+    register_code(KC_A);
+    unregister_code(KC_A);
+    register_code(KC_A);
+    unregister_code(KC_A);
+    idle_for(5);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(report_scheduler_depth(), 4);
+
+    // Pressing C is folded into the release of A, while releasing it needs room of its own
+    EXPECT_NO_REPORT(driver);
+    register_code(KC_C);
+    unregister_code(KC_C);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(report_scheduler_stats.overflows, 1);
+    EXPECT_EQ(report_scheduler_depth(), 4);
+
+    host_ready = true;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(report_scheduler_stats.peak_depth, 4);
+}
+
+/**
+ * This test verifies that tap_code() hands its reports to the host before returning.
+ */
+TEST_F(ReportScheduler, TapCode_Flushed) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_code(KC_A);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(report_scheduler_depth(), 0);
+}
+
+/**
+ * This test verifies that flushing gives up waiting on a host that stays busy, and sends what is left.
+ */
+TEST_F(ReportScheduler, FlushHostBusy_SentAfterTimeout) {
+    TestDriver driver;
+    InSequence s;
+
+    host_ready = false;
+    EXPECT_NO_REPORT(driver);
+    register_code(KC_A);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    clear_keyboard();
+    report_scheduler_flush();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(report_scheduler_depth(), 0);
+}
+
+/**
+ * This test verifies that reports which change nothing are dropped.
+ */
+TEST_F(ReportScheduler, Unchanged_Dropped) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    register_code(KC_A);
+    send_keyboard_report();
+    idle_for(5);
+    send_keyboard_report();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(report_scheduler_stats.dropped, 2);
+
+    EXPECT_EMPTY_REPORT(driver);
+    unregister_code(KC_A);
+    idle_for(5);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,100 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+
+class ResolvedLayerCache : public TestFixture {};
+
+TEST_F(ResolvedLayerCache, FollowsLayerState) {
+    TestDriver driver;
+    KeymapKey  base_key        = KeymapKey{0, 0, 0, KC_A};
+    KeymapKey  transparent_key = KeymapKey{1, 0, 0, KC_TRANSPARENT};
+    KeymapKey  upper_key       = KeymapKey{2, 0, 0, KC_B};
+    set_keymap({base_key, transparent_key, upper_key});
+
+    EXPECT_EQ(layer_switch_get_layer(base_key.position), 0);
+
+    /* Transparent layer on top falls through to the base layer. */
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(base_key.position), 0);
+
+    layer_on(2);
+    EXPECT_EQ(layer_switch_get_layer(base_key.position), 2);
+
+    /* Deactivating a transparent layer below the resolved one keeps it. */
+    layer_off(1);
+    EXPECT_EQ(layer_switch_get_layer(base_key.position), 2);
+
+    layer_off(2);
+    EXPECT_EQ(layer_switch_get_layer(base_key.position), 0);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ResolvedLayerCache, FollowsDefaultLayerState) {
+    TestDriver driver;
+    KeymapKey  base_key  = KeymapKey{0, 0, 0, KC_A};
+    KeymapKey  other_key = KeymapKey{1, 0, 0, KC_B};
+    set_keymap({base_key, other_key});
+
+    EXPECT_EQ(layer_switch_get_layer(base_key.position), 0);
+
+    default_layer_set(1 << 1);
+    EXPECT_EQ(layer_switch_get_layer(base_key.position), 1);
+
+    default_layer_set(1 << 0);
+    EXPECT_EQ(layer_switch_get_layer(base_key.position), 0);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ResolvedLayerCache, InvalidatesKey) {
+    TestDriver driver;
+    KeymapKey  base_key = KeymapKey{0, 0, 0, KC_A};
+    set_keymap({base_key, KeymapKey{1, 0, 0, KC_TRANSPARENT}});
+
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(base_key.position), 0);
+
+    /* Keymap changes are only picked up once the key is invalidated. */
+    set_keymap({base_key, KeymapKey{1, 0, 0, KC_B}});
+    EXPECT_EQ(layer_switch_get_layer(base_key.position), 0);
+
+    resolved_layers_cache_invalidate(base_key.position);
+    EXPECT_EQ(layer_switch_get_layer(base_key.position), 1);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ResolvedLayerCache, ReleasesFromPressedLayer) {
+    TestDriver driver;
+    KeymapKey  layer_key   = KeymapKey{0, 0, 0, MO(1)};
+    KeymapKey  regular_key = KeymapKey{0, 1, 0, KC_A};
+    set_keymap({layer_key, regular_key, KeymapKey{1, 0, 0, KC_TRANSPARENT}, KeymapKey{1, 1, 0, KC_B}});
+
+    EXPECT_REPORT(driver, (KC_A)).Times(1);
+    EXPECT_EMPTY_REPORT(driver).Times(1);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+
+    layer_key.press();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_B)).Times(1);
+    EXPECT_EMPTY_REPORT(driver).Times(1);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    layer_key.release();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_A)).Times(1);
+    EXPECT_EMPTY_REPORT(driver).Times(1);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+}
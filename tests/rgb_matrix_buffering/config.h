@@ -0,0 +1,11 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define RGB_MATRIX_LED_COUNT 6
+// Renders each frame over several passes when not double buffered
+#define RGB_MATRIX_LED_PROCESS_LIMIT 2
+#define ENABLE_RGB_MATRIX_GRADIENT_LEFT_RIGHT
@@ -0,0 +1,5 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Double buffered, expecting the same frames as the single buffered build
+#include "../rgb_matrix_frames.hpp"
@@ -0,0 +1,49 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+#include "rgb_matrix_frames.h"
+
+// A single row of LEDs, spread out evenly from left to right
+led_config_t g_led_config = {{
+    {0, 1, 2, 3, 4, 5, NO_LED, NO_LED, NO_LED, NO_LED},
+    {NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+    {NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+    {NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED, NO_LED},
+}, {
+    {0, 32}, {40, 32}, {80, 32}, {120, 32}, {160, 32}, {200, 32}
+}, {
+    4, 4, 4, 4, 4, 4
+}};
+
+RGB  driver_leds[RGB_MATRIX_LED_COUNT];
+bool indicator_leds[RGB_MATRIX_LED_COUNT];
+
+static void driver_init(void) {}
+
+static void driver_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    driver_leds[index] = (RGB){.r = red, .g = green, .b = blue};
+}
+
+static void driver_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        driver_set_color(i, red, green, blue);
+    }
+}
+
+static void driver_flush(void) {}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = driver_init,
+    .set_color     = driver_set_color,
+    .set_color_all = driver_set_color_all,
+    .flush         = driver_flush,
+};
+
+bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {
+    for (uint8_t i = led_min; i < led_max; i++) {
+        indicator_leds[i] = true;
+    }
+    RGB_MATRIX_INDICATOR_SET_COLOR(INDICATOR_LED, 255, 0, 0);
+    return false;
+}
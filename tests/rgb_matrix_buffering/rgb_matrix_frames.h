@@ -0,0 +1,14 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "color.h"
+
+// Set to red by the advanced indicators, on top of the effect
+#define INDICATOR_LED 5
+
+// Colors last passed on to the driver, like the driver's own buffer these are kept from one test to the next
+extern RGB driver_leds[RGB_MATRIX_LED_COUNT];
+// LEDs covered by the advanced indicators
+extern bool indicator_leds[RGB_MATRIX_LED_COUNT];
@@ -0,0 +1,83 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// rgb_matrix_types.h checks the size of rgb_config_t with the C spelling
+#define _Static_assert static_assert
+
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "rgb_matrix_frames.h"
+#include "lib/lib8tion/lib8tion.h"
+}
+
+using testing::_;
+
+/* Both the single and double buffered builds check the frames passed on to the driver against the same reference, so
+ * that their output is the same. */
+class RgbMatrixFrames : public TestFixture {
+   protected:
+    void SetUp() override {
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_sethsv_noeeprom(10, 255, 255);
+        rgb_matrix_set_speed_noeeprom(128);
+        memset(indicator_leds, 0, sizeof(indicator_leds));
+    }
+
+    // Renders a few complete frames
+    void render(void) {
+        TestDriver driver;
+        EXPECT_NO_REPORT(driver);
+        idle_for(100);
+        VERIFY_AND_CLEAR(driver);
+    }
+
+    // The order of the fields depends on the driver, so they cannot be initialized in order
+    static RGB rgb(uint8_t red, uint8_t green, uint8_t blue) {
+        RGB rgb;
+        rgb.r = red;
+        rgb.g = green;
+        rgb.b = blue;
+        return rgb;
+    }
+
+    void expect_frame(const RGB expected[RGB_MATRIX_LED_COUNT]) {
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            EXPECT_EQ(driver_leds[i].r, expected[i].r) << "LED " << +i;
+            EXPECT_EQ(driver_leds[i].g, expected[i].g) << "LED " << +i;
+            EXPECT_EQ(driver_leds[i].b, expected[i].b) << "LED " << +i;
+            EXPECT_TRUE(indicator_leds[i]) << "LED " << +i << " was not covered by the advanced indicators";
+        }
+    }
+};
+
+TEST_F(RgbMatrixFrames, GradientLeftRight) {
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_GRADIENT_LEFT_RIGHT);
+    render();
+
+    RGB     expected[RGB_MATRIX_LED_COUNT];
+    HSV     hsv   = rgb_matrix_get_hsv();
+    uint8_t scale = scale8(64, rgb_matrix_get_speed());
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        HSV led_hsv = {.h = (uint8_t)(hsv.h + (scale * g_led_config.point[i].x >> 5)), .s = hsv.s, .v = hsv.v};
+        expected[i] = hsv_to_rgb(led_hsv);
+    }
+    expected[INDICATOR_LED] = rgb(255, 0, 0);
+    expect_frame(expected);
+}
+
+TEST_F(RgbMatrixFrames, SolidColor) {
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+    render();
+
+    RGB expected[RGB_MATRIX_LED_COUNT];
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        expected[i] = hsv_to_rgb(rgb_matrix_get_hsv());
+    }
+    expected[INDICATOR_LED] = rgb(255, 0, 0);
+    expect_frame(expected);
+}
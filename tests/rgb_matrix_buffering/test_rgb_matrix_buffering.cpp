@@ -0,0 +1,5 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Single buffered, rendering each frame over several passes
+#include "rgb_matrix_frames.hpp"
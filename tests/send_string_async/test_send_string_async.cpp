@@ -0,0 +1,147 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+static bool host_ready = true;
+
+extern "C" bool send_string_async_ready(void) {
+    return host_ready;
+}
+
+class SendStringAsync : public TestFixture {
+   public:
+    void SetUp() override {
+        host_ready = true;
+    }
+};
+
+/**
+ * This test verifies that queued strings are typed out one report per scan loop, rather than all at once.
+ */
+TEST_F(SendStringAsync, OneReportPerLoop) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_NO_REPORT(driver);
+    EXPECT_TRUE(send_string_async("aB"));
+    EXPECT_TRUE(send_string_async_busy());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_B));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(3);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_FALSE(send_string_async_busy());
+    EXPECT_NO_REPORT(driver);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
+
+/**
+ * This test verifies that keycodes and delays embedded in the string are honoured.
+ */
+TEST_F(SendStringAsync, KeycodesAndDelays) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_ENTER));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_TRUE(SEND_STRING_ASYNC(SS_DOWN(X_LEFT_CTRL) SS_TAP(X_ENTER) SS_UP(X_LEFT_CTRL) SS_DELAY(20) "a"));
+    idle_for(4);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(19);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+/**
+ * This test verifies that nothing is sent while the host is not ready for the next report.
+ */
+TEST_F(SendStringAsync, WaitsForHost) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_TRUE(send_string_async("a"));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    host_ready = false;
+    EXPECT_NO_REPORT(driver);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    host_ready = true;
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+/**
+ * This test verifies that strings longer than the queue are read as room frees up, and that a new one is only taken once the previous one has been read.
+ */
+TEST_F(SendStringAsync, LongString) {
+    TestDriver driver;
+
+    EXPECT_REPORT(driver, (KC_1)).Times(11);
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT)).Times(4);
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_1)).Times(2);
+    EXPECT_EMPTY_REPORT(driver).Times(13);
+    EXPECT_TRUE(send_string_async("1111!11111!1"));
+    EXPECT_FALSE(send_string_async("1")) << "The first string should still be being read";
+
+    // With room for a single character in the queue, the last one is only read once the rest have been sent
+    idle_for(25);
+    EXPECT_FALSE(send_string_async("1"));
+    run_one_scan_loop();
+    EXPECT_TRUE(send_string_async_busy());
+    EXPECT_TRUE(send_string_async("1"));
+    idle_for(40);
+    EXPECT_FALSE(send_string_async_busy());
+    VERIFY_AND_CLEAR(driver);
+}
+
+/**
+ * This test verifies that blocking calls send whatever is still queued first.
+ */
+TEST_F(SendStringAsync, BlockingFlushesQueue) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_TRUE(SEND_STRING_ASYNC("a"));
+    SEND_STRING("b");
+    EXPECT_FALSE(send_string_async_busy());
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,183 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+#define ROLL_LENGTH 20
+
+class WaitingBuffer : public TestFixture {
+   protected:
+    KeymapKey              mod_tap_hold_key = KeymapKey(0, 0, 0, SFT_T(KC_Z));
+    std::vector<KeymapKey> roll_keys;
+
+    void SetUp() override {
+        for (uint8_t i = 0; i < ROLL_LENGTH; i++) {
+            roll_keys.emplace_back(0, i % MATRIX_COLS, 1 + i / MATRIX_COLS, KC_A + i);
+        }
+        set_keymap({mod_tap_hold_key});
+        for (KeymapKey key : roll_keys) {
+            add_key(key);
+        }
+        waiting_buffer_reset_stats();
+    }
+
+    // Rolls through all keys, each one being pressed before the previous one is released
+    void roll(void) {
+        for (uint8_t i = 0; i < ROLL_LENGTH; i++) {
+            roll_keys[i].press();
+            run_one_scan_loop();
+            if (i > 0) {
+                roll_keys[i - 1].release();
+                run_one_scan_loop();
+            }
+        }
+        roll_keys[ROLL_LENGTH - 1].release();
+        run_one_scan_loop();
+    }
+
+    // Expects the reports sent for a roll, while holding the given keys throughout
+    void expect_roll(TestDriver& driver, std::vector<uint8_t> held) {
+        for (uint8_t i = 0; i < ROLL_LENGTH; i++) {
+            std::vector<uint8_t> keys = held;
+            if (i > 0) {
+                keys.push_back(KC_A + i - 1);
+            }
+            keys.push_back(KC_A + i);
+            EXPECT_CALL(driver, send_keyboard_mock(testing::MakeMatcher(new KeyboardReportMatcher(keys))));
+            keys.erase(std::find(keys.begin(), keys.end(), KC_A + i));
+            if (i > 0) {
+                keys.erase(std::find(keys.begin(), keys.end(), KC_A + i - 1));
+                keys.push_back(KC_A + i);
+                EXPECT_CALL(driver, send_keyboard_mock(testing::MakeMatcher(new KeyboardReportMatcher(keys))));
+            }
+        }
+        EXPECT_CALL(driver, send_keyboard_mock(testing::MakeMatcher(new KeyboardReportMatcher(held))));
+    }
+};
+
+TEST_F(WaitingBuffer, roll_without_tapping_key) {
+    TestDriver driver;
+    InSequence s;
+
+    expect_roll(driver, {});
+    roll();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(waiting_buffer_stats.peak_depth, 0);
+    EXPECT_EQ(waiting_buffer_stats.overflows, 0);
+}
+
+TEST_F(WaitingBuffer, roll_while_mod_tap_key_is_undecided) {
+    TestDriver driver;
+    InSequence s;
+
+    /* Press mod-tap-hold key. */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_hold_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Roll through all keys within the tapping term, all of which wait for the mod-tap-hold key. */
+    EXPECT_NO_REPORT(driver);
+    roll();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(waiting_buffer_stats.peak_depth, ROLL_LENGTH * 2);
+
+    /* Release mod-tap-hold key, which replays the whole roll after the tap. */
+    EXPECT_REPORT(driver, (KC_Z));
+    expect_roll(driver, {KC_Z});
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_hold_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(waiting_buffer_stats.overflows, 0);
+}
+
+TEST_F(WaitingBuffer, roll_while_mod_tap_key_is_held) {
+    TestDriver driver;
+    InSequence s;
+
+    /* Press mod-tap-hold key. */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_hold_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Roll through all keys, the mod-tap-hold key becoming a hold at the end of the tapping term. */
+    EXPECT_REPORT(driver, (KC_LSFT));
+    expect_roll(driver, {KC_LSFT});
+    roll();
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Release mod-tap-hold key. */
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_hold_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(waiting_buffer_stats.peak_depth, ROLL_LENGTH * 2);
+    EXPECT_EQ(waiting_buffer_stats.overflows, 0);
+}
+
+TEST_F(WaitingBuffer, overflow_is_counted) {
+    TestDriver driver;
+
+    /* Roll through all keys twice while the mod-tap-hold key is undecided, which does not fit. */
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    mod_tap_hold_key.press();
+    run_one_scan_loop();
+    roll();
+    roll();
+    mod_tap_hold_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(waiting_buffer_stats.peak_depth, WAITING_BUFFER_SIZE);
+    EXPECT_EQ(waiting_buffer_stats.overflows, 1);
+}
+
+TEST_F(WaitingBuffer, tap_of_mod_tap_key_waiting_behind_roll) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  second_mod_tap_key = KeymapKey(0, 1, 0, CTL_T(KC_X));
+    add_key(second_mod_tap_key);
+
+    /* Press mod-tap-hold key. */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_hold_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Roll through all keys, then tap the second mod-tap-hold key, all of which wait for the first one. */
+    EXPECT_NO_REPORT(driver);
+    roll();
+    second_mod_tap_key.press();
+    run_one_scan_loop();
+    second_mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Release mod-tap-hold key, after which the release of the second one is found behind the roll, making it a tap as well. */
+    EXPECT_REPORT(driver, (KC_Z));
+    expect_roll(driver, {KC_Z});
+    EXPECT_REPORT(driver, (KC_Z, KC_X));
+    EXPECT_REPORT(driver, (KC_Z));
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_hold_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(waiting_buffer_stats.overflows, 0);
+}
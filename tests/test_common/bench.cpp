@@ -0,0 +1,158 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "bench.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "host.h"
+#include "keyboard.h"
+#include "test_matrix.h"
+
+void advance_time(uint32_t ms);
+}
+
+//------------------------------------
+// Allocation counting
+//
+
+static std::atomic<uint64_t> allocations{0};
+
+uint64_t bench_allocations(void) {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size) {
+#if !defined(__GLIBC__)
+    // Otherwise already counted by malloc() below
+    allocations.fetch_add(1, std::memory_order_relaxed);
+#endif
+    void* ptr = std::malloc(size ? size : 1);
+    if (!ptr) {
+        // Built without exceptions
+        std::abort();
+    }
+    return ptr;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+#if defined(__GLIBC__)
+// Catch allocations made from C as well, glibc exports its implementation under an alias
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_calloc(size_t count, size_t size);
+extern "C" void* __libc_realloc(void* ptr, size_t size);
+
+extern "C" void* malloc(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t count, size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* ptr, size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(ptr, size);
+}
+#endif
+
+//------------------------------------
+// Host driver
+//
+
+static uint64_t reports = 0;
+
+static uint8_t bench_keyboard_leds(void) {
+    return 0;
+}
+
+static void bench_send_keyboard(report_keyboard_t* report) {
+    reports++;
+}
+
+static void bench_send_nkro(report_nkro_t* report) {
+    reports++;
+}
+
+static void bench_send_mouse(report_mouse_t* report) {
+    reports++;
+}
+
+static void bench_send_extra(report_extra_t* report) {
+    reports++;
+}
+
+static host_driver_t bench_driver = {bench_keyboard_leds, bench_send_keyboard, bench_send_nkro, bench_send_mouse, bench_send_extra};
+
+//------------------------------------
+// Replay
+//
+
+BenchResult BenchFixture::replay(const std::vector<BenchEvent>& sequence, uint64_t events) {
+    BenchResult result = {};
+    if (sequence.empty() || events == 0) {
+        ADD_FAILURE() << "nothing to replay";
+        return result;
+    }
+
+    host_driver_t* previous_driver = host_get_driver();
+    host_set_driver(&bench_driver);
+    reports                  = 0;
+    uint64_t allocations_pre = bench_allocations();
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < events; i++) {
+        const BenchEvent& event = sequence[i % sequence.size()];
+        if (event.pressed) {
+            press_key(event.key.position.col, event.key.position.row);
+        } else {
+            release_key(event.key.position.col, event.key.position.row);
+        }
+        for (uint16_t ms = 0; ms < event.idle_ms; ms++) {
+            keyboard_task();
+            housekeeping_task();
+            advance_time(1);
+        }
+        result.scans += event.idle_ms;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    result.events       = events;
+    result.reports      = reports;
+    result.allocations  = bench_allocations() - allocations_pre;
+    double elapsed_ns   = std::chrono::duration<double, std::nano>(end - start).count();
+    result.ns_per_event = elapsed_ns / result.events;
+    result.ns_per_scan  = result.scans ? elapsed_ns / result.scans : 0;
+
+    host_set_driver(previous_driver);
+
+    const ::testing::TestInfo* const test_info = ::testing::UnitTest::GetInstance()->current_test_info();
+    printf("[ BENCH    ] %s.%s: %llu events, %.1f ns/event, %.1f ns/scan, %llu reports, %llu allocations\n", test_info->test_case_name(), test_info->name(), (unsigned long long)result.events, result.ns_per_event, result.ns_per_scan, (unsigned long long)result.reports, (unsigned long long)result.allocations);
+
+    return result;
+}
@@ -0,0 +1,61 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+#ifndef BENCH_EVENTS
+#    define BENCH_EVENTS 1000000
+#endif
+
+/**
+ * @brief A single step of a benchmark sequence: a key transition followed by `idle_ms` scan loops.
+ */
+struct BenchEvent {
+    KeymapKey key;
+    bool      pressed;
+    uint16_t  idle_ms;
+};
+
+inline BenchEvent bench_press(KeymapKey key, uint16_t idle_ms = 1) {
+    return {key, true, idle_ms};
+}
+
+inline BenchEvent bench_release(KeymapKey key, uint16_t idle_ms = 1) {
+    return {key, false, idle_ms};
+}
+
+struct BenchResult {
+    uint64_t events;
+    uint64_t scans;
+    uint64_t reports;
+    uint64_t allocations;
+    double   ns_per_event;
+    double   ns_per_scan;
+};
+
+/**
+ * @brief Fixture for throughput benchmarks, built with `make bench:<suite>`.
+ *
+ * Reports are counted by a lightweight host driver instead of the mocked TestDriver, so that the measurements
+ * only cover the keycode processing pipeline.
+ */
+class BenchFixture : public TestFixture {
+   public:
+    /**
+     * @brief Replays `sequence` round robin until `events` key transitions went through the full
+     * matrix_task() -> action_exec() -> process_record() pipeline, then prints and returns the results.
+     *
+     * The sequence should release every key it presses, so that it can be repeated.
+     */
+    BenchResult replay(const std::vector<BenchEvent>& sequence, uint64_t events = BENCH_EVENTS);
+};
+
+/**
+ * @brief Number of heap allocations made by the benchmark process so far.
+ */
+uint64_t bench_allocations(void);
@@ -0,0 +1,5 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# Benchmarks measure optimised code, unlike tests which are built for debugging
+OPT = 2
@@ -58,6 +58,10 @@ void TestFixture::TearDownTestCase() {}
 TestFixture::TestFixture() {
     m_this = this;
     timer_clear();
+#if defined(RESOLVED_LAYER_CACHE)
+    /* Every test brings its own keymap. */
+    resolved_layers_cache_clear();
+#endif
     keyrecord_t empty_keyrecord = {0};
     test_logger.info() << "tapping term is " << +GET_TAPPING_TERM(KC_TRANSPARENT, &empty_keyrecord) << "ms" << std::endl;
 }
@@ -133,7 +137,7 @@ void TestFixture::set_keymap(std::initializer_list<KeymapKey> keys) {
 }
 
 const KeymapKey* TestFixture::find_key(layer_t layer, keypos_t position) const {
-    auto keymap_key_predicate = [&](KeymapKey candidate) { return candidate.layer == layer && candidate.position.col == position.col && candidate.position.row == position.row; };
+    auto keymap_key_predicate = [&](const KeymapKey& candidate) { return candidate.layer == layer && candidate.position.col == position.col && candidate.position.row == position.row; };
 
     auto result = std::find_if(this->keymap.begin(), this->keymap.end(), keymap_key_predicate);
 
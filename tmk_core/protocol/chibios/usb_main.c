@@ -465,6 +465,16 @@ void send_keyboard(report_keyboard_t *report) {
     }
 }
 
+/* Whether every keyboard report queued so far has gone out, rather than the next one having to wait */
+bool host_keyboard_ready(void) {
+#ifdef NKRO_ENABLE
+    if (!usb_endpoint_in_is_inactive(&usb_endpoints_in[USB_ENDPOINT_IN_SHARED])) {
+        return false;
+    }
+#endif
+    return usb_endpoint_in_is_inactive(&usb_endpoints_in[USB_ENDPOINT_IN_KEYBOARD]);
+}
+
 void send_nkro(report_nkro_t *report) {
 #ifdef NKRO_ENABLE
     send_report(USB_ENDPOINT_IN_SHARED, report, sizeof(report_nkro_t));
@@ -71,6 +71,11 @@ led_t host_keyboard_led_state(void) {
     return (led_t)host_keyboard_leds();
 }
 
+/* Whether the previous keyboard report has gone out yet, for protocols which can tell */
+__attribute__((weak)) bool host_keyboard_ready(void) {
+    return true;
+}
+
 /* send report */
 void host_keyboard_send(report_keyboard_t *report) {
 #ifdef BLUETOOTH_ENABLE